@@ -0,0 +1,162 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains a benchmark for the task queue of the Handle with 1 to 16 spinning threads
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "vda5050++/core/common/blocking_queue.h"
+#include "vda5050++/core/common/work_stealing_executor.h"
+
+using namespace std::chrono_literals;
+
+// Roughly the work of a short handler callback
+static void work() {
+  volatile uint64_t x = 0;
+  for (int i = 0; i < 200; i++) {
+    x = x + i;
+  }
+}
+
+static constexpr int k_spawn = 8;
+
+struct BlockingQueueRunner {
+  vda5050pp::core::common::BlockingQueue<std::function<void()>> queue;
+
+  void push(std::function<void()> task) { this->queue.push(std::move(task)); }
+  void push(const void *, std::function<void()> task) { this->queue.push(std::move(task)); }
+
+  void spin(const std::atomic_bool &stop) {
+    while (!stop) {
+      if (auto task = this->queue.try_pop_for(1ms); task.has_value()) {
+        (*task)();
+      }
+    }
+  }
+};
+
+struct WorkStealingRunner {
+  vda5050pp::core::common::WorkStealingExecutor queue;
+
+  void push(std::function<void()> task) { this->queue.push(std::move(task)); }
+  void push(const void *key, std::function<void()> task) {
+    this->queue.push(key, std::move(task));
+  }
+
+  void spin(const std::atomic_bool &stop) {
+    this->queue.attachWorker();
+    while (!stop) {
+      if (auto task = this->queue.try_pop_for(1ms); task.has_value()) {
+        (*task)();
+      }
+    }
+    this->queue.detachWorker();
+  }
+};
+
+enum class Workload {
+  // all tasks are pushed by a foreign thread (i.e. the connector)
+  k_injected,
+  // each task pushes k_spawn further tasks (i.e. handler callbacks triggering the net)
+  k_spawning,
+  // tasks are pushed with one of 64 ordering keys (i.e. task managers)
+  k_ordered,
+};
+
+template <typename Runner>
+static double run(Workload workload, int n_threads, int n_tasks) {
+  Runner runner;
+  std::atomic_int done = 0;
+  std::atomic_bool stop = false;
+
+  std::function<void(int)> spawn = [&](int depth) {
+    work();
+    if (depth > 0) {
+      for (int i = 0; i < k_spawn; i++) {
+        runner.push([&spawn, depth] { spawn(depth - 1); });
+      }
+    }
+    done++;
+  };
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < n_threads; i++) {
+    threads.emplace_back([&runner, &stop] { runner.spin(stop); });
+  }
+
+  int expected = n_tasks;
+  auto begin = std::chrono::steady_clock::now();
+  switch (workload) {
+    case Workload::k_injected:
+      for (int i = 0; i < n_tasks; i++) {
+        runner.push([&done] {
+          work();
+          done++;
+        });
+      }
+      break;
+    case Workload::k_spawning: {
+      // 1 + 8 + 64 + 512 tasks per root
+      int roots = std::max(1, n_tasks / 585);
+      expected = roots * 585;
+      for (int i = 0; i < roots; i++) {
+        runner.push([&spawn] { spawn(3); });
+      }
+    } break;
+    case Workload::k_ordered:
+      for (int i = 0; i < n_tasks; i++) {
+        runner.push(reinterpret_cast<const void *>(uintptr_t(i % 64 + 1)), [&done] {
+          work();
+          done++;
+        });
+      }
+      break;
+  }
+
+  while (done < expected) {
+    std::this_thread::yield();
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  stop = true;
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  return expected / std::chrono::duration<double>(end - begin).count();
+}
+
+int main(int argc, char **argv) {
+  int n_tasks = argc > 1 ? std::atoi(argv[1]) : 200000;
+
+  const std::pair<Workload, const char *> workloads[] = {
+      {Workload::k_injected, "injected"},
+      {Workload::k_spawning, "spawning"},
+      {Workload::k_ordered, "ordered"},
+  };
+
+  std::printf("%-10s %8s %18s %18s %8s\n", "workload", "threads", "BlockingQueue [1/s]",
+              "WorkStealing [1/s]", "speedup");
+  for (auto [workload, name] : workloads) {
+    for (int n_threads : {1, 2, 4, 8, 16}) {
+      auto blocking = run<BlockingQueueRunner>(workload, n_threads, n_tasks);
+      auto stealing = run<WorkStealingRunner>(workload, n_threads, n_tasks);
+      std::printf("%-10s %8d %18.0f %18.0f %8.2f\n", name, n_threads, blocking, stealing,
+                  stealing / blocking);
+    }
+  }
+
+  return 0;
+}
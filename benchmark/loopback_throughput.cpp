@@ -0,0 +1,124 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains an end-to-end benchmark of a Handle driven by a VirtualMasterControl
+//
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <string>
+
+#include "vda5050++/core/version.h"
+#include "vda5050++/extra/loopback_connector.h"
+#include "vda5050++/interface_agv/handle.h"
+
+class NoopNavigationHandler : public vda5050pp::interface_agv::StepBasedNavigationHandler {
+public:
+  void start(const std::optional<vda5050pp::Edge> &, const vda5050pp::Node &) override {}
+  void pause() override {}
+  void resume() override {}
+  void stop() override {}
+};
+
+class NoopActionHandler : public vda5050pp::interface_agv::ActionHandler {
+public:
+  void start(const vda5050pp::Action &) override {}
+  void pause(const vda5050pp::Action &) override {}
+  void resume(const vda5050pp::Action &) override {}
+  void stop(const vda5050pp::Action &) override {}
+};
+
+class NoopPauseResumeHandler : public vda5050pp::interface_agv::PauseResumeHandler {
+public:
+  void doPause() override {}
+  void doResume() override {}
+};
+
+class NoopOdometryHandler : public vda5050pp::interface_agv::OdometryHandler {
+public:
+  void initializePosition(const vda5050pp::AGVPosition &) noexcept(false) override {}
+};
+
+// An order with a single node at the AGV's position, which is finished right away
+static vda5050pp::Order mkOrder(uint64_t n) {
+  vda5050pp::Node node;
+  node.nodeId = "n1";
+  node.sequenceId = 0;
+  node.released = true;
+  node.nodePosition = vda5050pp::NodePosition{};
+  node.nodePosition->allowedDeviationXY = 1.0;
+
+  vda5050pp::Order order;
+  order.header.version = vda5050pp::core::version::current;
+  order.orderId = "order-" + std::to_string(n);
+  order.orderUpdateId = 0;
+  order.nodes = {node};
+  return order;
+}
+
+static double toMs(std::optional<std::chrono::steady_clock::duration> d) {
+  return d.has_value() ? std::chrono::duration<double, std::milli>(*d).count() : 0.0;
+}
+
+int main(int argc, char **argv) {
+  int n_orders = argc > 1 ? std::atoi(argv[1]) : 1000;
+  auto mode = argc > 2 && std::strcmp(argv[2], "serialized") == 0
+                  ? vda5050pp::extra::LoopbackMode::k_serialized
+                  : vda5050pp::extra::LoopbackMode::k_objects;
+
+  auto master = std::make_shared<vda5050pp::extra::VirtualMasterControl>(mode);
+  auto connector = std::make_shared<vda5050pp::extra::LoopbackConnector>(master);
+  vda5050pp::interface_agv::Handle handle(
+      {}, connector,
+      vda5050pp::interface_agv::Handlers<NoopNavigationHandler, NoopActionHandler,
+                                         NoopPauseResumeHandler>{});
+
+  auto odometry = std::make_shared<NoopOdometryHandler>();
+  handle.setOdometryHandler(odometry);
+  vda5050pp::AGVPosition position;
+  position.positionInitialized = true;
+  odometry->setAGVPosition(position);
+
+  master->resetStatistics();
+  auto begin = std::chrono::steady_clock::now();
+  uint64_t timeouts = 0;
+  for (int i = 0; i < n_orders; i++) {
+    auto order = mkOrder(i);
+    master->sendOrder(order);
+    // Wait for the order to be reported, before the next one replaces it
+    auto state = master->waitForState(
+        [&order](const vda5050pp::State &s) { return s.orderId == order.orderId; },
+        std::chrono::seconds(5));
+    if (!state.has_value()) {
+      timeouts++;
+    }
+  }
+  auto wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+  auto statistics = master->getStatistics();
+  const auto &latency = statistics.order_to_state_latency;
+
+  std::printf("%-24s %12s\n", "mode",
+              mode == vda5050pp::extra::LoopbackMode::k_serialized ? "serialized" : "objects");
+  std::printf("%-24s %12d\n", "orders", n_orders);
+  std::printf("%-24s %12.3f\n", "wall time [s]", wall);
+  std::printf("%-24s %12.0f\n", "orders / s", double(n_orders) / wall);
+  std::printf("%-24s %12.0f\n", "messages / s",
+              double(statistics.orders_sent + statistics.states_received +
+                     statistics.connections_received + statistics.visualizations_received) /
+                  wall);
+  std::printf("%-24s %12.3f\n", "latency p50 <= [ms]", toMs(latency.quantileBound(0.5)));
+  std::printf("%-24s %12.3f\n", "latency p99 <= [ms]", toMs(latency.quantileBound(0.99)));
+  std::printf("%-24s %12.3f\n", "latency max [ms]", toMs(latency.max()));
+  std::printf("%-24s %12llu\n", "orders timed out", static_cast<unsigned long long>(timeouts));
+
+  return 0;
+}
@@ -0,0 +1,118 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains a microbenchmark for LogicTaskNetID lookups
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <set>
+#include <unordered_set>
+#include <vector>
+
+#include "vda5050++/core/logic/types.h"
+
+using vda5050pp::core::logic::LogicTaskNetID;
+using vda5050pp::core::logic::LogicTaskNetTypes;
+using vda5050pp::core::logic::SeqNrT;
+
+// The ID with the member-wise comparison (before LogicTaskNetID::key())
+struct MemberwiseID {
+  LogicTaskNetTypes type;
+  SeqNrT seq;
+
+  bool operator<(const MemberwiseID &other) const {
+    return this->seq < other.seq || (this->seq == other.seq && this->type < other.type);
+  }
+};
+
+using Clock = std::chrono::steady_clock;
+
+static double nanos(Clock::duration d, std::size_t n) {
+  return std::chrono::duration<double, std::nano>(d).count() / static_cast<double>(n);
+}
+
+static volatile std::size_t sink = 0;
+
+// Look up every ID of the map (like SimplePTN does in findPlace) and return ns per lookup
+template <typename ID> static double mapLookup(const std::vector<ID> &ids, int rounds) {
+  std::map<ID, int> map;
+  for (const auto &id : ids) {
+    map.emplace(id, 0);
+  }
+  auto begin = Clock::now();
+  for (int r = 0; r < rounds; r++) {
+    for (const auto &id : ids) {
+      sink = sink + map.count(id);
+    }
+  }
+  return nanos(Clock::now() - begin, ids.size() * rounds);
+}
+
+// Insert and extract every ID (like the exit bookkeeping) and return ns per insert+extract
+template <typename Set, typename ID> static double insertExtract(const std::vector<ID> &ids,
+                                                                 int rounds) {
+  Set set;
+  auto begin = Clock::now();
+  for (int r = 0; r < rounds; r++) {
+    for (const auto &id : ids) {
+      set.insert(id);
+    }
+    sink = sink + set.size();
+    for (const auto &id : ids) {
+      set.extract(id);
+    }
+  }
+  return nanos(Clock::now() - begin, ids.size() * rounds);
+}
+
+static void run(int n_tasks, int rounds) {
+  // The places of a task, each with its own seq
+  static constexpr LogicTaskNetTypes k_types[] = {
+      LogicTaskNetTypes::k_ready,    LogicTaskNetTypes::k_done,    LogicTaskNetTypes::k_enabled,
+      LogicTaskNetTypes::k_running,  LogicTaskNetTypes::k_paused,  LogicTaskNetTypes::k_failed,
+      LogicTaskNetTypes::k_finished, LogicTaskNetTypes::k_exited,  LogicTaskNetTypes::k_entered,
+  };
+
+  std::vector<MemberwiseID> memberwise;
+  std::vector<LogicTaskNetID> packed;
+  std::vector<LogicTaskNetID> exited;
+  std::vector<MemberwiseID> exited_memberwise;
+  for (int seq = 0; seq < n_tasks; seq++) {
+    for (auto type : k_types) {
+      memberwise.push_back({type, static_cast<SeqNrT>(seq)});
+      packed.push_back({type, static_cast<SeqNrT>(seq)});
+    }
+    exited.push_back({LogicTaskNetTypes::k_exited, static_cast<SeqNrT>(seq)});
+    exited_memberwise.push_back({LogicTaskNetTypes::k_exited, static_cast<SeqNrT>(seq)});
+  }
+
+  std::printf("%8d %14.1f %14.1f %14.1f %14.1f\n", n_tasks, mapLookup(memberwise, rounds),
+              mapLookup(packed, rounds),
+              insertExtract<std::set<MemberwiseID>>(exited_memberwise, rounds),
+              insertExtract<std::unordered_set<LogicTaskNetID>>(exited, rounds));
+}
+
+int main(int argc, char **argv) {
+  int rounds = argc > 1 ? std::atoi(argv[1]) : 20;
+  std::vector<int> sizes;
+  for (int i = 2; i < argc; i++) {
+    sizes.push_back(std::atoi(argv[i]));
+  }
+  if (sizes.empty()) {
+    sizes = {100, 1000, 10000, 100000};
+  }
+
+  std::printf("%8s %14s %14s %14s %14s\n", "tasks", "map memb. [ns]", "map key [ns]",
+              "set [ns]", "hash set [ns]");
+  for (auto n_tasks : sizes) {
+    run(n_tasks, rounds);
+  }
+
+  return 0;
+}
@@ -0,0 +1,147 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains a benchmark for ticking the logic net of large orders
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "vda5050++/core/interface_agv/handle_accessor.h"
+#include "vda5050++/core/logic/net_manager.h"
+#include "vda5050++/interface_agv/handle.h"
+
+class NoopNavigationHandler : public vda5050pp::interface_agv::ContinuousNavigationHandler {
+public:
+  void horizonUpdated(const std::list<vda5050pp::Node> &,
+                      const std::list<vda5050pp::Edge> &) override {}
+  void baseIncreased(const std::list<vda5050pp::Node> &,
+                     const std::list<vda5050pp::Edge> &) override {}
+  void start(const std::list<vda5050pp::Node> &, const std::list<vda5050pp::Edge> &) override {}
+  void pause() override {}
+  void resume() override {}
+  void stop() override {}
+};
+
+class BenchActionHandler;
+static std::map<std::string, BenchActionHandler *> handler_by_id;
+
+// Starts immediately and finishes, when the benchmark says so
+class BenchActionHandler : public vda5050pp::interface_agv::ActionHandler {
+public:
+  ~BenchActionHandler() override { handler_by_id.erase(this->getAction().actionId); }
+  void start(const vda5050pp::Action &action) override {
+    handler_by_id[action.actionId] = this;
+    this->started();
+  }
+  void pause(const vda5050pp::Action &) override {}
+  void resume(const vda5050pp::Action &) override {}
+  void stop(const vda5050pp::Action &) override { this->failed(); }
+  void finish() { this->finished(); }
+};
+
+class NoopPauseResumeHandler : public vda5050pp::interface_agv::PauseResumeHandler {
+public:
+  void doPause() override {}
+  void doResume() override {}
+};
+
+// Drops all messages
+class NullConnector : public vda5050pp::interface_mc::Connector {
+public:
+  void setConsumer(std::weak_ptr<vda5050pp::interface_mc::MessageConsumer>) noexcept(
+      true) override {}
+  void queueConnection(const vda5050pp::Connection &) noexcept(false) override {}
+  void queueState(const vda5050pp::State &) noexcept(false) override {}
+  void queueVisualization(const vda5050pp::Visualization &) noexcept(false) override {}
+  void connect() noexcept(false) override {}
+  void disconnect() noexcept(false) override {}
+};
+
+using Clock = std::chrono::steady_clock;
+
+static double micros(Clock::duration d) {
+  return std::chrono::duration<double, std::micro>(d).count();
+}
+
+// One node with n HARD blocking actions, each action is a time step of its own
+static vda5050pp::Order makeOrder(int n) {
+  vda5050pp::Node node;
+  node.nodeId = "N1";
+  node.sequenceId = 0;
+  node.released = true;
+  for (int i = 0; i < n; i++) {
+    node.actions.push_back(
+        {"bench", "A" + std::to_string(i), std::nullopt, vda5050pp::BlockingType::HARD, {}});
+  }
+
+  vda5050pp::Order order;
+  order.orderId = "bench";
+  order.orderUpdateId = 0;
+  order.nodes.push_back(std::move(node));
+  return order;
+}
+
+static void run(int n_tasks, int n_steps) {
+  vda5050pp::interface_agv::Handlers<NoopNavigationHandler, BenchActionHandler,
+                                     NoopPauseResumeHandler>
+      handlers;
+  vda5050pp::interface_agv::Handle handle({}, std::make_shared<NullConnector>(), handlers);
+  vda5050pp::core::interface_agv::HandleAccessor(handle).getState().setOrder(makeOrder(n_tasks));
+
+  vda5050pp::core::logic::NetManager net_manager(handle);
+  auto begin = Clock::now();
+  net_manager.interpret();
+  auto interpret_time = Clock::now() - begin;
+  handle.spinAll();
+  auto places = net_manager.getNet().numPlaces();
+
+  // The cost of a tick without the worklist: evaluating every transition until nothing fires
+  auto copy = net_manager.getNet();
+  begin = Clock::now();
+  copy.deepTickCover();
+  auto sweep_time = Clock::now() - begin;
+
+  // A local change: the current action finishes, the next one is launched
+  Clock::duration tick_time{};
+  n_steps = std::min(n_steps, n_tasks - 1);
+  for (int i = 0; i < n_steps; i++) {
+    handler_by_id.at("A" + std::to_string(i))->finish();
+    begin = Clock::now();
+    net_manager.tick();
+    tick_time += Clock::now() - begin;
+    handle.spinAll();
+  }
+
+  std::printf("%8d %10zu %14.1f %14.1f %14.2f %10zu\n", n_tasks, places,
+              micros(interpret_time) / 1000.0, micros(sweep_time), micros(tick_time) / n_steps,
+              net_manager.getNet().numPlaces());
+}
+
+int main(int argc, char **argv) {
+  int n_steps = argc > 1 ? std::atoi(argv[1]) : 100;
+  std::vector<int> sizes;
+  for (int i = 2; i < argc; i++) {
+    sizes.push_back(std::atoi(argv[i]));
+  }
+  if (sizes.empty()) {
+    sizes = {1000, 2000, 5000, 10000};
+  }
+
+  std::printf("%8s %10s %14s %14s %14s %10s\n", "tasks", "places", "interpret [ms]",
+              "sweep [us]", "tick [us]", "places end");
+  for (auto n_tasks : sizes) {
+    run(n_tasks, n_steps);
+  }
+
+  return 0;
+}
@@ -0,0 +1,141 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains a benchmark for the interpretation of orders with many nodes
+//
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "vda5050++/core/interface_agv/handle_accessor.h"
+#include "vda5050++/core/logic/net_manager.h"
+#include "vda5050++/interface_agv/handle.h"
+
+class NoopNavigationHandler : public vda5050pp::interface_agv::ContinuousNavigationHandler {
+public:
+  void horizonUpdated(const std::list<vda5050pp::Node> &,
+                      const std::list<vda5050pp::Edge> &) override {}
+  void baseIncreased(const std::list<vda5050pp::Node> &,
+                     const std::list<vda5050pp::Edge> &) override {}
+  void start(const std::list<vda5050pp::Node> &, const std::list<vda5050pp::Edge> &) override {}
+  void pause() override {}
+  void resume() override {}
+  void stop() override {}
+};
+
+class BenchActionHandler;
+static std::map<std::string, BenchActionHandler *> handler_by_id;
+
+// Starts immediately and finishes, when the benchmark says so
+class BenchActionHandler : public vda5050pp::interface_agv::ActionHandler {
+public:
+  ~BenchActionHandler() override { handler_by_id.erase(this->getAction().actionId); }
+  void start(const vda5050pp::Action &action) override {
+    handler_by_id[action.actionId] = this;
+    this->started();
+  }
+  void pause(const vda5050pp::Action &) override {}
+  void resume(const vda5050pp::Action &) override {}
+  void stop(const vda5050pp::Action &) override { this->failed(); }
+  void finish() { this->finished(); }
+};
+
+class NoopPauseResumeHandler : public vda5050pp::interface_agv::PauseResumeHandler {
+public:
+  void doPause() override {}
+  void doResume() override {}
+};
+
+// Drops all messages
+class NullConnector : public vda5050pp::interface_mc::Connector {
+public:
+  void setConsumer(std::weak_ptr<vda5050pp::interface_mc::MessageConsumer>) noexcept(
+      true) override {}
+  void queueConnection(const vda5050pp::Connection &) noexcept(false) override {}
+  void queueState(const vda5050pp::State &) noexcept(false) override {}
+  void queueVisualization(const vda5050pp::Visualization &) noexcept(false) override {}
+  void connect() noexcept(false) override {}
+  void disconnect() noexcept(false) override {}
+};
+
+using Clock = std::chrono::steady_clock;
+
+static double millis(Clock::duration d) {
+  return std::chrono::duration<double, std::milli>(d).count();
+}
+
+// n nodes with a HARD blocking action each, connected by edges
+static vda5050pp::Order makeOrder(int n) {
+  vda5050pp::Order order;
+  order.orderId = "bench";
+  order.orderUpdateId = 0;
+  for (int i = 0; i < n; i++) {
+    auto id = std::to_string(i);
+    vda5050pp::Node node;
+    node.nodeId = "N" + id;
+    node.sequenceId = 2 * i;
+    node.released = true;
+    node.actions.push_back({"bench", "A" + id, std::nullopt, vda5050pp::BlockingType::HARD, {}});
+    order.nodes.push_back(std::move(node));
+
+    if (i > 0) {
+      vda5050pp::Edge edge;
+      edge.edgeId = "E" + id;
+      edge.sequenceId = 2 * i - 1;
+      edge.released = true;
+      edge.startNodeId = "N" + std::to_string(i - 1);
+      edge.endNodeId = "N" + id;
+      order.edges.push_back(std::move(edge));
+    }
+  }
+  return order;
+}
+
+static void run(int n_nodes, std::size_t window) {
+  vda5050pp::interface_agv::Handlers<NoopNavigationHandler, BenchActionHandler,
+                                     NoopPauseResumeHandler>
+      handlers;
+  vda5050pp::interface_agv::Handle handle({}, std::make_shared<NullConnector>(), handlers);
+  handle.setInterpretationWindow(window);
+  vda5050pp::core::interface_agv::HandleAccessor(handle).getState().setOrder(makeOrder(n_nodes));
+
+  vda5050pp::core::logic::NetManager net_manager(handle);
+  auto begin = Clock::now();
+  net_manager.interpret();
+  auto interpret_time = Clock::now() - begin;
+  handle.spinAll();
+
+  std::printf("%8d %8zu %14.2f %10zu %10zu\n", n_nodes, window, millis(interpret_time),
+              net_manager.getNet().numPlaces(), net_manager.getNet().numTransitions());
+}
+
+int main(int argc, char **argv) {
+  std::vector<int> sizes;
+  for (int i = 1; i < argc; i++) {
+    sizes.push_back(std::atoi(argv[i]));
+  }
+  if (sizes.empty()) {
+    sizes = {100, 500, 2000};
+  }
+
+  std::printf("%8s %8s %14s %10s %10s\n", "nodes", "window", "interpret [ms]", "places",
+              "transitions");
+  for (auto n_nodes : sizes) {
+    // 0 interprets the whole base up front
+    for (std::size_t window : {std::size_t{0}, std::size_t{64}, std::size_t{8}}) {
+      run(n_nodes, window);
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,148 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains a benchmark for pausing, resuming and cancelling long orders
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "vda5050++/core/interface_agv/handle_accessor.h"
+#include "vda5050++/core/logic/net_manager.h"
+#include "vda5050++/interface_agv/handle.h"
+
+// Drives, until the benchmark cancels the order
+class NoopNavigationHandler : public vda5050pp::interface_agv::StepBasedNavigationHandler {
+public:
+  void start(const std::optional<vda5050pp::Edge> &, const vda5050pp::Node &) override {
+    this->started();
+  }
+  void pause() override { this->paused(); }
+  void resume() override { this->resumed(); }
+  void stop() override { this->failed(); }
+};
+
+class BenchActionHandler;
+static std::map<std::string, BenchActionHandler *> handler_by_id;
+
+// Starts, pauses and resumes immediately
+class BenchActionHandler : public vda5050pp::interface_agv::ActionHandler {
+public:
+  ~BenchActionHandler() override { handler_by_id.erase(this->getAction().actionId); }
+  void start(const vda5050pp::Action &action) override {
+    handler_by_id[action.actionId] = this;
+    this->started();
+  }
+  void pause(const vda5050pp::Action &) override { this->paused(); }
+  void resume(const vda5050pp::Action &) override { this->resumed(); }
+  void stop(const vda5050pp::Action &) override { this->failed(); }
+};
+
+class NoopPauseResumeHandler : public vda5050pp::interface_agv::PauseResumeHandler {
+public:
+  void doPause() override {}
+  void doResume() override {}
+};
+
+// Drops all messages
+class NullConnector : public vda5050pp::interface_mc::Connector {
+public:
+  void setConsumer(std::weak_ptr<vda5050pp::interface_mc::MessageConsumer>) noexcept(
+      true) override {}
+  void queueConnection(const vda5050pp::Connection &) noexcept(false) override {}
+  void queueState(const vda5050pp::State &) noexcept(false) override {}
+  void queueVisualization(const vda5050pp::Visualization &) noexcept(false) override {}
+  void connect() noexcept(false) override {}
+  void disconnect() noexcept(false) override {}
+};
+
+using Clock = std::chrono::steady_clock;
+
+static double micros(Clock::duration d) {
+  return std::chrono::duration<double, std::micro>(d).count();
+}
+
+// n nodes with a NONE blocking action each, connected by edges
+static vda5050pp::Order makeOrder(int n) {
+  vda5050pp::Order order;
+  order.orderId = "bench";
+  order.orderUpdateId = 0;
+  for (int i = 0; i < n; i++) {
+    auto id = std::to_string(i);
+    vda5050pp::Node node;
+    node.nodeId = "N" + id;
+    node.sequenceId = 2 * i;
+    node.released = true;
+    node.actions.push_back({"bench", "A" + id, std::nullopt, vda5050pp::BlockingType::NONE, {}});
+    order.nodes.push_back(std::move(node));
+
+    if (i > 0) {
+      vda5050pp::Edge edge;
+      edge.edgeId = "E" + id;
+      edge.sequenceId = 2 * i - 1;
+      edge.released = true;
+      edge.startNodeId = "N" + std::to_string(i - 1);
+      edge.endNodeId = "N" + id;
+      order.edges.push_back(std::move(edge));
+    }
+  }
+  return order;
+}
+
+static void run(int n_nodes, int n_rounds) {
+  vda5050pp::interface_agv::Handlers<NoopNavigationHandler, BenchActionHandler,
+                                     NoopPauseResumeHandler>
+      handlers;
+  vda5050pp::interface_agv::Handle handle({}, std::make_shared<NullConnector>(), handlers);
+  // the whole order is interpreted, so all of its tasks are pending
+  handle.setInterpretationWindow(0);
+  vda5050pp::core::interface_agv::HandleAccessor(handle).getState().setOrder(makeOrder(n_nodes));
+
+  vda5050pp::core::logic::NetManager net_manager(handle);
+  net_manager.interpret();
+  handle.spinAll();
+
+  // What a startPause/stopPause instant action does with the tasks of the order
+  auto begin = Clock::now();
+  for (int i = 0; i < n_rounds; i++) {
+    net_manager.pauseAllRunningActions();
+    net_manager.resumeAllPausedActions();
+  }
+  auto pause_time = Clock::now() - begin;
+
+  begin = Clock::now();
+  net_manager.cancelAll();
+  auto cancel_time = Clock::now() - begin;
+  handle.spinAll();
+
+  std::printf("%8d %10zu %22.2f %14.1f\n", n_nodes, handler_by_id.size(),
+              micros(pause_time) / n_rounds, micros(cancel_time));
+}
+
+int main(int argc, char **argv) {
+  int n_rounds = argc > 1 ? std::atoi(argv[1]) : 1000;
+  std::vector<int> sizes;
+  for (int i = 2; i < argc; i++) {
+    sizes.push_back(std::atoi(argv[i]));
+  }
+  if (sizes.empty()) {
+    sizes = {100, 500, 2000, 5000};
+  }
+
+  std::printf("%8s %10s %22s %14s\n", "nodes", "running", "pause + resume [us]",
+              "cancel [us]");
+  for (auto n_nodes : sizes) {
+    run(n_nodes, n_rounds);
+  }
+
+  return 0;
+}
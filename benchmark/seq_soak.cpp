@@ -0,0 +1,207 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains a soak benchmark, which appends to a single order for a simulated day
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "vda5050++/core/interface_agv/handle_accessor.h"
+#include "vda5050++/core/logic/net_manager.h"
+#include "vda5050++/interface_agv/handle.h"
+
+class SoakNavigationHandler;
+static SoakNavigationHandler *current_navigation = nullptr;
+
+// Starts immediately and reaches the node, when the benchmark says so
+class SoakNavigationHandler : public vda5050pp::interface_agv::StepBasedNavigationHandler {
+public:
+  ~SoakNavigationHandler() override {
+    if (current_navigation == this) {
+      current_navigation = nullptr;
+    }
+  }
+  void start(const std::optional<vda5050pp::Edge> &, const vda5050pp::Node &) override {
+    current_navigation = this;
+    this->started();
+  }
+  void pause() override {}
+  void resume() override {}
+  void stop() override { this->failed(); }
+  void finish() {
+    current_navigation = nullptr;
+    this->finished();
+  }
+};
+
+class SoakActionHandler;
+static std::map<std::string, SoakActionHandler *> action_by_id;
+
+// Starts immediately and finishes, when the benchmark says so
+class SoakActionHandler : public vda5050pp::interface_agv::ActionHandler {
+public:
+  ~SoakActionHandler() override { action_by_id.erase(this->getAction().actionId); }
+  void start(const vda5050pp::Action &action) override {
+    action_by_id[action.actionId] = this;
+    this->started();
+  }
+  void pause(const vda5050pp::Action &) override {}
+  void resume(const vda5050pp::Action &) override {}
+  void stop(const vda5050pp::Action &) override { this->failed(); }
+  void finish() { this->finished(); }
+};
+
+class NoopPauseResumeHandler : public vda5050pp::interface_agv::PauseResumeHandler {
+public:
+  void doPause() override {}
+  void doResume() override {}
+};
+
+// Drops all messages
+class NullConnector : public vda5050pp::interface_mc::Connector {
+public:
+  void setConsumer(std::weak_ptr<vda5050pp::interface_mc::MessageConsumer>) noexcept(
+      true) override {}
+  void queueConnection(const vda5050pp::Connection &) noexcept(false) override {}
+  void queueState(const vda5050pp::State &) noexcept(false) override {}
+  void queueVisualization(const vda5050pp::Visualization &) noexcept(false) override {}
+  void connect() noexcept(false) override {}
+  void disconnect() noexcept(false) override {}
+};
+
+using Clock = std::chrono::steady_clock;
+
+static double micros(Clock::duration d) {
+  return std::chrono::duration<double, std::micro>(d).count();
+}
+
+// The resident set size of this process in kB
+static long rssKb() {
+  std::ifstream status("/proc/self/status");
+  std::string key;
+  while (status >> key) {
+    if (key == "VmRSS:") {
+      long kb = 0;
+      status >> kb;
+      return kb;
+    }
+    status.ignore(4096, '\n');
+  }
+  return -1;
+}
+
+static vda5050pp::Node makeNode(uint32_t seq, int n_actions) {
+  vda5050pp::Node node;
+  node.nodeId = "N" + std::to_string(seq);
+  node.sequenceId = seq;
+  node.released = true;
+  for (int i = 0; i < n_actions; i++) {
+    node.actions.push_back({"soak", node.nodeId + "A" + std::to_string(i), std::nullopt,
+                            vda5050pp::BlockingType::HARD, {}});
+  }
+  return node;
+}
+
+// The order update, which appends the edge to and the node with the given seq
+static vda5050pp::Order makeAppending(uint32_t node_seq, uint32_t update_id, int n_actions) {
+  vda5050pp::Edge edge;
+  edge.edgeId = "E" + std::to_string(node_seq - 1);
+  edge.sequenceId = node_seq - 1;
+  edge.released = true;
+  edge.startNodeId = "N" + std::to_string(node_seq - 2);
+  edge.endNodeId = "N" + std::to_string(node_seq);
+
+  vda5050pp::Order order;
+  order.orderId = "soak";
+  order.orderUpdateId = update_id;
+  order.nodes.push_back(makeNode(node_seq - 2, 0));
+  order.nodes.push_back(makeNode(node_seq, n_actions));
+  order.edges.push_back(std::move(edge));
+  return order;
+}
+
+int main(int argc, char **argv) {
+  // Each task (a drive step or an action) takes task_seconds of simulated time
+  double hours = argc > 1 ? std::atof(argv[1]) : 24.0;
+  int n_actions = argc > 2 ? std::atoi(argv[2]) : 4;
+  double task_seconds = argc > 3 ? std::atof(argv[3]) : 1.0;
+
+  vda5050pp::interface_agv::Handlers<SoakNavigationHandler, SoakActionHandler,
+                                     NoopPauseResumeHandler>
+      handlers;
+  vda5050pp::interface_agv::Handle handle({}, std::make_shared<NullConnector>(), handlers);
+  auto &state = vda5050pp::core::interface_agv::HandleAccessor(handle).getState();
+
+  vda5050pp::Order order;
+  order.orderId = "soak";
+  order.orderUpdateId = 0;
+  order.nodes.push_back(makeNode(0, 0));
+  state.setOrder(order);
+
+  vda5050pp::core::logic::NetManager net_manager(handle);
+  net_manager.interpret();
+  handle.spinAll();
+
+  std::printf("%6s %10s %10s %10s %10s %12s %12s\n", "hour", "seq", "tasks", "places",
+              "trans.", "tick [us]", "rss [kB]");
+
+  double now = 0;
+  long tasks = 0;
+  long tasks_this_hour = 0;
+  int hour = 0;
+  Clock::duration tick_time{};
+  uint32_t update_id = 1;
+  uint32_t node_seq = 2;
+
+  // Finish the current task and tick the net, which launches the next one
+  auto step = [&](auto &&finish) {
+    finish();
+    auto begin = Clock::now();
+    net_manager.tick();
+    tick_time += Clock::now() - begin;
+    handle.spinAll();
+    now += task_seconds;
+    tasks++;
+    tasks_this_hour++;
+  };
+
+  while (now < hours * 3600.0) {
+    // Append the next node, once the AGV drives towards it (keeps the net at two steps ahead)
+    state.appendOrder(makeAppending(node_seq, update_id++, n_actions));
+    net_manager.interpret();
+    handle.spinAll();
+
+    if (current_navigation == nullptr) {
+      std::fprintf(stderr, "navigation to node %u did not start\n", node_seq);
+      return 1;
+    }
+    step([] { current_navigation->finish(); });
+    for (int i = 0; i < n_actions; i++) {
+      auto id = "N" + std::to_string(node_seq) + "A" + std::to_string(i);
+      step([&id] { action_by_id.at(id)->finish(); });
+    }
+    node_seq += 2;
+
+    if (now >= (hour + 1) * 3600.0) {
+      hour++;
+      const auto &net = net_manager.getNet();
+      std::printf("%6d %10u %10ld %10zu %10zu %12.2f %12ld\n", hour, net_manager.nextSeq(), tasks,
+                  net.numPlaces(), net.numTransitions(), micros(tick_time) / tasks_this_hour,
+                  rssKb());
+      std::fflush(stdout);
+      tick_time = {};
+      tasks_this_hour = 0;
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,126 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains a benchmark for a fleet of Handles driven by one SimulationExecutor
+//
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <memory>
+#include <vector>
+
+#include "vda5050++/core/common/simulation_executor.h"
+#include "vda5050++/interface_agv/handle.h"
+
+using namespace std::chrono_literals;
+
+class NoopNavigationHandler : public vda5050pp::interface_agv::ContinuousNavigationHandler {
+public:
+  void horizonUpdated(const std::list<vda5050pp::Node> &,
+                      const std::list<vda5050pp::Edge> &) override {}
+  void baseIncreased(const std::list<vda5050pp::Node> &,
+                     const std::list<vda5050pp::Edge> &) override {}
+  void start(const std::list<vda5050pp::Node> &, const std::list<vda5050pp::Edge> &) override {}
+  void pause() override {}
+  void resume() override {}
+  void stop() override {}
+};
+
+class NoopActionHandler : public vda5050pp::interface_agv::ActionHandler {
+public:
+  void start(const vda5050pp::Action &) override {}
+  void pause(const vda5050pp::Action &) override {}
+  void resume(const vda5050pp::Action &) override {}
+  void stop(const vda5050pp::Action &) override {}
+};
+
+class NoopPauseResumeHandler : public vda5050pp::interface_agv::PauseResumeHandler {
+public:
+  void doPause() override {}
+  void doResume() override {}
+};
+
+class NoopOdometryHandler : public vda5050pp::interface_agv::OdometryHandler {
+public:
+  void initializePosition(const vda5050pp::AGVPosition &) noexcept(false) override {}
+};
+
+// Counts the sent messages, instead of sending them
+class CountingConnector : public vda5050pp::interface_mc::Connector {
+public:
+  uint64_t messages = 0;
+
+  void setConsumer(std::weak_ptr<vda5050pp::interface_mc::MessageConsumer>) noexcept(
+      true) override {}
+  void queueConnection(const vda5050pp::Connection &) noexcept(false) override { messages++; }
+  void queueState(const vda5050pp::State &) noexcept(false) override { messages++; }
+  void queueVisualization(const vda5050pp::Visualization &) noexcept(false) override {
+    messages++;
+  }
+  void connect() noexcept(false) override {}
+  void disconnect() noexcept(false) override {}
+};
+
+struct Vehicle {
+  std::shared_ptr<CountingConnector> connector = std::make_shared<CountingConnector>();
+  std::shared_ptr<NoopOdometryHandler> odometry = std::make_shared<NoopOdometryHandler>();
+  std::unique_ptr<vda5050pp::interface_agv::Handle> handle;
+  vda5050pp::AGVPosition position;
+};
+
+// Moves the vehicle each odometry period (i.e. the vehicle model of a simulator)
+static void drive(vda5050pp::core::common::SimulationExecutor &simulation, Vehicle &vehicle,
+                  std::chrono::system_clock::duration period) {
+  vehicle.position.x += 0.1;
+  vehicle.odometry->setAGVPosition(vehicle.position);
+  simulation.scheduleAfter(&vehicle, period, [&simulation, &vehicle, period] {
+    drive(simulation, vehicle, period);
+  });
+}
+
+int main(int argc, char **argv) {
+  int n_vehicles = argc > 1 ? std::atoi(argv[1]) : 100;
+  auto simulated = std::chrono::seconds(argc > 2 ? std::atoi(argv[2]) : 3600);
+
+  vda5050pp::interface_agv::Handlers<NoopNavigationHandler, NoopActionHandler,
+                                     NoopPauseResumeHandler>
+      handlers;
+  auto simulation = std::make_shared<vda5050pp::core::common::SimulationExecutor>();
+
+  std::vector<Vehicle> fleet(n_vehicles);
+  for (auto &vehicle : fleet) {
+    vehicle.handle = std::make_unique<vda5050pp::interface_agv::Handle>(
+        vda5050pp::interface_agv::agv_description::AGVDescription{}, vehicle.connector, handlers,
+        nullptr, simulation);
+    vehicle.handle->setOdometryHandler(vehicle.odometry);
+    vehicle.odometry->setVelocity({});
+    drive(*simulation, vehicle, 100ms);
+    vehicle.odometry->enableAutomaticVisualizationMessages(1s);
+  }
+
+  auto begin = std::chrono::steady_clock::now();
+  simulation->advanceBy(simulated);
+  auto wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+  uint64_t messages = 0;
+  for (const auto &vehicle : fleet) {
+    messages += vehicle.connector->messages;
+  }
+  auto vehicle_seconds = double(n_vehicles) * double(simulated.count());
+
+  std::printf("%-24s %12d\n", "vehicles", n_vehicles);
+  std::printf("%-24s %12lld\n", "simulated [s]", static_cast<long long>(simulated.count()));
+  std::printf("%-24s %12.3f\n", "wall time [s]", wall);
+  std::printf("%-24s %12llu\n", "timers fired",
+              static_cast<unsigned long long>(simulation->getStatistics().timers_fired));
+  std::printf("%-24s %12llu\n", "messages sent", static_cast<unsigned long long>(messages));
+  std::printf("%-24s %12.0f\n", "vehicle-seconds / s", vehicle_seconds / wall);
+
+  return 0;
+}
@@ -0,0 +1,68 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains the LoopbackConnector, an in-process connector to a VirtualMasterControl
+//
+
+#ifndef EXTRA_LOOPBACK_CONNECTOR_INCLUDE_VDA5050_2B_2B_EXTRA_LOOPBACK_CONNECTOR
+#define EXTRA_LOOPBACK_CONNECTOR_INCLUDE_VDA5050_2B_2B_EXTRA_LOOPBACK_CONNECTOR
+
+#include <vda5050++/extra/virtual_master_control.h>
+#include <vda5050++/interface_mc/connector.h>
+
+#include <memory>
+
+namespace vda5050pp::extra {
+
+///
+///\brief An in-process implementation of the vda5050pp::interface_mc::Connector, which
+/// exchanges all messages with a VirtualMasterControl (no network involved)
+///
+class LoopbackConnector final : public vda5050pp::interface_mc::Connector {
+private:
+  std::shared_ptr<VirtualMasterControl> master_;
+
+public:
+  ///
+  ///\brief Construct a new LoopbackConnector
+  ///
+  ///\param master the virtual master control to connect to
+  ///
+  explicit LoopbackConnector(std::shared_ptr<VirtualMasterControl> master);
+
+  ~LoopbackConnector() override;
+
+  ///
+  ///\brief Set the consumer for the ingoing messages
+  ///
+  ///\param consumer the consumer
+  ///
+  void setConsumer(std::weak_ptr<vda5050pp::interface_mc::MessageConsumer> consumer) noexcept(
+      true) override;
+
+  ///\brief Queue a connection message for sending
+  void queueConnection(const vda5050pp::Connection &connection) noexcept(false) override;
+
+  /// \brief Queue a State message for sending
+  void queueState(const vda5050pp::State &state) noexcept(false) override;
+
+  /// \brief Queue a Visualization message for sending
+  void queueVisualization(const vda5050pp::Visualization &visualization) noexcept(false) override;
+
+  ///
+  ///\brief Connect to the virtual master control
+  ///
+  void connect() noexcept(false) override;
+
+  ///
+  ///\brief Disconnect from the virtual master control
+  ///
+  void disconnect() noexcept(false) override;
+};
+
+}  // namespace vda5050pp::extra
+
+#endif /* EXTRA_LOOPBACK_CONNECTOR_INCLUDE_VDA5050_2B_2B_EXTRA_LOOPBACK_CONNECTOR */
@@ -0,0 +1,234 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains the VirtualMasterControl, the in-process counterpart of the
+// LoopbackConnector
+//
+
+#ifndef EXTRA_LOOPBACK_CONNECTOR_INCLUDE_VDA5050_2B_2B_EXTRA_VIRTUAL_MASTER_CONTROL
+#define EXTRA_LOOPBACK_CONNECTOR_INCLUDE_VDA5050_2B_2B_EXTRA_VIRTUAL_MASTER_CONTROL
+
+#include <vda5050++/core/common/histogram.h>
+#include <vda5050++/interface_mc/message_consumer.h>
+#include <vda5050++/model/Connection.h>
+#include <vda5050++/model/InstantActions.h>
+#include <vda5050++/model/Order.h>
+#include <vda5050++/model/State.h>
+#include <vda5050++/model/Visualization.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace vda5050pp::extra {
+
+///
+///\brief Determines how messages are passed between LoopbackConnector and VirtualMasterControl
+///
+enum class LoopbackMode {
+  ///\brief pass the model objects
+  k_objects,
+  ///\brief serialize each message to json and deserialize it on the receiving side
+  k_serialized,
+};
+
+///
+///\brief An in-process stand-in for a master control (and broker), connected to a Handle via
+/// a LoopbackConnector
+///
+/// Orders and instant actions are handed to the Handle in the calling thread. All messages sent by
+/// the Handle are recorded, such that the end-to-end latency (order -> first state reporting the
+/// order) and the throughput can be measured without any network.
+///
+class VirtualMasterControl {
+public:
+  class NotConnectedError : public std::logic_error {
+  public:
+    NotConnectedError() : std::logic_error("No LoopbackConnector connected") {}
+  };
+
+  ///
+  ///\brief Snapshot of the message statistics
+  ///
+  struct Statistics {
+    ///\brief number of sent orders
+    uint64_t orders_sent = 0;
+    ///\brief number of sent instant actions
+    uint64_t instant_actions_sent = 0;
+    ///\brief number of received connection messages
+    uint64_t connections_received = 0;
+    ///\brief number of received state messages
+    uint64_t states_received = 0;
+    ///\brief number of received visualization messages
+    uint64_t visualizations_received = 0;
+    ///\brief number of sent orders, which were not reported by a state within the order timeout
+    /// (i.e. rejected orders), checked whenever an order is sent or a state is received
+    uint64_t orders_expired = 0;
+    ///\brief number of sent orders currently waiting for a state reporting them
+    size_t orders_pending = 0;
+    ///\brief number of serialized bytes sent (LoopbackMode::k_serialized only)
+    uint64_t bytes_sent = 0;
+    ///\brief number of serialized bytes received (LoopbackMode::k_serialized only)
+    uint64_t bytes_received = 0;
+    ///\brief time between sending an order and receiving the first state with its orderId and
+    /// orderUpdateId
+    vda5050pp::core::common::LatencyHistogram order_to_state_latency{
+        vda5050pp::core::common::defaultLatencyBounds()};
+    ///\brief time of the first sent or received message
+    std::optional<std::chrono::steady_clock::time_point> first_message;
+    ///\brief time of the last sent or received message
+    std::optional<std::chrono::steady_clock::time_point> last_message;
+  };
+
+private:
+  friend class LoopbackConnector;
+
+  LoopbackMode mode_;
+  std::chrono::steady_clock::duration order_timeout_;
+
+  mutable std::mutex mutex_;
+  mutable std::condition_variable state_cv_;
+  std::weak_ptr<vda5050pp::interface_mc::MessageConsumer> consumer_;
+  bool connected_ = false;
+  std::optional<vda5050pp::State> last_state_;
+  std::optional<vda5050pp::Connection> last_connection_;
+  std::optional<vda5050pp::Visualization> last_visualization_;
+  uint64_t state_counter_ = 0;
+  ///\brief (orderId, orderUpdateId) -> time sent
+  std::map<std::pair<std::string, uint32_t>, std::chrono::steady_clock::time_point>
+      pending_orders_;
+  Statistics statistics_;
+
+  ///
+  ///\brief Pass msg through the loopback (a json round trip in LoopbackMode::k_serialized)
+  ///
+  ///\tparam MessageT the type of the message
+  ///\param msg the message
+  ///\param bytes counter of the serialized bytes
+  ///\return MessageT the message as seen by the receiver
+  ///
+  template <typename MessageT> MessageT loop(const MessageT &msg, uint64_t &bytes) const;
+
+  ///
+  ///\brief Update the first/last message timestamps (mutex_ has to be held)
+  ///
+  void touch() noexcept(true);
+
+  ///
+  ///\brief Drop all pending orders sent before now - order_timeout_ and count them as expired
+  /// (mutex_ has to be held)
+  ///
+  ///\param now the current time
+  ///
+  void expireOrders(std::chrono::steady_clock::time_point now) noexcept(true);
+
+  ///
+  ///\brief Get the consumer to send a message to
+  ///
+  ///\return std::shared_ptr<vda5050pp::interface_mc::MessageConsumer>
+  ///\throws NotConnectedError if no connector is connected
+  ///
+  std::shared_ptr<vda5050pp::interface_mc::MessageConsumer> getConsumer() const noexcept(false);
+
+  // Called by the LoopbackConnector
+  void setConsumer(std::weak_ptr<vda5050pp::interface_mc::MessageConsumer> consumer) noexcept(
+      true);
+  void setConnected(bool connected) noexcept(true);
+  void receiveConnection(const vda5050pp::Connection &connection) noexcept(false);
+  void receiveState(const vda5050pp::State &state) noexcept(false);
+  void receiveVisualization(const vda5050pp::Visualization &visualization) noexcept(false);
+
+public:
+  ///
+  ///\brief Construct a new VirtualMasterControl
+  ///
+  ///\param mode how messages are passed to and from the Handle
+  ///\param order_timeout time after which a sent order, which was not reported by a state yet,
+  /// is no longer tracked and counted as expired
+  ///
+  explicit VirtualMasterControl(
+      LoopbackMode mode = LoopbackMode::k_objects,
+      std::chrono::steady_clock::duration order_timeout = std::chrono::seconds(10));
+
+  ///
+  ///\brief Send an order to the Handle (synchronously in the calling thread)
+  ///
+  ///\param order the order
+  ///\throws NotConnectedError if no connector is connected
+  ///
+  void sendOrder(const vda5050pp::Order &order) noexcept(false);
+
+  ///
+  ///\brief Send instant actions to the Handle (synchronously in the calling thread)
+  ///
+  ///\param instant_actions the instant actions
+  ///\throws NotConnectedError if no connector is connected
+  ///
+  void sendInstantActions(const vda5050pp::InstantActions &instant_actions) noexcept(false);
+
+  ///
+  ///\brief Is a LoopbackConnector connected
+  ///
+  ///\return bool
+  ///
+  bool isConnected() const noexcept(true);
+
+  ///
+  ///\brief Get the last received state
+  ///
+  ///\return std::optional<vda5050pp::State>
+  ///
+  std::optional<vda5050pp::State> getLastState() const noexcept(true);
+
+  ///
+  ///\brief Get the last received connection message
+  ///
+  ///\return std::optional<vda5050pp::Connection>
+  ///
+  std::optional<vda5050pp::Connection> getLastConnection() const noexcept(true);
+
+  ///
+  ///\brief Get the last received visualization message
+  ///
+  ///\return std::optional<vda5050pp::Visualization>
+  ///
+  std::optional<vda5050pp::Visualization> getLastVisualization() const noexcept(true);
+
+  ///
+  ///\brief Wait for a state matching the predicate. The last received state is checked first,
+  /// because states may already be received while sendOrder() is running.
+  ///
+  ///\param predicate the predicate
+  ///\param timeout the maximum time to wait
+  ///\return std::optional<vda5050pp::State> the state or std::nullopt on timeout
+  ///
+  std::optional<vda5050pp::State> waitForState(
+      const std::function<bool(const vda5050pp::State &)> &predicate,
+      std::chrono::steady_clock::duration timeout) const noexcept(true);
+
+  ///
+  ///\brief Get a snapshot of the message statistics
+  ///
+  ///\return Statistics
+  ///
+  Statistics getStatistics() const noexcept(true);
+
+  ///
+  ///\brief Reset the message statistics (i.e. after warm-up)
+  ///
+  void resetStatistics() noexcept(true);
+};
+
+}  // namespace vda5050pp::extra
+
+#endif /* EXTRA_LOOPBACK_CONNECTOR_INCLUDE_VDA5050_2B_2B_EXTRA_VIRTUAL_MASTER_CONTROL */
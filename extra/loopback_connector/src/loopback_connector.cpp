@@ -0,0 +1,44 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+//
+
+#include "vda5050++/extra/loopback_connector.h"
+
+#include <stdexcept>
+
+using namespace vda5050pp::extra;
+
+LoopbackConnector::LoopbackConnector(std::shared_ptr<VirtualMasterControl> master)
+    : master_(std::move(master)) {
+  if (this->master_ == nullptr) {
+    throw std::invalid_argument("LoopbackConnector: master must not be nullptr");
+  }
+}
+
+LoopbackConnector::~LoopbackConnector() { this->master_->setConnected(false); }
+
+void LoopbackConnector::setConsumer(
+    std::weak_ptr<vda5050pp::interface_mc::MessageConsumer> consumer) noexcept(true) {
+  this->master_->setConsumer(consumer);
+}
+
+void LoopbackConnector::queueConnection(const vda5050pp::Connection &connection) noexcept(false) {
+  this->master_->receiveConnection(connection);
+}
+
+void LoopbackConnector::queueState(const vda5050pp::State &state) noexcept(false) {
+  this->master_->receiveState(state);
+}
+
+void LoopbackConnector::queueVisualization(const vda5050pp::Visualization &visualization) noexcept(
+    false) {
+  this->master_->receiveVisualization(visualization);
+}
+
+void LoopbackConnector::connect() noexcept(false) { this->master_->setConnected(true); }
+
+void LoopbackConnector::disconnect() noexcept(false) { this->master_->setConnected(false); }
@@ -0,0 +1,210 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+//
+
+#include "vda5050++/extra/virtual_master_control.h"
+
+#include "vda5050++/extra/json_model.h"
+
+using namespace vda5050pp::extra;
+
+template <typename MessageT>
+MessageT VirtualMasterControl::loop(const MessageT &msg, uint64_t &bytes) const {
+  if (this->mode_ == LoopbackMode::k_objects) {
+    return msg;
+  }
+
+  auto serialized = json(msg).dump();
+  bytes += serialized.size();
+  return json::parse(serialized).get<MessageT>();
+}
+
+void VirtualMasterControl::touch() noexcept(true) {
+  auto now = std::chrono::steady_clock::now();
+  if (!this->statistics_.first_message.has_value()) {
+    this->statistics_.first_message = now;
+  }
+  this->statistics_.last_message = now;
+}
+
+void VirtualMasterControl::expireOrders(std::chrono::steady_clock::time_point now) noexcept(true) {
+  for (auto it = this->pending_orders_.begin(); it != this->pending_orders_.end();) {
+    if (now - it->second > this->order_timeout_) {
+      this->statistics_.orders_expired++;
+      it = this->pending_orders_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+std::shared_ptr<vda5050pp::interface_mc::MessageConsumer> VirtualMasterControl::getConsumer()
+    const noexcept(false) {
+  std::unique_lock lock(this->mutex_);
+  auto consumer = this->consumer_.lock();
+  if (!this->connected_ || consumer == nullptr) {
+    throw NotConnectedError();
+  }
+  return consumer;
+}
+
+void VirtualMasterControl::setConsumer(
+    std::weak_ptr<vda5050pp::interface_mc::MessageConsumer> consumer) noexcept(true) {
+  std::unique_lock lock(this->mutex_);
+  this->consumer_ = consumer;
+}
+
+void VirtualMasterControl::setConnected(bool connected) noexcept(true) {
+  std::unique_lock lock(this->mutex_);
+  this->connected_ = connected;
+}
+
+void VirtualMasterControl::receiveConnection(const vda5050pp::Connection &connection) noexcept(
+    false) {
+  uint64_t bytes = 0;
+  auto received = this->loop(connection, bytes);
+
+  std::unique_lock lock(this->mutex_);
+  this->touch();
+  this->statistics_.connections_received++;
+  this->statistics_.bytes_received += bytes;
+  this->last_connection_ = std::move(received);
+}
+
+void VirtualMasterControl::receiveState(const vda5050pp::State &state) noexcept(false) {
+  uint64_t bytes = 0;
+  auto received = this->loop(state, bytes);
+
+  {
+    auto now = std::chrono::steady_clock::now();
+    std::unique_lock lock(this->mutex_);
+    this->touch();
+    this->statistics_.states_received++;
+    this->statistics_.bytes_received += bytes;
+
+    if (auto it = this->pending_orders_.find({received.orderId, received.orderUpdateId});
+        it != this->pending_orders_.end()) {
+      this->statistics_.order_to_state_latency.record(now - it->second);
+      this->pending_orders_.erase(it);
+    }
+    this->expireOrders(now);
+
+    this->last_state_ = std::move(received);
+    this->state_counter_++;
+  }
+  this->state_cv_.notify_all();
+}
+
+void VirtualMasterControl::receiveVisualization(
+    const vda5050pp::Visualization &visualization) noexcept(false) {
+  uint64_t bytes = 0;
+  auto received = this->loop(visualization, bytes);
+
+  std::unique_lock lock(this->mutex_);
+  this->touch();
+  this->statistics_.visualizations_received++;
+  this->statistics_.bytes_received += bytes;
+  this->last_visualization_ = std::move(received);
+}
+
+VirtualMasterControl::VirtualMasterControl(LoopbackMode mode,
+                                           std::chrono::steady_clock::duration order_timeout)
+    : mode_(mode), order_timeout_(order_timeout) {}
+
+void VirtualMasterControl::sendOrder(const vda5050pp::Order &order) noexcept(false) {
+  auto consumer = this->getConsumer();
+
+  uint64_t bytes = 0;
+  auto sent = this->loop(order, bytes);
+
+  {
+    std::unique_lock lock(this->mutex_);
+    this->touch();
+    this->statistics_.orders_sent++;
+    this->statistics_.bytes_sent += bytes;
+    auto now = std::chrono::steady_clock::now();
+    this->expireOrders(now);
+    this->pending_orders_[{order.orderId, order.orderUpdateId}] = now;
+  }
+
+  consumer->receivedOrder(sent);
+}
+
+void VirtualMasterControl::sendInstantActions(
+    const vda5050pp::InstantActions &instant_actions) noexcept(false) {
+  auto consumer = this->getConsumer();
+
+  uint64_t bytes = 0;
+  auto sent = this->loop(instant_actions, bytes);
+
+  {
+    std::unique_lock lock(this->mutex_);
+    this->touch();
+    this->statistics_.instant_actions_sent++;
+    this->statistics_.bytes_sent += bytes;
+  }
+
+  consumer->receivedInstantActions(sent);
+}
+
+bool VirtualMasterControl::isConnected() const noexcept(true) {
+  std::unique_lock lock(this->mutex_);
+  return this->connected_;
+}
+
+std::optional<vda5050pp::State> VirtualMasterControl::getLastState() const noexcept(true) {
+  std::unique_lock lock(this->mutex_);
+  return this->last_state_;
+}
+
+std::optional<vda5050pp::Connection> VirtualMasterControl::getLastConnection() const
+    noexcept(true) {
+  std::unique_lock lock(this->mutex_);
+  return this->last_connection_;
+}
+
+std::optional<vda5050pp::Visualization> VirtualMasterControl::getLastVisualization() const
+    noexcept(true) {
+  std::unique_lock lock(this->mutex_);
+  return this->last_visualization_;
+}
+
+std::optional<vda5050pp::State> VirtualMasterControl::waitForState(
+    const std::function<bool(const vda5050pp::State &)> &predicate,
+    std::chrono::steady_clock::duration timeout) const noexcept(true) {
+  auto deadline = std::chrono::steady_clock::now() + timeout;
+
+  std::unique_lock lock(this->mutex_);
+  if (this->last_state_.has_value() && predicate(*this->last_state_)) {
+    return this->last_state_;
+  }
+  auto seen = this->state_counter_;
+  while (true) {
+    bool received = this->state_cv_.wait_until(
+        lock, deadline, [this, &seen] { return this->state_counter_ != seen; });
+    if (!received) {
+      return std::nullopt;
+    }
+    seen = this->state_counter_;
+    if (predicate(*this->last_state_)) {
+      return this->last_state_;
+    }
+  }
+}
+
+VirtualMasterControl::Statistics VirtualMasterControl::getStatistics() const noexcept(true) {
+  std::unique_lock lock(this->mutex_);
+  Statistics statistics = this->statistics_;
+  statistics.orders_pending = this->pending_orders_.size();
+  return statistics;
+}
+
+void VirtualMasterControl::resetStatistics() noexcept(true) {
+  std::unique_lock lock(this->mutex_);
+  this->statistics_ = Statistics();
+  this->pending_orders_.clear();
+}
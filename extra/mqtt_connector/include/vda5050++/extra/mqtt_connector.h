@@ -11,14 +11,26 @@
 
 #include <mqtt/async_client.h>
 #include <vda5050++/interface_agv/agv_description/agv_description.h>
+#include <vda5050++/core/common/histogram.h>
+#include <vda5050++/core/common/interruptable_timer.h>
+#include <vda5050++/extra/mqtt_delivery_window.h>
+#include <vda5050++/interface_agv/logger.h>
 #include <vda5050++/interface_mc/connector.h>
 
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <queue>
 #include <string_view>
+#include <thread>
+#include <unordered_map>
 
 namespace vda5050pp::extra {
 
@@ -39,20 +51,79 @@ private:
   std::string visualization_topic_;
   vda5050pp::Header header_template_;
   std::atomic_int header_id_counter_ = 1;
+  std::shared_ptr<vda5050pp::interface_agv::Logger> logger_;  // accessed atomically
 
-  std::map<mqtt::delivery_token_ptr, mqtt::message_ptr> pending_deliveries_;
+  ///
+  ///\brief Get the logger set by setLogger() (the process-wide logger, if none was set)
+  ///
+  ///\return std::shared_ptr<vda5050pp::interface_agv::Logger> the logger
+  ///
+  std::shared_ptr<vda5050pp::interface_agv::Logger> getLogger() const noexcept(true);
+
+  ///\brief Handles the (unparsed) payload of a message received on a subscribed topic
+  using TopicHandlerT =
+      std::function<void(vda5050pp::interface_mc::MessageConsumer &, std::string_view payload)>;
+
+  struct Subscription {
+    int qos;
+    TopicHandlerT handler;
+  };
 
-  const int k_qos = 0;
-  bool shutdown_ = false;
+  ///\brief subscribed topics (views into the topic members above) -> subscription
+  std::unordered_map<std::string_view, Subscription> topic_handlers_;
 
-  void reconnect();
+  std::atomic_bool shutdown_ = false;
+
+  std::unique_ptr<std::thread> reconnect_thread_;
+  std::mutex reconnect_mutex_;
+  std::condition_variable reconnect_cv_;
+  bool reconnect_requested_ = false;
+  vda5050pp::core::common::InterruptableTimer reconnect_timer_;
+  std::chrono::milliseconds reconnect_min_delay_;
+  std::chrono::milliseconds reconnect_max_delay_;
+
+  ///
+  ///\brief Subscribe to topic on (re-)connect and dispatch its messages to handler
+  ///
+  ///\param topic the topic (must be a member of *this, the handler table keeps a view of it)
+  ///\param qos the qos of the subscription
+  ///\param handler the handler
+  ///
+  void addTopicHandler(const std::string &topic, int qos, TopicHandlerT &&handler) noexcept(true);
+
+  ///
+  ///\brief Request a reconnect (non-blocking, handled by the reconnect thread)
+  ///
+  void reconnect() noexcept(true);
+
+  ///
+  ///\brief The routine of the reconnect thread, reconnects with jittered exponential backoff
+  ///
+  void reconnectRoutine() noexcept(true);
 
 public:
+  ///
+  ///\brief Thrown by disconnect() without an active connection (and by the MqttGateway)
+  ///
+  /// The queue*() functions do not throw it, while offline they buffer the messages in the outbox.
+  ///
   class NotConnectedError : public std::logic_error {
   public:
     NotConnectedError() : std::logic_error("No active MQTT connection") {}
   };
 
+  ///
+  ///\brief QoS and retained flag of a topic
+  ///
+  struct TopicOptions {
+    ///\brief the mqtt qos level (0, 1 or 2)
+    int qos = 0;
+    ///\brief set the retained flag on published messages (ignored for subscriptions)
+    bool retained = false;
+  };
+
+  using OverflowPolicy = MqttDeliveryWindow::OverflowPolicy;
+
   ///
   ///\brief Configuration struct for the MqttConnector
   ///
@@ -71,8 +142,141 @@ public:
     bool enable_cert_check = true;
     ///\brief enable ssl
     bool use_ssl = true;
+    ///\brief maximum number of published, but not yet completed messages
+    uint32_t max_in_flight = 10;
+    ///\brief maximum number of messages waiting for a free in-flight slot
+    uint32_t max_queued = 100;
+    ///\brief what to do with messages, that do not fit into the in-flight window
+    OverflowPolicy overflow_policy = OverflowPolicy::k_latest_wins;
+    ///\brief initial delay before reconnecting, doubled after each failed attempt
+    std::chrono::milliseconds reconnect_min_delay = std::chrono::milliseconds(500);
+    ///\brief cap of the reconnect delay
+    std::chrono::milliseconds reconnect_max_delay = std::chrono::seconds(30);
+    ///\brief if set, the connection messages in the offline outbox are mirrored to this file
+    /// and restored on construction (states and visualizations are not restored)
+    std::optional<std::string> outbox_spill_file;
+    ///\brief options of the subscribed order topic
+    TopicOptions order_topic = {0, false};
+    ///\brief options of the subscribed instantActions topic
+    TopicOptions instant_actions_topic = {0, false};
+    ///\brief options of the published connection topic (also used for the last will)
+    TopicOptions connection_topic = {0, true};
+    ///\brief options of the published state topic
+    TopicOptions state_topic = {0, false};
+    ///\brief options of the published visualization topic
+    TopicOptions visualization_topic = {0, false};
+  };
+
+  using QosStatistics = MqttDeliveryWindow::QosStatistics;
+
+  ///
+  ///\brief Snapshot of the outgoing message statistics of the MqttConnector
+  ///
+  struct Statistics : MqttDeliveryWindow::Statistics {
+    ///\brief number of reconnect attempts
+    uint64_t reconnect_attempts = 0;
+    ///\brief number of successful reconnects
+    uint64_t reconnects = 0;
+    ///\brief time between the request of a reconnect and the reestablished connection
+    vda5050pp::core::common::LatencyHistogram reconnect_duration{
+        vda5050pp::core::common::defaultLatencyBounds()};
+  };
+
+private:
+  ///
+  ///\brief Listens for the completion of published messages and forwards it to the connector
+  ///
+  class DeliveryListener : public mqtt::iaction_listener {
+  private:
+    MqttConnector &connector_;
+
+  public:
+    explicit DeliveryListener(MqttConnector &connector) : connector_(connector) {}
+    void on_failure(const mqtt::token &tok) override;
+    void on_success(const mqtt::token &tok) override;
   };
 
+  MqttDeliveryWindow window_;
+  std::optional<std::string> outbox_spill_file_;
+  std::mutex spill_mutex_;
+  TopicOptions connection_options_;
+  TopicOptions state_options_;
+  TopicOptions visualization_options_;
+  DeliveryListener delivery_listener_;
+
+  mutable std::mutex reconnect_statistics_mutex_;  // guards the reconnect statistics
+  uint64_t reconnect_attempts_ = 0;
+  uint64_t reconnects_ = 0;
+  vda5050pp::core::common::LatencyHistogram reconnect_duration_{
+      vda5050pp::core::common::defaultLatencyBounds()};
+
+  ///
+  ///\brief Create a message for the given topic
+  ///
+  ///\param topic the topic
+  ///\param payload the serialized payload
+  ///\param options qos and retained flag
+  ///\return mqtt::message_ptr the message
+  ///
+  mqtt::message_ptr mkMessage(const std::string &topic, std::string &&payload,
+                              const TopicOptions &options) const noexcept(true);
+
+  ///
+  ///\brief Publish the message, if the window has a free in-flight slot, otherwise queue it
+  /// according to the overflow policy. While offline, the message is put into the outbox.
+  ///
+  ///\param msg the message
+  ///
+  void enqueue(mqtt::message_ptr msg) noexcept(false);
+
+  ///
+  ///\brief Go online and move all outbox messages into the backlog (removes the spill file)
+  ///
+  void flushOutbox() noexcept(true);
+
+  ///
+  ///\brief Mirror the connection messages of the outbox to the spill file (if enabled)
+  ///
+  void spillOutbox() noexcept(true);
+
+  ///
+  ///\brief Restore the connection messages from the spill file (if enabled and present)
+  ///
+  void restoreOutbox() noexcept(true);
+
+  ///
+  ///\brief Publish a message with a reserved in-flight slot
+  ///
+  ///\param reserved the message and its delivery id
+  ///
+  void publishReserved(MqttDeliveryWindow::Reserved &&reserved) noexcept(false);
+
+  ///
+  ///\brief Move queued messages into free in-flight slots
+  ///
+  void pump() noexcept(true);
+
+  ///
+  ///\brief Called by the DeliveryListener, when a published message completed
+  ///
+  ///\param tok the delivery token
+  ///\param success was the delivery successful
+  ///
+  void deliveryCompleted(const mqtt::token &tok, bool success) noexcept(true);
+
+public:
+  ///
+  ///\brief Create the connect options (credentials, ssl and keep alive) from the MqttOptions,
+  /// as used by the MqttConnector and the MqttGateway
+  ///
+  ///\param opts the mqtt options
+  ///\param ssl_error_handler called with the ssl error messages of the client
+  ///\return mqtt::connect_options the connect options (without last will)
+  ///
+  static mqtt::connect_options mkConnectOptions(
+      const MqttOptions &opts,
+      std::function<void(const std::string &)> ssl_error_handler) noexcept(false);
+
   ///
   ///\brief Construct a new Mqtt Connector object
   ///
@@ -124,13 +328,28 @@ public:
   void setConsumer(std::weak_ptr<vda5050pp::interface_mc::MessageConsumer> consumer) noexcept(
       true) override;
 
-  ///\brief Queue a connection message for sending
+  ///
+  ///\brief Set the logger of the Handle using this connector (thread-safe)
+  ///
+  ///\param logger the logger
+  ///
+  void setLogger(std::shared_ptr<vda5050pp::interface_agv::Logger> logger) noexcept(
+      true) override;
+
+  ///
+  ///\brief Get a snapshot of the outgoing message statistics
+  ///
+  ///\return Statistics
+  ///
+  Statistics getStatistics() const noexcept(true);
+
+  ///\brief Queue a connection message for sending (buffered in the outbox while offline)
   void queueConnection(const vda5050pp::Connection &connection) noexcept(false) override;
 
-  /// \brief Queue a State message for sending
+  /// \brief Queue a State message for sending (only the newest is kept while offline)
   void queueState(const vda5050pp::State &state) noexcept(false) override;
 
-  /// \brief Queue a Visualization message for sending
+  /// \brief Queue a Visualization message for sending (only the newest is kept while offline)
   void queueVisualization(const vda5050pp::Visualization &visualization) noexcept(false) override;
 
   ///
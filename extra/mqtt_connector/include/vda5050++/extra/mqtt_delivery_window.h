@@ -0,0 +1,255 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains the MqttDeliveryWindow, which bounds and tracks the outgoing messages
+// of the MqttConnector
+//
+
+#ifndef EXTRA_MQTT_CONNECTOR_INCLUDE_VDA5050_2B_2B_EXTRA_MQTT_DELIVERY_WINDOW
+#define EXTRA_MQTT_CONNECTOR_INCLUDE_VDA5050_2B_2B_EXTRA_MQTT_DELIVERY_WINDOW
+
+#include <mqtt/async_client.h>
+#include <vda5050++/core/common/histogram.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace vda5050pp::extra {
+
+///
+///\brief The in-flight window, backlog and offline outbox of outgoing MQTT messages
+///
+/// The window does not publish anything itself. It decides, which messages may be published
+/// (reserved in-flight slots) and tracks their completion. All members are thread-safe.
+///
+class MqttDeliveryWindow {
+public:
+  ///
+  ///\brief Determines what happens to an outgoing message, if the in-flight window is full
+  ///
+  enum class OverflowPolicy {
+    ///\brief a queued state/visualization message is replaced by a newer one on the same topic,
+    /// if the queue is full, the oldest message is dropped (connection messages are never replaced)
+    k_latest_wins,
+    ///\brief if the queue is full, the oldest queued message is dropped
+    k_drop_oldest,
+    ///\brief if the queue is full, the new message is dropped
+    k_drop_newest,
+  };
+
+  ///
+  ///\brief Outgoing message statistics of a single QoS level
+  ///
+  struct QosStatistics {
+    ///\brief number of published messages
+    uint64_t published = 0;
+    ///\brief number of successfully delivered messages
+    uint64_t delivered = 0;
+    ///\brief number of messages, that failed to be delivered
+    uint64_t failed = 0;
+    ///\brief time between publishing and delivery of a message
+    vda5050pp::core::common::LatencyHistogram delivery_latency{
+        vda5050pp::core::common::defaultLatencyBounds()};
+  };
+
+  ///
+  ///\brief Snapshot of the outgoing message statistics
+  ///
+  struct Statistics {
+    ///\brief number of currently in-flight messages
+    size_t in_flight = 0;
+    ///\brief statistics per QoS level (index = qos)
+    std::array<QosStatistics, 3> per_qos;
+    ///\brief greatest number of simultaneously in-flight messages
+    size_t in_flight_max = 0;
+    ///\brief number of messages currently waiting for a free in-flight slot
+    size_t queued = 0;
+    ///\brief number of published messages
+    uint64_t published = 0;
+    ///\brief number of successfully delivered messages
+    uint64_t delivered = 0;
+    ///\brief number of messages, that failed to be delivered
+    uint64_t failed = 0;
+    ///\brief number of messages dropped due to the overflow policy
+    uint64_t dropped = 0;
+    ///\brief number of queued messages replaced by a newer one (OverflowPolicy::k_latest_wins)
+    uint64_t replaced = 0;
+    ///\brief time between publishing and delivery of a message
+    vda5050pp::core::common::LatencyHistogram delivery_latency{
+        vda5050pp::core::common::defaultLatencyBounds()};
+    ///\brief number of in-flight messages sampled each time a message is published
+    vda5050pp::core::common::Histogram<uint64_t> in_flight_depth{
+        vda5050pp::core::common::defaultSizeBounds()};
+    ///\brief number of messages currently buffered in the offline outbox
+    size_t outbox = 0;
+    ///\brief number of messages buffered in the offline outbox
+    uint64_t outboxed = 0;
+    ///\brief number of outbox messages superseded by a newer one on the same topic
+    uint64_t compacted = 0;
+  };
+
+  ///
+  ///\brief A message with a reserved in-flight slot, which has to be published now
+  ///
+  struct Reserved {
+    ///\brief the delivery id (passed back to complete() or abort())
+    uint64_t id;
+    mqtt::message_ptr msg;
+  };
+
+private:
+  struct PendingDelivery {
+    mqtt::message_ptr msg;
+    std::chrono::steady_clock::time_point published_at;
+  };
+
+  ///
+  ///\brief Buffers outgoing messages while offline
+  ///
+  struct Outbox {
+    ///\brief all connection messages in order
+    std::deque<mqtt::message_ptr> connection;
+    ///\brief the newest message of each other topic (in order of their first message)
+    std::vector<mqtt::message_ptr> latest;
+  };
+
+  mutable std::mutex mutex_;
+  std::map<uint64_t, PendingDelivery> in_flight_;
+  std::deque<mqtt::message_ptr> backlog_;
+  uint64_t next_delivery_id_ = 1;
+  uint32_t max_in_flight_;
+  uint32_t max_queued_;
+  OverflowPolicy overflow_policy_;
+  std::string connection_topic_;
+  bool online_ = false;
+  Outbox outbox_;
+  Statistics statistics_;
+
+  ///
+  ///\brief Count a failed delivery of msg (mutex_ has to be held)
+  ///
+  ///\param msg the message
+  ///
+  void countFailed(const mqtt::message_ptr &msg) noexcept(true);
+
+  ///
+  ///\brief Put msg into the outbox, compacting all but connection messages (mutex_ has to be held)
+  ///
+  ///\param msg the message
+  ///
+  void outboxMessage(mqtt::message_ptr msg) noexcept(true);
+
+  ///
+  ///\brief Enqueue msg into the backlog according to the overflow policy (mutex_ has to be held)
+  ///
+  ///\param msg the message
+  ///
+  void backlogMessage(mqtt::message_ptr msg) noexcept(true);
+
+  ///
+  ///\brief Reserve an in-flight slot for msg (mutex_ has to be held)
+  ///
+  ///\param msg the message
+  ///\return uint64_t the delivery id
+  ///
+  uint64_t reserveInFlight(const mqtt::message_ptr &msg) noexcept(true);
+
+public:
+  ///
+  ///\brief Construct a new MqttDeliveryWindow (initially offline)
+  ///
+  ///\param max_in_flight maximum number of published, but not yet completed messages (at least 1)
+  ///\param max_queued maximum number of messages waiting for a free in-flight slot
+  ///\param overflow_policy what to do with messages, that do not fit into the window
+  ///\param connection_topic the topic of the connection messages (never replaced or compacted)
+  ///
+  MqttDeliveryWindow(uint32_t max_in_flight, uint32_t max_queued, OverflowPolicy overflow_policy,
+                     std::string connection_topic) noexcept(true);
+
+  ///
+  ///\brief Admit an outgoing message. While online, it gets an in-flight slot, if one is free and
+  /// no other message is queued, otherwise it is queued according to the overflow policy.
+  /// While offline, the message is put into the outbox.
+  ///
+  ///\param msg the message
+  ///\return std::optional<Reserved> the message to publish now, if it got a slot
+  ///
+  std::optional<Reserved> admit(mqtt::message_ptr msg) noexcept(true);
+
+  ///
+  ///\brief Move queued messages into free in-flight slots (only while online)
+  ///
+  ///\return std::vector<Reserved> the messages to publish now
+  ///
+  std::vector<Reserved> pump() noexcept(false);
+
+  ///
+  ///\brief Complete an in-flight message and record its delivery statistics
+  ///
+  ///\param id the delivery id
+  ///\param success was the delivery successful
+  ///
+  void complete(uint64_t id, bool success) noexcept(true);
+
+  ///
+  ///\brief Release the slot of a message, which could not be published (counted as failed)
+  ///
+  ///\param id the delivery id
+  ///
+  void abort(uint64_t id) noexcept(true);
+
+  ///
+  ///\brief Go online and move all outbox messages into the backlog
+  /// (connection messages first in order, then the newest message of each other topic)
+  ///
+  void goOnline() noexcept(true);
+
+  ///
+  ///\brief Go offline, all further messages are put into the outbox
+  ///
+  ///\param connection_lost the connection was lost, in-flight QoS 0 messages are counted as failed
+  ///
+  void goOffline(bool connection_lost) noexcept(true);
+
+  ///
+  ///\brief Is the window online?
+  ///
+  ///\return online?
+  ///
+  bool isOnline() const noexcept(true);
+
+  ///
+  ///\brief Put a message into the outbox, regardless of the online state (i.e. to restore it)
+  ///
+  ///\param msg the message
+  ///
+  void restore(mqtt::message_ptr msg) noexcept(true);
+
+  ///
+  ///\brief Get the messages currently in the outbox (in the order they would be flushed)
+  ///
+  ///\return std::vector<mqtt::message_ptr> the messages
+  ///
+  std::vector<mqtt::message_ptr> getOutbox() const noexcept(false);
+
+  ///
+  ///\brief Get a snapshot of the statistics
+  ///
+  ///\return Statistics
+  ///
+  Statistics getStatistics() const noexcept(true);
+};
+
+}  // namespace vda5050pp::extra
+
+#endif /* EXTRA_MQTT_CONNECTOR_INCLUDE_VDA5050_2B_2B_EXTRA_MQTT_DELIVERY_WINDOW */
@@ -0,0 +1,226 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains the MqttGateway, which multiplexes the connectors of many vehicles
+// over a single MQTT client
+//
+
+#ifndef EXTRA_MQTT_CONNECTOR_INCLUDE_VDA5050_2B_2B_EXTRA_MQTT_GATEWAY
+#define EXTRA_MQTT_CONNECTOR_INCLUDE_VDA5050_2B_2B_EXTRA_MQTT_GATEWAY
+
+#include <mqtt/async_client.h>
+#include <vda5050++/extra/mqtt_connector.h>
+#include <vda5050++/interface_agv/agv_description/agv_description.h>
+#include <vda5050++/interface_agv/logger.h>
+#include <vda5050++/interface_mc/connector.h>
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace vda5050pp::extra {
+
+///
+///\brief Shares one MQTT client between the Connectors of many vehicles (i.e. one Handle per
+/// vehicle in a fleet gateway process)
+///
+/// The gateway subscribes to the order and instantActions topics of each hosted vehicle
+/// and routes incoming messages by manufacturer and serial number to the consumer of the
+/// matching Connector.
+///
+/// NOTE: The MQTT last will is per client, hence the vehicles do not get an individual
+///       CONNECTIONBROKEN message, if the gateway loses its connection ungracefully.
+///
+class MqttGateway final : public mqtt::callback, public mqtt::iaction_listener {
+public:
+  ///
+  ///\brief Per vehicle message statistics
+  ///
+  struct VehicleStatistics {
+    ///\brief number of received orders
+    uint64_t orders_received = 0;
+    ///\brief number of received instant actions
+    uint64_t instant_actions_received = 0;
+    ///\brief number of received messages, that could not be deserialized
+    uint64_t deserialization_errors = 0;
+    ///\brief number of published connection messages
+    uint64_t connections_published = 0;
+    ///\brief number of published state messages
+    uint64_t states_published = 0;
+    ///\brief number of published visualization messages
+    uint64_t visualizations_published = 0;
+    ///\brief number of messages, that could not be published
+    uint64_t publish_errors = 0;
+    ///\brief time of the last received message
+    std::optional<std::chrono::system_clock::time_point> last_received;
+    ///\brief time of the last published message
+    std::optional<std::chrono::system_clock::time_point> last_published;
+  };
+
+private:
+  class VehicleConnector;
+
+  struct Vehicle {
+    std::string order_topic;
+    std::string instant_actions_topic;
+    std::string connection_topic;
+    std::string state_topic;
+    std::string visualization_topic;
+    vda5050pp::Header header_template;
+    uint32_t header_id_counter = 1;
+    std::weak_ptr<vda5050pp::interface_mc::MessageConsumer> consumer;
+    ///\brief the logger of the Handle using the connector (if set)
+    std::shared_ptr<vda5050pp::interface_agv::Logger> logger;
+    bool online = false;
+    VehicleStatistics statistics;
+  };
+
+  mqtt::async_client mqtt_client_;
+  mqtt::connect_options connect_opts_;
+  std::string topic_prefix_;
+  std::mutex connect_mutex_;
+  std::shared_ptr<vda5050pp::interface_agv::Logger> logger_;  // accessed atomically
+
+  mutable std::mutex vehicles_mutex_;
+  ///\brief "<manufacturer>/<serial_number>" -> Vehicle
+  std::unordered_map<std::string, Vehicle> vehicles_;
+
+  MqttConnector::TopicOptions order_options_;
+  MqttConnector::TopicOptions instant_actions_options_;
+  MqttConnector::TopicOptions connection_options_;
+  MqttConnector::TopicOptions state_options_;
+  MqttConnector::TopicOptions visualization_options_;
+
+  ///
+  ///\brief Get the logger set by setLogger() (the process-wide logger, if none was set)
+  ///
+  ///\return std::shared_ptr<vda5050pp::interface_agv::Logger> the logger
+  ///
+  std::shared_ptr<vda5050pp::interface_agv::Logger> getLogger() const noexcept(true);
+
+  ///
+  ///\brief Get the logger of a vehicle (the logger of the gateway, if the vehicle has none)
+  ///
+  ///\param key the vehicle key
+  ///\return std::shared_ptr<vda5050pp::interface_agv::Logger> the logger
+  ///
+  std::shared_ptr<vda5050pp::interface_agv::Logger> getLogger(const std::string &key) const
+      noexcept(true);
+
+  ///
+  ///\brief Publish a message for a vehicle
+  ///
+  ///\param key the vehicle key
+  ///\param topic the topic
+  ///\param payload the serialized message
+  ///\param options qos and retained flag
+  ///\param counter the statistics counter to increment
+  ///
+  void publish(const std::string &key, const std::string &topic, std::string &&payload,
+               const MqttConnector::TopicOptions &options,
+               uint64_t VehicleStatistics::*counter) noexcept(false);
+
+  ///
+  ///\brief Publish a connection message for a vehicle
+  ///
+  ///\param key the vehicle key
+  ///\param state the connection state
+  ///
+  void publishConnection(const std::string &key,
+                         vda5050pp::ConnectionState state) noexcept(false);
+
+  ///
+  ///\brief Subscribe to the order and instantActions topics of a vehicle
+  ///
+  ///\param vehicle the vehicle
+  ///
+  void subscribe(const Vehicle &vehicle) noexcept(false);
+
+  ///
+  ///\brief Connect the shared client, if not already connected (blocking, thread-safe)
+  ///
+  void connectClient() noexcept(false);
+
+  ///
+  ///\brief Remove a vehicle and its subscriptions (called by the destructor of its connector)
+  ///
+  ///\param key the vehicle key
+  ///
+  void removeVehicle(const std::string &key) noexcept(true);
+
+public:
+  ///
+  ///\brief Construct a new MqttGateway
+  ///
+  ///\param client_id the MQTT client id of the gateway
+  ///\param opts the mqtt connection options to use (the delivery window, outbox and spill
+  ///            options are not used by the gateway, the topic options apply to all vehicles)
+  ///
+  MqttGateway(const std::string &client_id, const MqttConnector::MqttOptions &opts);
+
+  ~MqttGateway();
+
+  ///
+  ///\brief Set the logger for messages, which do not belong to a single vehicle (thread-safe)
+  ///
+  /// Messages of a vehicle go to the logger of its Handle.
+  ///
+  ///\param logger the logger (nullptr uses the process-wide logger)
+  ///
+  void setLogger(std::shared_ptr<vda5050pp::interface_agv::Logger> logger) noexcept(true);
+
+  ///
+  ///\brief Create a Connector for a vehicle, which communicates over this gateway
+  ///
+  /// The gateway has to outlive the returned connector.
+  ///
+  ///\param desc the agv description (for manufacturer and serial_number)
+  ///\return std::shared_ptr<vda5050pp::interface_mc::Connector> the connector
+  ///\throws std::invalid_argument if a connector for the vehicle already exists
+  ///
+  std::shared_ptr<vda5050pp::interface_mc::Connector> makeConnector(
+      const vda5050pp::interface_agv::agv_description::AGVDescription &desc) noexcept(false);
+
+  ///
+  ///\brief Get a snapshot of the statistics of all vehicles
+  ///
+  ///\return std::map<std::string, VehicleStatistics> "<manufacturer>/<serial_number>" -> stats
+  ///
+  std::map<std::string, VehicleStatistics> getStatistics() const noexcept(true);
+
+  /**
+   * This method is invoked when the connect action fails.
+   * @param asyncActionToken
+   */
+  void on_failure(const mqtt::token &asyncActionToken) override;
+  /**
+   * This method is invoked when the connect action has completed successfully.
+   * @param asyncActionToken
+   */
+  void on_success(const mqtt::token &asyncActionToken) override;
+
+  /**
+   * This method is called when the client is (re-)connected.
+   */
+  void connected(const std::string & /*cause*/) override;
+  /**
+   * This method is called when the connection to the server is lost.
+   */
+  void connection_lost(const std::string & /*cause*/) override;
+  /**
+   * This method is called when a message arrives from the server.
+   */
+  void message_arrived(mqtt::const_message_ptr /*msg*/) override;
+};
+
+}  // namespace vda5050pp::extra
+
+#endif /* EXTRA_MQTT_CONNECTOR_INCLUDE_VDA5050_2B_2B_EXTRA_MQTT_GATEWAY */
@@ -8,8 +8,12 @@
 
 #include "vda5050++/extra/mqtt_connector.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
 #include <sstream>
-#include <thread>
+#include <stdexcept>
 
 #include "vda5050++/core/common/formatting.h"
 #include "vda5050++/core/version.h"
@@ -20,55 +24,103 @@ using namespace vda5050pp::extra;
 using namespace std::chrono_literals;
 using namespace vda5050pp::core::common;
 
-MqttConnector::MqttConnector(const vda5050pp::interface_agv::agv_description::AGVDescription &desc,
-                             const MqttOptions &opts)
-    : mqtt_client_(opts.server, desc.agv_id) {
-  this->mqtt_client_.set_callback(*this);
-  this->connect_opts_.set_mqtt_version(4);
-  this->connect_opts_.set_clean_session(false);
-  this->connect_opts_.set_user_name(opts.username.value_or(""));
-  this->connect_opts_.set_password(opts.password.value_or(""));
+static std::string mkTopic(const MqttConnector::MqttOptions &opts,
+                           const vda5050pp::interface_agv::agv_description::AGVDescription &desc,
+                           std::string_view subtopic) {
+  std::stringstream topic;
+  topic << opts.interface << '/' << opts.version_overwrite.value_or("v1") << '/'
+        << desc.manufacturer << '/' << desc.serial_number << '/' << subtopic;
+  return topic.str();
+}
+
+mqtt::connect_options MqttConnector::mkConnectOptions(
+    const MqttOptions &opts,
+    std::function<void(const std::string &)> ssl_error_handler) noexcept(false) {
+  mqtt::connect_options connect_opts;
+  connect_opts.set_mqtt_version(4);
+  connect_opts.set_clean_session(false);
+  connect_opts.set_user_name(opts.username.value_or(""));
+  connect_opts.set_password(opts.password.value_or(""));
+  connect_opts.set_keep_alive_interval(10);
   if (opts.use_ssl) {
     mqtt::ssl_options ssl;
     ssl.set_verify(opts.enable_cert_check);
-    mqtt::ssl_options::error_handler handler = [](const std::string &msg) {
-      vda5050pp::interface_agv::Logger::getCurrentLogger()->logError(
-          format("MqttConnector (ssl_error): {}", msg));
-    };
-    ssl.set_error_handler(handler);
+    ssl.set_error_handler(std::move(ssl_error_handler));
     ssl.set_enable_server_cert_auth(opts.enable_cert_check);
-    this->connect_opts_.set_ssl(ssl);
+    connect_opts.set_ssl(ssl);
   }
+  return connect_opts;
+}
 
-  auto mkTopic = [&opts, &desc](auto &subtopic) -> std::string {
-    std::stringstream topic;
-    topic << opts.interface << '/' << opts.version_overwrite.value_or("v1") << '/'
-          << desc.manufacturer << '/' << desc.serial_number << '/' << subtopic;
-    return topic.str();
-  };
+MqttConnector::MqttConnector(const vda5050pp::interface_agv::agv_description::AGVDescription &desc,
+                             const MqttOptions &opts)
+    : mqtt_client_(opts.server, desc.agv_id),
+      connection_topic_(mkTopic(opts, desc, "connection")),
+      instant_actions_topic_(mkTopic(opts, desc, "instantActions")),
+      order_topic_(mkTopic(opts, desc, "order")),
+      state_topic_(mkTopic(opts, desc, "state")),
+      visualization_topic_(mkTopic(opts, desc, "visualization")),
+      reconnect_min_delay_(std::max(std::chrono::milliseconds(1), opts.reconnect_min_delay)),
+      reconnect_max_delay_(std::max(reconnect_min_delay_, opts.reconnect_max_delay)),
+      window_(opts.max_in_flight, opts.max_queued, opts.overflow_policy, connection_topic_),
+      outbox_spill_file_(opts.outbox_spill_file),
+      connection_options_(opts.connection_topic),
+      state_options_(opts.state_topic),
+      visualization_options_(opts.visualization_topic),
+      delivery_listener_(*this) {
+  for (const auto &topic_options : {opts.order_topic, opts.instant_actions_topic,
+                                    opts.connection_topic, opts.state_topic,
+                                    opts.visualization_topic}) {
+    if (topic_options.qos < 0 || topic_options.qos > 2) {
+      throw std::invalid_argument(format("MqttConnector: invalid qos {}", topic_options.qos));
+    }
+  }
 
-  this->order_topic_ = mkTopic("order");
-  this->connection_topic_ = mkTopic("connection");
-  this->visualization_topic_ = mkTopic("visualization");
-  this->instant_actions_topic_ = mkTopic("instantActions");
-  this->state_topic_ = mkTopic("state");
+  this->mqtt_client_.set_callback(*this);
+  this->connect_opts_ = mkConnectOptions(opts, [this](const std::string &msg) {
+    this->getLogger()->logError(format("MqttConnector (ssl_error): {}", msg));
+  });
+
+  // further subscriptions (i.e. connection or factsheet) only need a handler here
+  this->addTopicHandler(this->order_topic_, opts.order_topic.qos,
+                        [](auto &consumer, std::string_view payload) {
+                          consumer.receivedOrder(json::parse(payload.begin(), payload.end())
+                                                     .get<vda5050pp::Order>());
+                        });
+  this->addTopicHandler(this->instant_actions_topic_, opts.instant_actions_topic.qos,
+                        [](auto &consumer, std::string_view payload) {
+                          consumer.receivedInstantActions(
+                              json::parse(payload.begin(), payload.end())
+                                  .get<vda5050pp::InstantActions>());
+                        });
 
   this->header_template_.manufacturer = desc.manufacturer;
   this->header_template_.serialNumber = desc.serial_number;
   this->header_template_.version = vda5050pp::core::version::current;
 
+  this->restoreOutbox();
+
   this->shutdown_ = false;
+  this->reconnect_thread_ = std::make_unique<std::thread>([this] { this->reconnectRoutine(); });
 }
 
 MqttConnector::~MqttConnector() {
-  this->shutdown_ = true;
+  {
+    std::unique_lock lock(this->reconnect_mutex_);
+    this->shutdown_ = true;
+  }
+  this->reconnect_timer_.disable();
+  this->reconnect_cv_.notify_all();
+  this->reconnect_thread_->join();
+  this->reconnect_thread_.reset();
+
   if (this->mqtt_client_.is_connected()) {
     this->disconnect();
   }
 }
 
 void MqttConnector::on_failure(const mqtt::token &) {
-  auto logger = vda5050pp::interface_agv::Logger::getCurrentLogger();
+  auto logger = this->getLogger();
   logger->logInfo("MQTT: Failure");
   this->reconnect();
 }
@@ -77,9 +129,18 @@ void MqttConnector::on_success(const mqtt::token &) {
   // reconnected
 }
 
+void MqttConnector::DeliveryListener::on_failure(const mqtt::token &tok) {
+  this->connector_.deliveryCompleted(tok, false);
+}
+
+void MqttConnector::DeliveryListener::on_success(const mqtt::token &tok) {
+  this->connector_.deliveryCompleted(tok, true);
+}
+
 void MqttConnector::connected(const std::string &) {
-  this->mqtt_client_.subscribe(this->order_topic_, this->k_qos);
-  this->mqtt_client_.subscribe(this->instant_actions_topic_, this->k_qos);
+  for (const auto &[topic, subscription] : this->topic_handlers_) {
+    this->mqtt_client_.subscribe(std::string(topic), subscription.qos);
+  }
 
   vda5050pp::Connection online_msg;
   online_msg.header = this->header_template_;
@@ -87,19 +148,31 @@ void MqttConnector::connected(const std::string &) {
   online_msg.header.timestamp = std::chrono::system_clock::now();
   online_msg.connectionState = vda5050pp::ConnectionState::ONLINE;
 
+  // messages buffered while offline precede the online message
+  this->flushOutbox();
   this->queueConnection(online_msg);
+  this->pump();
 
-  vda5050pp::interface_agv::Logger::getCurrentLogger()->logInfo("MqttConnector: connected");
+  this->getLogger()->logInfo("MqttConnector: connected");
 }
 
 void MqttConnector::connection_lost(const std::string &cause) {
   using namespace std::chrono_literals;
 
-  auto logger = vda5050pp::interface_agv::Logger::getCurrentLogger();
+  auto logger = this->getLogger();
   logger->logDebug(format("MQTT: connection lost ({})", cause));
+
+  // QoS 0 messages in-flight are lost with the connection
+  this->window_.goOffline(true);
+
   this->reconnect();
 }
 
+void MqttConnector::addTopicHandler(const std::string &topic, int qos,
+                                    TopicHandlerT &&handler) noexcept(true) {
+  this->topic_handlers_[topic] = {qos, std::move(handler)};
+}
+
 void MqttConnector::message_arrived(mqtt::const_message_ptr msg) {
   auto consumer = this->consumer_.lock();
 
@@ -107,42 +180,94 @@ void MqttConnector::message_arrived(mqtt::const_message_ptr msg) {
     return;
   }
 
-  auto logger = vda5050pp::interface_agv::Logger::getCurrentLogger();
+  auto logger = this->getLogger();
+
+  // view topic and payload without copying them out of the message
+  const auto &topic_ref = msg->get_topic_ref();
+  std::string_view topic(topic_ref.data(), topic_ref.size());
+  const auto &payload_ref = msg->get_payload_ref();
+  std::string_view payload(payload_ref.data(), payload_ref.size());
+
+  auto handler = this->topic_handlers_.find(topic);
+  if (handler == this->topic_handlers_.end()) {
+    logger->logWarn(format("Received MQTT message on unknown topic \"{}\"", topic));
+    return;
+  }
 
   try {
-    auto j = json::parse(msg->get_payload());
-    if (msg->get_topic() == this->order_topic_) {
-      consumer->receivedOrder(j);
-    } else if (msg->get_topic() == this->instant_actions_topic_) {
-      consumer->receivedInstantActions(j);
-    } else {
-      logger->logWarn(format("Received MQTT message on unknown topic \"{}\"", msg->get_topic()));
-    }
+    handler->second.handler(*consumer, payload);
   } catch (const json::exception &e) {
     logger->logError(
-        format("MQTT deserialization exception: {} on topic \"{}\"", e.what(), msg->get_topic()));
+        format("MQTT deserialization exception: {} on topic \"{}\"", e.what(), topic));
   }
 
-  logger->logDebug(format("MQTT received @{}", msg->get_topic()));
+  logger->logDebug(format("MQTT received @{}", topic));
 }
 
 void MqttConnector::delivery_complete(mqtt::delivery_token_ptr tok) {
-  this->pending_deliveries_.erase(tok);
-  auto logger = vda5050pp::interface_agv::Logger::getCurrentLogger();
+  auto logger = this->getLogger();
   logger->logDebug(format("MQTT: delivered message id={}", tok->get_message_id()));
 }
 
-void MqttConnector::reconnect() {
-  using namespace std::chrono_literals;
+void MqttConnector::reconnect() noexcept(true) {
+  {
+    std::unique_lock lock(this->reconnect_mutex_);
+    this->reconnect_requested_ = true;
+  }
+  this->reconnect_cv_.notify_one();
+}
 
-  auto logger = vda5050pp::interface_agv::Logger::getCurrentLogger();
-  logger->logInfo("MQTT: reconnecting in 2s...");
-  std::this_thread::sleep_for(2s);
+void MqttConnector::reconnectRoutine() noexcept(true) {
+  std::mt19937 rng(std::random_device{}());
 
-  try {
-    this->mqtt_client_.reconnect();
-  } catch (const mqtt::exception &e) {
-    logger->logWarn(format("MQTT: reconnect() exception: {}", e.what()));
+  while (!this->shutdown_) {
+    {
+      std::unique_lock lock(this->reconnect_mutex_);
+      this->reconnect_cv_.wait(
+          lock, [this] { return this->reconnect_requested_ || this->shutdown_; });
+      this->reconnect_requested_ = false;
+    }
+
+    auto requested_at = std::chrono::steady_clock::now();
+    auto delay = this->reconnect_min_delay_;
+
+    while (!this->shutdown_ && !this->mqtt_client_.is_connected()) {
+      // "equal jitter": sleep somewhere in [delay/2, delay]
+      std::uniform_int_distribution<std::chrono::milliseconds::rep> jitter(delay.count() / 2,
+                                                                          delay.count());
+      std::chrono::milliseconds sleep(jitter(rng));
+
+      auto logger = this->getLogger();
+      logger->logInfo(format("MQTT: reconnecting in {}ms...", sleep.count()));
+
+      if (this->reconnect_timer_.sleepFor(sleep) !=
+          vda5050pp::core::common::InterruptableTimerStatus::k_ok) {
+        break;
+      }
+
+      {
+        std::unique_lock lock(this->reconnect_statistics_mutex_);
+        this->reconnect_attempts_++;
+      }
+
+      try {
+        auto tok = this->mqtt_client_.reconnect();
+        if (tok != nullptr) {
+          tok->wait_for(delay + std::chrono::seconds(5));
+        }
+      } catch (const mqtt::exception &e) {
+        logger->logWarn(format("MQTT: reconnect() exception: {}", e.what()));
+      }
+
+      if (this->mqtt_client_.is_connected()) {
+        std::unique_lock lock(this->reconnect_statistics_mutex_);
+        this->reconnects_++;
+        this->reconnect_duration_.record(std::chrono::steady_clock::now() - requested_at);
+        break;
+      }
+
+      delay = std::min(delay * 2, this->reconnect_max_delay_);
+    }
   }
 }
 
@@ -151,67 +276,180 @@ void MqttConnector::setConsumer(
   this->consumer_ = consumer;
 }
 
-void MqttConnector::queueConnection(const vda5050pp::Connection &connection) noexcept(false) {
-  if (!this->mqtt_client_.is_connected()) {
-    throw NotConnectedError();
+void MqttConnector::setLogger(
+    std::shared_ptr<vda5050pp::interface_agv::Logger> logger) noexcept(true) {
+  std::atomic_store(&this->logger_, std::move(logger));
+}
+
+std::shared_ptr<vda5050pp::interface_agv::Logger> MqttConnector::getLogger() const
+    noexcept(true) {
+  auto logger = std::atomic_load(&this->logger_);
+  if (logger == nullptr) {
+    return vda5050pp::interface_agv::Logger::getCurrentLogger();
   }
+  return logger;
+}
 
+mqtt::message_ptr MqttConnector::mkMessage(const std::string &topic, std::string &&payload,
+                                           const TopicOptions &options) const noexcept(true) {
   auto msg = std::make_shared<mqtt::message>();
-  msg->set_qos(this->k_qos);
-  msg->set_topic(this->connection_topic_);
-  msg->set_retained(true);
+  msg->set_qos(options.qos);
+  msg->set_topic(topic);
+  msg->set_retained(options.retained);
+  msg->set_payload(std::move(payload));
+  return msg;
+}
 
-  json j = connection;
-  msg->set_payload(j.dump());
+void MqttConnector::publishReserved(MqttDeliveryWindow::Reserved &&reserved) noexcept(false) {
+  try {
+    auto tok = this->mqtt_client_.publish(reserved.msg, reinterpret_cast<void *>(reserved.id),
+                                          this->delivery_listener_);
+    auto logger = this->getLogger();
+    logger->logDebug(format("MQTT: queued message id={} on topic {}",
+                            tok ? tok->get_message_id() : 0, reserved.msg->get_topic()));
+  } catch (...) {
+    this->window_.abort(reserved.id);
+    throw;
+  }
+}
 
-  auto tok = this->mqtt_client_.publish(msg);
-  this->pending_deliveries_[tok] = msg;
-  auto logger = vda5050pp::interface_agv::Logger::getCurrentLogger();
-  logger->logDebug(
-      format("MQTT: queued message id={} on topic {}", tok->get_message_id(), msg->get_topic()));
+void MqttConnector::enqueue(mqtt::message_ptr msg) noexcept(false) {
+  // only connection messages are spilled, so high-rate states do not cause any file I/O
+  bool is_connection = msg->get_topic() == this->connection_topic_;
+
+  if (auto reserved = this->window_.admit(std::move(msg)); reserved.has_value()) {
+    // do not hold any lock while publishing, completions may be reported synchronously
+    this->publishReserved(std::move(*reserved));
+  } else if (this->window_.isOnline()) {
+    this->pump();  // keep the order, if a slot was freed in the meantime
+  } else if (is_connection) {
+    this->spillOutbox();
+  }
 }
 
-void MqttConnector::queueState(const vda5050pp::State &state) noexcept(false) {
-  if (!this->mqtt_client_.is_connected()) {
-    throw NotConnectedError();
+void MqttConnector::flushOutbox() noexcept(true) {
+  this->window_.goOnline();
+
+  if (this->outbox_spill_file_.has_value()) {
+    std::unique_lock lock(this->spill_mutex_);
+    std::remove(this->outbox_spill_file_->c_str());
   }
+}
 
-  auto msg = std::make_shared<mqtt::message>();
-  msg->set_qos(this->k_qos);
-  msg->set_topic(this->state_topic_);
+void MqttConnector::spillOutbox() noexcept(true) {
+  if (!this->outbox_spill_file_.has_value()) {
+    return;
+  }
 
-  json j = state;
-  msg->set_payload(j.dump());
+  std::unique_lock spill_lock(this->spill_mutex_);
 
-  auto tok = this->mqtt_client_.publish(msg);
-  this->pending_deliveries_[tok] = msg;
-  auto logger = vda5050pp::interface_agv::Logger::getCurrentLogger();
-  logger->logDebug(
-      format("MQTT: queued message id={} on topic {}", tok->get_message_id(), msg->get_topic()));
+  if (this->window_.isOnline()) {
+    return;  // flushed in the meantime
+  }
+
+  json spill = json::array();
+  for (const auto &msg : this->window_.getOutbox()) {
+    if (msg->get_topic() != this->connection_topic_) {
+      continue;  // states and visualizations are stale after a restart
+    }
+    // qos and retained flag are taken from the configuration on restore
+    spill.push_back({{"topic", msg->get_topic()}, {"payload", msg->get_payload_str()}});
+  }
+
+  // write to a temporary file first, such that the spill file is never partially written
+  auto tmp_file = *this->outbox_spill_file_ + ".tmp";
+  {
+    std::ofstream out(tmp_file, std::ios::trunc);
+    out << spill.dump();
+    if (!out.good()) {
+      this->getLogger()->logWarn(format("MQTT: could not write outbox spill file {}", tmp_file));
+      return;
+    }
+  }
+  std::rename(tmp_file.c_str(), this->outbox_spill_file_->c_str());
 }
 
-void MqttConnector::queueVisualization(const vda5050pp::Visualization &visualization) noexcept(
-    false) {
-  if (!this->mqtt_client_.is_connected()) {
-    throw NotConnectedError();
+void MqttConnector::restoreOutbox() noexcept(true) {
+  if (!this->outbox_spill_file_.has_value()) {
+    return;
   }
 
-  auto msg = std::make_shared<mqtt::message>();
-  msg->set_qos(this->k_qos);
-  msg->set_topic(this->visualization_topic_);
+  std::ifstream in(*this->outbox_spill_file_);
+  if (!in.good()) {
+    return;
+  }
 
-  json j = visualization;
-  msg->set_payload(j.dump());
+  auto logger = this->getLogger();
 
-  auto tok = this->mqtt_client_.publish(msg);
-  this->pending_deliveries_[tok] = msg;
-  auto logger = vda5050pp::interface_agv::Logger::getCurrentLogger();
-  logger->logDebug(
-      format("MQTT: queued message id={} on topic {}", tok->get_message_id(), msg->get_topic()));
+  try {
+    json spill = json::parse(in);
+    for (const auto &entry : spill) {
+      auto topic = entry.at("topic").get<std::string>();
+      if (topic == this->connection_topic_) {
+        // the current configuration wins over the options the message was spilled with
+        this->window_.restore(this->mkMessage(
+            topic, entry.at("payload").get<std::string>(), this->connection_options_));
+      } else if (topic == this->state_topic_ || topic == this->visualization_topic_) {
+        // the new session publishes its own state, the old one must not be sent again
+        logger->logDebug(format("MQTT: dropping stale spilled message on topic {}", topic));
+      } else {
+        logger->logWarn(format("MQTT: ignoring spilled message on foreign topic {}", topic));
+      }
+    }
+  } catch (const std::exception &e) {
+    logger->logError(format("MQTT: could not restore outbox spill file: {}", e.what()));
+  }
+}
+
+void MqttConnector::pump() noexcept(true) {
+  for (auto &r : this->window_.pump()) {
+    try {
+      this->publishReserved(std::move(r));
+    } catch (const mqtt::exception &e) {
+      this->getLogger()->logWarn(format("MQTT: publish() of queued message failed: {}", e.what()));
+    }
+  }
+}
+
+void MqttConnector::deliveryCompleted(const mqtt::token &tok, bool success) noexcept(true) {
+  this->window_.complete(reinterpret_cast<uint64_t>(tok.get_user_context()), success);
+
+  if (!success) {
+    this->getLogger()->logWarn(
+        format("MQTT: failed to deliver message id={}", tok.get_message_id()));
+  }
+
+  this->pump();
+}
+
+MqttConnector::Statistics MqttConnector::getStatistics() const noexcept(true) {
+  Statistics statistics;
+  static_cast<MqttDeliveryWindow::Statistics &>(statistics) = this->window_.getStatistics();
+
+  std::unique_lock lock(this->reconnect_statistics_mutex_);
+  statistics.reconnect_attempts = this->reconnect_attempts_;
+  statistics.reconnects = this->reconnects_;
+  statistics.reconnect_duration = this->reconnect_duration_;
+  return statistics;
+}
+
+void MqttConnector::queueConnection(const vda5050pp::Connection &connection) noexcept(false) {
+  this->enqueue(this->mkMessage(this->connection_topic_, json(connection).dump(),
+                                this->connection_options_));
+}
+
+void MqttConnector::queueState(const vda5050pp::State &state) noexcept(false) {
+  this->enqueue(this->mkMessage(this->state_topic_, json(state).dump(), this->state_options_));
+}
+
+void MqttConnector::queueVisualization(const vda5050pp::Visualization &visualization) noexcept(
+    false) {
+  this->enqueue(this->mkMessage(this->visualization_topic_, json(visualization).dump(),
+                                this->visualization_options_));
 }
 
 void MqttConnector::connect() noexcept(false) {
-  auto logger = vda5050pp::interface_agv::Logger::getCurrentLogger();
+  auto logger = this->getLogger();
 
   vda5050pp::Connection will_msg;
   will_msg.header = this->header_template_;
@@ -221,12 +459,11 @@ void MqttConnector::connect() noexcept(false) {
 
   mqtt::will_options will;
   will.set_topic(this->connection_topic_);
-  will.set_retained(true);
-  will.set_qos(this->k_qos);
+  will.set_retained(this->connection_options_.retained);
+  will.set_qos(this->connection_options_.qos);
   will.set_payload(json(will_msg).dump());
 
   this->connect_opts_.set_will(std::move(will));
-  this->connect_opts_.set_keep_alive_interval(10);
 
   try {
     auto tok = this->mqtt_client_.connect(this->connect_opts_, nullptr, *this);
@@ -254,13 +491,10 @@ void MqttConnector::disconnect() noexcept(false) {
   offline_msg.header.headerId = this->header_id_counter_++;
   offline_msg.connectionState = vda5050pp::ConnectionState::OFFLINE;
 
-  auto msg = std::make_shared<mqtt::message>();
-  msg->set_qos(this->k_qos);
-  msg->set_topic(this->connection_topic_);
-  msg->set_retained(true);
+  this->window_.goOffline(false);
 
-  json j = offline_msg;
-  msg->set_payload(j.dump());
+  auto msg = this->mkMessage(this->connection_topic_, json(offline_msg).dump(),
+                             this->connection_options_);
 
   auto tok = this->mqtt_client_.publish(msg);
   tok->wait_for(5s);
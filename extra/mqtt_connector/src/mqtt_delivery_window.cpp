@@ -0,0 +1,196 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+//
+
+#include "vda5050++/extra/mqtt_delivery_window.h"
+
+#include <algorithm>
+
+using namespace vda5050pp::extra;
+
+MqttDeliveryWindow::MqttDeliveryWindow(uint32_t max_in_flight, uint32_t max_queued,
+                                       OverflowPolicy overflow_policy,
+                                       std::string connection_topic) noexcept(true)
+    : max_in_flight_(std::max<uint32_t>(1, max_in_flight)),
+      max_queued_(max_queued),
+      overflow_policy_(overflow_policy),
+      connection_topic_(std::move(connection_topic)) {}
+
+void MqttDeliveryWindow::countFailed(const mqtt::message_ptr &msg) noexcept(true) {
+  this->statistics_.failed++;
+  this->statistics_.per_qos.at(msg->get_qos()).failed++;
+}
+
+uint64_t MqttDeliveryWindow::reserveInFlight(const mqtt::message_ptr &msg) noexcept(true) {
+  auto id = this->next_delivery_id_++;
+  this->in_flight_[id] = {msg, std::chrono::steady_clock::now()};
+  this->statistics_.in_flight_max =
+      std::max(this->statistics_.in_flight_max, this->in_flight_.size());
+  this->statistics_.in_flight_depth.record(this->in_flight_.size());
+  this->statistics_.published++;
+  this->statistics_.per_qos.at(msg->get_qos()).published++;
+  return id;
+}
+
+void MqttDeliveryWindow::backlogMessage(mqtt::message_ptr msg) noexcept(true) {
+  if (this->overflow_policy_ == OverflowPolicy::k_latest_wins &&
+      msg->get_topic() != this->connection_topic_) {
+    auto same_topic = [&msg](const mqtt::message_ptr &queued) {
+      return queued->get_topic() == msg->get_topic();
+    };
+    if (auto it = std::find_if(this->backlog_.begin(), this->backlog_.end(), same_topic);
+        it != this->backlog_.end()) {
+      *it = std::move(msg);
+      this->statistics_.replaced++;
+      return;
+    }
+  }
+
+  if (this->backlog_.size() >= this->max_queued_) {
+    this->statistics_.dropped++;
+    if (this->overflow_policy_ == OverflowPolicy::k_drop_newest || this->backlog_.empty()) {
+      return;
+    }
+    this->backlog_.pop_front();
+  }
+  this->backlog_.push_back(std::move(msg));
+}
+
+void MqttDeliveryWindow::outboxMessage(mqtt::message_ptr msg) noexcept(true) {
+  this->statistics_.outboxed++;
+
+  if (msg->get_topic() == this->connection_topic_) {
+    if (this->outbox_.connection.size() >= std::max<uint32_t>(1, this->max_queued_)) {
+      this->outbox_.connection.pop_front();
+      this->statistics_.dropped++;
+    }
+    this->outbox_.connection.push_back(std::move(msg));
+    return;
+  }
+
+  auto same_topic = [&msg](const mqtt::message_ptr &outboxed) {
+    return outboxed->get_topic() == msg->get_topic();
+  };
+  if (auto it = std::find_if(this->outbox_.latest.begin(), this->outbox_.latest.end(), same_topic);
+      it != this->outbox_.latest.end()) {
+    *it = std::move(msg);
+    this->statistics_.compacted++;
+  } else {
+    this->outbox_.latest.push_back(std::move(msg));
+  }
+}
+
+std::optional<MqttDeliveryWindow::Reserved> MqttDeliveryWindow::admit(
+    mqtt::message_ptr msg) noexcept(true) {
+  std::unique_lock lock(this->mutex_);
+  if (!this->online_) {
+    this->outboxMessage(std::move(msg));
+    return std::nullopt;
+  }
+  if (this->in_flight_.size() >= this->max_in_flight_ || !this->backlog_.empty()) {
+    this->backlogMessage(std::move(msg));
+    return std::nullopt;
+  }
+  auto id = this->reserveInFlight(msg);
+  return Reserved{id, std::move(msg)};
+}
+
+std::vector<MqttDeliveryWindow::Reserved> MqttDeliveryWindow::pump() noexcept(false) {
+  std::vector<Reserved> reserved;
+  std::unique_lock lock(this->mutex_);
+  if (!this->online_) {
+    return reserved;
+  }
+  while (this->in_flight_.size() < this->max_in_flight_ && !this->backlog_.empty()) {
+    auto msg = std::move(this->backlog_.front());
+    this->backlog_.pop_front();
+    auto id = this->reserveInFlight(msg);
+    reserved.push_back({id, std::move(msg)});
+  }
+  return reserved;
+}
+
+void MqttDeliveryWindow::complete(uint64_t id, bool success) noexcept(true) {
+  std::unique_lock lock(this->mutex_);
+  auto it = this->in_flight_.find(id);
+  if (it == this->in_flight_.end()) {
+    return;  // already counted as failed, when the connection was lost
+  }
+
+  if (success) {
+    auto latency = std::chrono::steady_clock::now() - it->second.published_at;
+    auto &qos_statistics = this->statistics_.per_qos.at(it->second.msg->get_qos());
+    this->statistics_.delivered++;
+    this->statistics_.delivery_latency.record(latency);
+    qos_statistics.delivered++;
+    qos_statistics.delivery_latency.record(latency);
+  } else {
+    this->countFailed(it->second.msg);
+  }
+  this->in_flight_.erase(it);
+}
+
+void MqttDeliveryWindow::abort(uint64_t id) noexcept(true) {
+  this->complete(id, false);
+}
+
+void MqttDeliveryWindow::goOnline() noexcept(true) {
+  std::unique_lock lock(this->mutex_);
+  for (auto &msg : this->outbox_.connection) {
+    this->backlogMessage(std::move(msg));
+  }
+  for (auto &msg : this->outbox_.latest) {
+    this->backlogMessage(std::move(msg));
+  }
+  this->outbox_ = Outbox();
+  this->online_ = true;
+}
+
+void MqttDeliveryWindow::goOffline(bool connection_lost) noexcept(true) {
+  std::unique_lock lock(this->mutex_);
+  this->online_ = false;
+  if (!connection_lost) {
+    return;
+  }
+
+  // QoS 0 messages in-flight are lost with the connection
+  for (auto it = this->in_flight_.begin(); it != this->in_flight_.end();) {
+    if (it->second.msg->get_qos() == 0) {
+      this->countFailed(it->second.msg);
+      it = this->in_flight_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+bool MqttDeliveryWindow::isOnline() const noexcept(true) {
+  std::unique_lock lock(this->mutex_);
+  return this->online_;
+}
+
+void MqttDeliveryWindow::restore(mqtt::message_ptr msg) noexcept(true) {
+  std::unique_lock lock(this->mutex_);
+  this->outboxMessage(std::move(msg));
+}
+
+std::vector<mqtt::message_ptr> MqttDeliveryWindow::getOutbox() const noexcept(false) {
+  std::unique_lock lock(this->mutex_);
+  std::vector<mqtt::message_ptr> outbox(this->outbox_.connection.begin(),
+                                        this->outbox_.connection.end());
+  outbox.insert(outbox.end(), this->outbox_.latest.begin(), this->outbox_.latest.end());
+  return outbox;
+}
+
+MqttDeliveryWindow::Statistics MqttDeliveryWindow::getStatistics() const noexcept(true) {
+  std::unique_lock lock(this->mutex_);
+  Statistics statistics = this->statistics_;
+  statistics.in_flight = this->in_flight_.size();
+  statistics.queued = this->backlog_.size();
+  statistics.outbox = this->outbox_.connection.size() + this->outbox_.latest.size();
+  return statistics;
+}
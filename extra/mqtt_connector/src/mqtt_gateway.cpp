@@ -0,0 +1,400 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+//
+
+#include "vda5050++/extra/mqtt_gateway.h"
+
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "vda5050++/core/common/formatting.h"
+#include "vda5050++/core/version.h"
+#include "vda5050++/extra/json_model.h"
+#include "vda5050++/interface_agv/logger.h"
+
+using namespace vda5050pp::extra;
+using namespace std::chrono_literals;
+using namespace vda5050pp::core::common;
+
+///
+///\brief The Connector handed out to a single vehicle, forwards everything to the gateway
+///
+class MqttGateway::VehicleConnector final : public vda5050pp::interface_mc::Connector {
+private:
+  MqttGateway &gateway_;
+  std::string key_;
+
+public:
+  VehicleConnector(MqttGateway &gateway, std::string key)
+      : gateway_(gateway), key_(std::move(key)) {}
+
+  ~VehicleConnector() override { this->gateway_.removeVehicle(this->key_); }
+
+  void setConsumer(std::weak_ptr<vda5050pp::interface_mc::MessageConsumer> consumer) noexcept(
+      true) override {
+    std::unique_lock lock(this->gateway_.vehicles_mutex_);
+    this->gateway_.vehicles_.at(this->key_).consumer = consumer;
+  }
+
+  void setLogger(std::shared_ptr<vda5050pp::interface_agv::Logger> logger) noexcept(
+      true) override {
+    std::unique_lock lock(this->gateway_.vehicles_mutex_);
+    this->gateway_.vehicles_.at(this->key_).logger = std::move(logger);
+  }
+
+  void queueConnection(const vda5050pp::Connection &connection) noexcept(false) override {
+    std::string topic;
+    {
+      std::unique_lock lock(this->gateway_.vehicles_mutex_);
+      topic = this->gateway_.vehicles_.at(this->key_).connection_topic;
+    }
+    this->gateway_.publish(this->key_, topic, json(connection).dump(),
+                           this->gateway_.connection_options_,
+                           &VehicleStatistics::connections_published);
+  }
+
+  void queueState(const vda5050pp::State &state) noexcept(false) override {
+    std::string topic;
+    {
+      std::unique_lock lock(this->gateway_.vehicles_mutex_);
+      topic = this->gateway_.vehicles_.at(this->key_).state_topic;
+    }
+    this->gateway_.publish(this->key_, topic, json(state).dump(), this->gateway_.state_options_,
+                           &VehicleStatistics::states_published);
+  }
+
+  void queueVisualization(const vda5050pp::Visualization &visualization) noexcept(
+      false) override {
+    std::string topic;
+    {
+      std::unique_lock lock(this->gateway_.vehicles_mutex_);
+      topic = this->gateway_.vehicles_.at(this->key_).visualization_topic;
+    }
+    this->gateway_.publish(this->key_, topic, json(visualization).dump(),
+                           this->gateway_.visualization_options_,
+                           &VehicleStatistics::visualizations_published);
+  }
+
+  void connect() noexcept(false) override {
+    this->gateway_.connectClient();
+    {
+      std::unique_lock lock(this->gateway_.vehicles_mutex_);
+      this->gateway_.vehicles_.at(this->key_).online = true;
+    }
+    this->gateway_.publishConnection(this->key_, vda5050pp::ConnectionState::ONLINE);
+  }
+
+  void disconnect() noexcept(false) override {
+    {
+      std::unique_lock lock(this->gateway_.vehicles_mutex_);
+      this->gateway_.vehicles_.at(this->key_).online = false;
+    }
+    this->gateway_.publishConnection(this->key_, vda5050pp::ConnectionState::OFFLINE);
+  }
+};
+
+MqttGateway::MqttGateway(const std::string &client_id, const MqttConnector::MqttOptions &opts)
+    : mqtt_client_(opts.server, client_id),
+      order_options_(opts.order_topic),
+      instant_actions_options_(opts.instant_actions_topic),
+      connection_options_(opts.connection_topic),
+      state_options_(opts.state_topic),
+      visualization_options_(opts.visualization_topic) {
+  this->mqtt_client_.set_callback(*this);
+  this->connect_opts_ = MqttConnector::mkConnectOptions(opts, [this](const std::string &msg) {
+    this->getLogger()->logError(format("MqttGateway (ssl_error): {}", msg));
+  });
+  this->connect_opts_.set_automatic_reconnect(
+      std::chrono::duration_cast<std::chrono::seconds>(opts.reconnect_min_delay) + 1s,
+      std::chrono::duration_cast<std::chrono::seconds>(opts.reconnect_max_delay) + 1s);
+
+  std::stringstream prefix;
+  prefix << opts.interface << '/' << opts.version_overwrite.value_or("v1") << '/';
+  this->topic_prefix_ = prefix.str();
+}
+
+MqttGateway::~MqttGateway() {
+  if (this->mqtt_client_.is_connected()) {
+    try {
+      this->mqtt_client_.disconnect()->wait_for(5s);
+    } catch (const mqtt::exception &e) {
+      this->getLogger()->logWarn(format("MqttGateway: disconnect() exception: {}", e.what()));
+    }
+  }
+}
+
+void MqttGateway::setLogger(std::shared_ptr<vda5050pp::interface_agv::Logger> logger) noexcept(
+    true) {
+  std::atomic_store(&this->logger_, std::move(logger));
+}
+
+std::shared_ptr<vda5050pp::interface_agv::Logger> MqttGateway::getLogger() const noexcept(true) {
+  auto logger = std::atomic_load(&this->logger_);
+  if (logger == nullptr) {
+    return vda5050pp::interface_agv::Logger::getCurrentLogger();
+  }
+  return logger;
+}
+
+std::shared_ptr<vda5050pp::interface_agv::Logger> MqttGateway::getLogger(
+    const std::string &key) const noexcept(true) {
+  {
+    std::unique_lock lock(this->vehicles_mutex_);
+    if (auto it = this->vehicles_.find(key);
+        it != this->vehicles_.end() && it->second.logger != nullptr) {
+      return it->second.logger;
+    }
+  }
+  return this->getLogger();
+}
+
+void MqttGateway::publish(const std::string &key, const std::string &topic,
+                          std::string &&payload, const MqttConnector::TopicOptions &options,
+                          uint64_t VehicleStatistics::*counter) noexcept(false) {
+  auto count = [this, &key](uint64_t VehicleStatistics::*counter) {
+    std::unique_lock lock(this->vehicles_mutex_);
+    if (auto it = this->vehicles_.find(key); it != this->vehicles_.end()) {
+      it->second.statistics.*counter += 1;
+      it->second.statistics.last_published = std::chrono::system_clock::now();
+    }
+  };
+
+  if (!this->mqtt_client_.is_connected()) {
+    count(&VehicleStatistics::publish_errors);
+    throw MqttConnector::NotConnectedError();
+  }
+
+  auto msg = std::make_shared<mqtt::message>();
+  msg->set_qos(options.qos);
+  msg->set_topic(topic);
+  msg->set_retained(options.retained);
+  msg->set_payload(std::move(payload));
+
+  try {
+    this->mqtt_client_.publish(msg);
+  } catch (const mqtt::exception &) {
+    count(&VehicleStatistics::publish_errors);
+    throw;
+  }
+  count(counter);
+}
+
+void MqttGateway::publishConnection(const std::string &key,
+                                    vda5050pp::ConnectionState state) noexcept(false) {
+  vda5050pp::Connection msg;
+  std::string topic;
+  {
+    std::unique_lock lock(this->vehicles_mutex_);
+    auto &vehicle = this->vehicles_.at(key);
+    msg.header = vehicle.header_template;
+    msg.header.headerId = vehicle.header_id_counter++;
+    topic = vehicle.connection_topic;
+  }
+  msg.header.timestamp = std::chrono::system_clock::now();
+  msg.connectionState = state;
+
+  this->publish(key, topic, json(msg).dump(), this->connection_options_,
+                &VehicleStatistics::connections_published);
+}
+
+void MqttGateway::connectClient() noexcept(false) {
+  // vehicles may connect concurrently, only the first one connects the shared client
+  std::unique_lock lock(this->connect_mutex_);
+  if (this->mqtt_client_.is_connected()) {
+    return;
+  }
+
+  auto logger = this->getLogger();
+
+  try {
+    auto tok = this->mqtt_client_.connect(this->connect_opts_, nullptr, *this);
+    if (tok == nullptr) {
+      logger->logInfo("MqttGateway: connect() no token returned");
+      return;
+    }
+
+    if (!tok->wait_for(15000)) {
+      logger->logInfo("MqttGateway: connect() timed out");
+    }
+  } catch (const mqtt::exception &e) {
+    logger->logError(format("MqttGateway: connect() exception: {}", e.what()));
+  }
+}
+
+void MqttGateway::subscribe(const Vehicle &vehicle) noexcept(false) {
+  this->mqtt_client_.subscribe(vehicle.order_topic, this->order_options_.qos);
+  this->mqtt_client_.subscribe(vehicle.instant_actions_topic,
+                               this->instant_actions_options_.qos);
+}
+
+void MqttGateway::removeVehicle(const std::string &key) noexcept(true) {
+  std::optional<Vehicle> vehicle;
+  {
+    std::unique_lock lock(this->vehicles_mutex_);
+    if (auto it = this->vehicles_.find(key); it != this->vehicles_.end()) {
+      vehicle = std::move(it->second);
+      this->vehicles_.erase(it);
+    }
+  }
+
+  if (vehicle.has_value() && this->mqtt_client_.is_connected()) {
+    try {
+      this->mqtt_client_.unsubscribe(vehicle->order_topic);
+      this->mqtt_client_.unsubscribe(vehicle->instant_actions_topic);
+    } catch (const mqtt::exception &e) {
+      auto logger = vehicle->logger != nullptr ? vehicle->logger : this->getLogger();
+      logger->logWarn(format("MqttGateway: unsubscribe() exception: {}", e.what()));
+    }
+  }
+}
+
+std::shared_ptr<vda5050pp::interface_mc::Connector> MqttGateway::makeConnector(
+    const vda5050pp::interface_agv::agv_description::AGVDescription &desc) noexcept(false) {
+  auto key = desc.manufacturer + '/' + desc.serial_number;
+
+  Vehicle vehicle;
+  vehicle.order_topic = this->topic_prefix_ + key + "/order";
+  vehicle.instant_actions_topic = this->topic_prefix_ + key + "/instantActions";
+  vehicle.connection_topic = this->topic_prefix_ + key + "/connection";
+  vehicle.state_topic = this->topic_prefix_ + key + "/state";
+  vehicle.visualization_topic = this->topic_prefix_ + key + "/visualization";
+  vehicle.header_template.manufacturer = desc.manufacturer;
+  vehicle.header_template.serialNumber = desc.serial_number;
+  vehicle.header_template.version = vda5050pp::core::version::current;
+
+  {
+    std::unique_lock lock(this->vehicles_mutex_);
+    if (!this->vehicles_.try_emplace(key, vehicle).second) {
+      throw std::invalid_argument(format("MqttGateway: vehicle {} already exists", key));
+    }
+  }
+
+  auto connector = std::make_shared<VehicleConnector>(*this, key);
+
+  // only the topics of hosted vehicles are subscribed (otherwise on the next connect)
+  if (this->mqtt_client_.is_connected()) {
+    this->subscribe(vehicle);
+  }
+
+  return connector;
+}
+
+std::map<std::string, MqttGateway::VehicleStatistics> MqttGateway::getStatistics() const
+    noexcept(true) {
+  std::map<std::string, VehicleStatistics> statistics;
+  std::unique_lock lock(this->vehicles_mutex_);
+  for (const auto &[key, vehicle] : this->vehicles_) {
+    statistics[key] = vehicle.statistics;
+  }
+  return statistics;
+}
+
+void MqttGateway::on_failure(const mqtt::token &) {
+  this->getLogger()->logInfo("MqttGateway: connect failed");
+}
+
+void MqttGateway::on_success(const mqtt::token &) {
+  // connected
+}
+
+void MqttGateway::connected(const std::string &) {
+  std::vector<Vehicle> vehicles;
+  std::vector<std::string> online;
+  {
+    std::unique_lock lock(this->vehicles_mutex_);
+    for (const auto &[key, vehicle] : this->vehicles_) {
+      vehicles.push_back(vehicle);
+      if (vehicle.online) {
+        online.push_back(key);
+      }
+    }
+  }
+
+  for (const auto &vehicle : vehicles) {
+    this->subscribe(vehicle);
+  }
+
+  // after a reconnect, the vehicles are online again
+  for (const auto &key : online) {
+    try {
+      this->publishConnection(key, vda5050pp::ConnectionState::ONLINE);
+    } catch (const std::exception &e) {
+      this->getLogger(key)->logWarn(
+          format("MqttGateway: could not send ONLINE for {}: {}", key, e.what()));
+    }
+  }
+
+  this->getLogger()->logInfo("MqttGateway: connected");
+}
+
+void MqttGateway::connection_lost(const std::string &cause) {
+  // the client reconnects automatically
+  this->getLogger()->logDebug(format("MqttGateway: connection lost ({})", cause));
+}
+
+void MqttGateway::message_arrived(mqtt::const_message_ptr msg) {
+  auto logger = this->getLogger();
+
+  // <prefix><manufacturer>/<serial_number>/<subtopic>
+  const auto &topic_ref = msg->get_topic_ref();
+  std::string_view topic(topic_ref.data(), topic_ref.size());
+  auto subtopic_begin = topic.find_last_of('/');
+  if (topic.substr(0, this->topic_prefix_.size()) != this->topic_prefix_ ||
+      subtopic_begin == std::string_view::npos || subtopic_begin < this->topic_prefix_.size()) {
+    logger->logWarn(format("MqttGateway: received message on unknown topic \"{}\"", topic));
+    return;
+  }
+  std::string key(topic.substr(this->topic_prefix_.size(),
+                               subtopic_begin - this->topic_prefix_.size()));
+  auto subtopic = topic.substr(subtopic_begin + 1);
+
+  bool is_order = subtopic == "order";
+  if (!is_order && subtopic != "instantActions") {
+    logger->logWarn(format("MqttGateway: received message on unknown topic \"{}\"", topic));
+    return;
+  }
+
+  std::shared_ptr<vda5050pp::interface_mc::MessageConsumer> consumer;
+  {
+    std::unique_lock lock(this->vehicles_mutex_);
+    auto it = this->vehicles_.find(key);
+    if (it == this->vehicles_.end()) {
+      return;  // not hosted by this gateway
+    }
+    consumer = it->second.consumer.lock();
+    it->second.statistics.last_received = std::chrono::system_clock::now();
+    if (is_order) {
+      it->second.statistics.orders_received++;
+    } else {
+      it->second.statistics.instant_actions_received++;
+    }
+  }
+
+  if (consumer == nullptr) {
+    return;
+  }
+
+  const auto &payload_ref = msg->get_payload_ref();
+  std::string_view payload(payload_ref.data(), payload_ref.size());
+
+  try {
+    auto j = json::parse(payload.begin(), payload.end());
+    if (is_order) {
+      consumer->receivedOrder(j.get<vda5050pp::Order>());
+    } else {
+      consumer->receivedInstantActions(j.get<vda5050pp::InstantActions>());
+    }
+  } catch (const json::exception &e) {
+    this->getLogger(key)->logError(
+        format("MqttGateway: deserialization exception: {} on topic \"{}\"", e.what(), topic));
+    std::unique_lock lock(this->vehicles_mutex_);
+    if (auto it = this->vehicles_.find(key); it != this->vehicles_.end()) {
+      it->second.statistics.deserialization_errors++;
+    }
+  }
+}
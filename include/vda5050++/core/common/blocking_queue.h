@@ -11,53 +11,64 @@
 #define INCLUDE_VDA5050_2B_2B_CORE_COMMON_BLOCKING_QUEUE
 
 #include <chrono>
+#include <condition_variable>
 #include <deque>
 #include <mutex>
 #include <optional>
 #include <queue>
 
-#include "vda5050++/core/common/semaphore.h"
-
 namespace vda5050pp::core::common {
 
 ///
-///\brief Queue implementation used for synchronous access
+///\brief Multi-producer/multi-consumer queue used for synchronous access
+///
+/// All operations take a single lock. Elements are moved out of the queue, when popped.
 ///
 ///\tparam ValueT type of values to queue
 ///\tparam Container underlying containter to use (default std::deque)
 ///
 template <typename ValueT, typename Container = std::deque<ValueT>> class BlockingQueue {
+public:
+  using size_type = typename std::queue<ValueT, Container>::size_type;
+
 private:
   mutable std::mutex mutex_;
+  std::condition_variable not_empty_;
   std::queue<ValueT, Container> queue_;
-  Semaphore<typename std::queue<ValueT, Container>::size_type> semaphore_;
+
+  ValueT popLocked() noexcept(true) {
+    auto value = std::move(this->queue_.front());
+    this->queue_.pop();
+    return value;
+  }
 
 public:
   ///
   ///\brief Construct a new empty BlockingQueue
   ///
-  BlockingQueue() noexcept(true) : semaphore_(0) {}
+  BlockingQueue() noexcept(true) = default;
 
   ///
   ///\brief Copy construct BlockingQueue
   ///
-  /// Copy queue contents and size counter
+  /// Copy queue contents
   ///\param other BlockingQueue to copy from
   ///
   BlockingQueue(const BlockingQueue<ValueT, Container> &other) noexcept(true) {
     auto lock = std::unique_lock(other.mutex_);
-    semaphore_ = Semaphore(other.size());
     queue_ = other.queue_;
   }
 
   ///
   ///\brief Move construct BlockingQueue
   ///
-  /// Copy queue contents and size counter
+  /// Move queue contents
   ///\param other BlockingQueue to move from
   ///
-  BlockingQueue(BlockingQueue<ValueT, Container> &&other) noexcept(true)
-      : queue_(std::move(other.queue_)), semaphore_(other.semaphore_) {}
+  BlockingQueue(BlockingQueue<ValueT, Container> &&other) noexcept(true) {
+    auto lock = std::unique_lock(other.mutex_);
+    queue_ = std::move(other.queue_);
+  }
 
   ///
   ///\brief default destructor
@@ -67,27 +78,34 @@ public:
   ///
   ///\brief Copy assign BlockingQueue
   ///
-  /// Copy queue contents and size counter
+  /// Copy queue contents
   ///\param other
   ///\return BlockingQueue<ValueT, Container>&
   ///
   BlockingQueue<ValueT, Container> &operator=(
       const BlockingQueue<ValueT, Container> &other) noexcept(true) {
-    *this = BlockingQueue(other);
+    if (this != &other) {
+      std::scoped_lock lock(this->mutex_, other.mutex_);
+      this->queue_ = other.queue_;
+    }
+    this->not_empty_.notify_all();
     return *this;
   }
 
   ///
   ///\brief Move assign BlockingQueue
   ///
-  /// Move queue contents and size counter
+  /// Move queue contents
   ///\param other
   ///\return BlockingQueue<ValueT, Container>&
   ///
   BlockingQueue<ValueT, Container> &operator=(BlockingQueue<ValueT, Container> &&other) noexcept(
       true) {
-    this->queue_ = std::move(other.queue_);
-    this->semaphore_ = std::move(other.semaphore_);
+    if (this != &other) {
+      std::scoped_lock lock(this->mutex_, other.mutex_);
+      this->queue_ = std::move(other.queue_);
+    }
+    this->not_empty_.notify_all();
     return *this;
   }
 
@@ -96,13 +114,7 @@ public:
   ///
   ///\param value the element to add
   ///
-  void push(const ValueT &value) noexcept(false) {
-    {
-      auto lock = std::unique_lock(this->mutex_);
-      queue_.push(value);
-    }
-    semaphore_.release();
-  }
+  void push(const ValueT &value) noexcept(false) { this->push(ValueT(value)); }
 
   ///
   ///\brief Append element to the queue (thread safe)
@@ -112,9 +124,9 @@ public:
   void push(ValueT &&value) noexcept(false) {
     {
       auto lock = std::unique_lock(this->mutex_);
-      queue_.push(std::move(value));
+      this->queue_.push(std::move(value));
     }
-    semaphore_.release();
+    this->not_empty_.notify_one();
   }
 
   ///
@@ -124,11 +136,9 @@ public:
   ///\return ValueT the popped element
   ///
   ValueT pop() noexcept(true) {
-    semaphore_.acquire();
     auto lock = std::unique_lock(this->mutex_);
-    auto value = queue_.front();
-    queue_.pop();
-    return value;
+    this->not_empty_.wait(lock, [this] { return !this->queue_.empty(); });
+    return this->popLocked();
   }
 
   ///
@@ -137,14 +147,11 @@ public:
   ///\return std::optional<ValueT> value, if avaliable, otherwise std::nullopt
   ///
   std::optional<ValueT> try_pop() noexcept(true) {
-    if (semaphore_.try_acquire()) {
-      auto lock = std::unique_lock(this->mutex_);
-      auto value = queue_.front();
-      queue_.pop();
-      return {value};
-    } else {
+    auto lock = std::unique_lock(this->mutex_);
+    if (this->queue_.empty()) {
       return std::nullopt;
     }
+    return this->popLocked();
   }
 
   ///
@@ -159,14 +166,7 @@ public:
   template <typename Rep, typename Period>
   std::optional<ValueT> try_pop_for(const std::chrono::duration<Rep, Period> &rel_time) noexcept(
       true) {
-    if (semaphore_.try_acquire_for(rel_time)) {
-      auto lock = std::unique_lock(this->mutex_);
-      auto value = queue_.front();
-      queue_.pop();
-      return {value};
-    } else {
-      return std::nullopt;
-    }
+    return this->try_pop_until(std::chrono::steady_clock::now() + rel_time);
   }
 
   ///
@@ -181,14 +181,12 @@ public:
   template <typename Clock, typename Duration>
   std::optional<ValueT> try_pop_until(
       const std::chrono::time_point<Clock, Duration> &timeout_time) noexcept(true) {
-    if (semaphore_.try_acquire_until(timeout_time)) {
-      auto lock = std::unique_lock(this->mutex_);
-      auto value = queue_.front();
-      queue_.pop();
-      return {value};
-    } else {
+    auto lock = std::unique_lock(this->mutex_);
+    if (!this->not_empty_.wait_until(lock, timeout_time,
+                                     [this] { return !this->queue_.empty(); })) {
       return std::nullopt;
     }
+    return this->popLocked();
   }
 
   ///
@@ -196,14 +194,20 @@ public:
   ///
   ///\return ValueT first element
   ///
-  ValueT front() const noexcept(true) { return queue_.front(); }
+  ValueT front() const noexcept(true) {
+    auto lock = std::unique_lock(this->mutex_);
+    return queue_.front();
+  }
 
   ///
   ///\brief return last element of the queue
   ///
   ///\return ValueT last element
   ///
-  ValueT back() const noexcept(true) { return queue_.back(); }
+  ValueT back() const noexcept(true) {
+    auto lock = std::unique_lock(this->mutex_);
+    return queue_.back();
+  }
 
   ///
   ///\brief Check if the queue is empty
@@ -211,14 +215,18 @@ public:
   ///\return true queue empty
   ///\return false queue not empty
   ///
-  bool empty() const noexcept(true) { return queue_.empty(); }
+  bool empty() const noexcept(true) {
+    auto lock = std::unique_lock(this->mutex_);
+    return queue_.empty();
+  }
 
   ///
   ///\brief Return number of elements in the queue
   ///
-  ///\return std::queue<ValueT, Container>::size_type count
+  ///\return size_type count
   ///
-  typename std::queue<ValueT, Container>::size_type size() const noexcept(true) {
+  size_type size() const noexcept(true) {
+    auto lock = std::unique_lock(this->mutex_);
     return queue_.size();
   }
 };
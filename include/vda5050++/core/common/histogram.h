@@ -0,0 +1,172 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains a simple bucketed histogram
+//
+
+#ifndef INCLUDE_VDA5050_2B_2B_CORE_COMMON_HISTOGRAM
+#define INCLUDE_VDA5050_2B_2B_CORE_COMMON_HISTOGRAM
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace vda5050pp::core::common {
+
+///
+///\brief A histogram with fixed (upper inclusive) bucket bounds
+///
+/// Values greater than the last bound are counted in an additional overflow bucket.
+/// NOTE: This is not thread-safe, the owner has to synchronize access.
+///
+///\tparam ValueT the type of the recorded values (must be comparable and addable)
+///
+template <typename ValueT> class Histogram {
+private:
+  std::vector<ValueT> bounds_;
+  std::vector<uint64_t> counts_;
+  uint64_t count_ = 0;
+  ValueT sum_{};
+  std::optional<ValueT> min_;
+  std::optional<ValueT> max_;
+
+public:
+  ///
+  ///\brief Construct a new Histogram
+  ///
+  ///\param bounds the ascending upper bounds of the buckets
+  ///
+  explicit Histogram(std::vector<ValueT> bounds = {}) noexcept(true)
+      : bounds_(std::move(bounds)), counts_(bounds_.size() + 1, 0) {
+    std::sort(this->bounds_.begin(), this->bounds_.end());
+  }
+
+  ///
+  ///\brief Record a value
+  ///
+  ///\param value the value
+  ///
+  void record(const ValueT &value) noexcept(true) {
+    auto it = std::lower_bound(this->bounds_.begin(), this->bounds_.end(), value);
+    this->counts_[std::distance(this->bounds_.begin(), it)]++;
+    this->count_++;
+    this->sum_ += value;
+    this->min_ = this->min_.has_value() ? std::min(*this->min_, value) : value;
+    this->max_ = this->max_.has_value() ? std::max(*this->max_, value) : value;
+  }
+
+  ///
+  ///\brief Reset all counters (bounds are kept)
+  ///
+  void reset() noexcept(true) {
+    std::fill(this->counts_.begin(), this->counts_.end(), 0);
+    this->count_ = 0;
+    this->sum_ = ValueT{};
+    this->min_.reset();
+    this->max_.reset();
+  }
+
+  ///
+  ///\brief Get the upper bounds of the buckets
+  ///
+  ///\return const std::vector<ValueT>&
+  ///
+  const std::vector<ValueT> &bounds() const noexcept(true) { return this->bounds_; }
+
+  ///
+  ///\brief Get the bucket counts (bounds().size() + 1 entries, the last one is the overflow)
+  ///
+  ///\return const std::vector<uint64_t>&
+  ///
+  const std::vector<uint64_t> &counts() const noexcept(true) { return this->counts_; }
+
+  ///
+  ///\brief Get the total number of recorded values
+  ///
+  ///\return uint64_t
+  ///
+  uint64_t count() const noexcept(true) { return this->count_; }
+
+  ///
+  ///\brief Get the sum of all recorded values
+  ///
+  ///\return ValueT
+  ///
+  ValueT sum() const noexcept(true) { return this->sum_; }
+
+  ///
+  ///\brief Get the smallest recorded value
+  ///
+  ///\return std::optional<ValueT> std::nullopt if nothing was recorded
+  ///
+  std::optional<ValueT> min() const noexcept(true) { return this->min_; }
+
+  ///
+  ///\brief Get the greatest recorded value
+  ///
+  ///\return std::optional<ValueT> std::nullopt if nothing was recorded
+  ///
+  std::optional<ValueT> max() const noexcept(true) { return this->max_; }
+
+  ///
+  ///\brief Get the smallest bucket bound below which at least the given fraction of values lies
+  ///
+  ///\param fraction the fraction in [0, 1]
+  ///\return std::optional<ValueT> the bound, the maximum for the overflow bucket or std::nullopt
+  ///        if nothing was recorded
+  ///
+  std::optional<ValueT> quantileBound(double fraction) const noexcept(true) {
+    if (this->count_ == 0) {
+      return std::nullopt;
+    }
+    uint64_t accumulated = 0;
+    for (size_t i = 0; i < this->bounds_.size(); i++) {
+      accumulated += this->counts_[i];
+      if (accumulated >= fraction * this->count_) {
+        return this->bounds_[i];
+      }
+    }
+    return this->max_;
+  }
+};
+
+///\brief Histogram for latencies measured with the steady clock
+using LatencyHistogram = Histogram<std::chrono::steady_clock::duration>;
+
+///
+///\brief Exponential latency bounds from 100us up to ~13s (factor 2 per bucket)
+///
+///\return std::vector<std::chrono::steady_clock::duration>
+///
+inline std::vector<std::chrono::steady_clock::duration> defaultLatencyBounds() noexcept(true) {
+  std::vector<std::chrono::steady_clock::duration> bounds;
+  std::chrono::steady_clock::duration bound = std::chrono::microseconds(100);
+  for (int i = 0; i < 18; i++) {
+    bounds.push_back(bound);
+    bound *= 2;
+  }
+  return bounds;
+}
+
+///
+///\brief Exponential size bounds 0, 1, 2, 4, ... up to max (inclusive)
+///
+///\param max the greatest bound
+///\return std::vector<uint64_t>
+///
+inline std::vector<uint64_t> defaultSizeBounds(uint64_t max = 1024) noexcept(true) {
+  std::vector<uint64_t> bounds = {0};
+  for (uint64_t bound = 1; bound <= max; bound *= 2) {
+    bounds.push_back(bound);
+  }
+  return bounds;
+}
+
+}  // namespace vda5050pp::core::common
+
+#endif /* INCLUDE_VDA5050_2B_2B_CORE_COMMON_HISTOGRAM */
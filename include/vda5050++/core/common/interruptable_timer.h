@@ -43,6 +43,7 @@ private:
   mutable std::condition_variable waiting_cv_;
   mutable std::mutex waiting_mutex_;
   mutable uint32_t num_waiting_ = 0;
+  std::mutex interrupt_mutex_;
 
 public:
   ///
@@ -156,9 +157,11 @@ public:
   ///
   /// \brief Interrupt all sleep calls on *this (blocks until all blocked threads resume)
   ///
-  /// This effectively calls disable, then enable.
+  /// This effectively calls disable, then enable. Concurrent calls are serialized, otherwise
+  /// one call could re-enable the timer, before the sleep calls resumed for the other one.
   ///
   void interruptAll() noexcept(true) {
+    std::unique_lock lock(this->interrupt_mutex_);
     this->disable();
     this->enable();
   }
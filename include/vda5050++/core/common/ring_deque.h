@@ -0,0 +1,141 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains a growable ring buffer deque
+//
+
+#ifndef INCLUDE_VDA5050_2B_2B_CORE_COMMON_RING_DEQUE
+#define INCLUDE_VDA5050_2B_2B_CORE_COMMON_RING_DEQUE
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace vda5050pp::core::common {
+
+///
+///\brief A deque on top of a ring buffer, which only allocates when it grows
+///
+/// Unlike std::deque, pushing and popping at the ends never allocates or frees memory,
+/// once the buffer is large enough.
+///
+///\tparam T the element type (must be nothrow move constructible)
+///
+template <typename T> class RingDeque {
+private:
+  static constexpr std::size_t k_min_capacity = 8;
+
+  std::allocator<T> allocator_;
+  T *data_ = nullptr;
+  std::size_t capacity_ = 0;  // always 0 or a power of two
+  std::size_t head_ = 0;
+  std::size_t size_ = 0;
+
+  T *at(std::size_t i) noexcept(true) {
+    return this->data_ + ((this->head_ + i) & (this->capacity_ - 1));
+  }
+
+  void grow() noexcept(false) {
+    auto capacity = this->capacity_ == 0 ? k_min_capacity : this->capacity_ * 2;
+    auto data = this->allocator_.allocate(capacity);
+    for (std::size_t i = 0; i < this->size_; i++) {
+      auto elem = this->at(i);
+      new (data + i) T(std::move(*elem));
+      elem->~T();
+    }
+    this->release();
+    this->data_ = data;
+    this->capacity_ = capacity;
+    this->head_ = 0;
+  }
+
+  void release() noexcept(true) {
+    if (this->data_ != nullptr) {
+      this->allocator_.deallocate(this->data_, this->capacity_);
+      this->data_ = nullptr;
+    }
+  }
+
+public:
+  RingDeque() noexcept(true) = default;
+
+  RingDeque(RingDeque &&other) noexcept(true)
+      : data_(std::exchange(other.data_, nullptr)),
+        capacity_(std::exchange(other.capacity_, 0)),
+        head_(std::exchange(other.head_, 0)),
+        size_(std::exchange(other.size_, 0)) {}
+
+  RingDeque &operator=(RingDeque &&other) noexcept(true) {
+    if (this != &other) {
+      this->clear();
+      this->release();
+      this->data_ = std::exchange(other.data_, nullptr);
+      this->capacity_ = std::exchange(other.capacity_, 0);
+      this->head_ = std::exchange(other.head_, 0);
+      this->size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+  }
+
+  RingDeque(const RingDeque &) = delete;
+  RingDeque &operator=(const RingDeque &) = delete;
+
+  ~RingDeque() noexcept(true) {
+    this->clear();
+    this->release();
+  }
+
+  ///
+  ///\brief Append an element
+  ///
+  ///\param value the element to move in
+  ///
+  void push_back(T &&value) noexcept(false) {
+    if (this->size_ == this->capacity_) {
+      this->grow();
+    }
+    new (this->at(this->size_)) T(std::move(value));
+    this->size_++;
+  }
+
+  ///\brief remove the first element (must not be empty)
+  void pop_front() noexcept(true) {
+    this->at(0)->~T();
+    this->head_ = (this->head_ + 1) & (this->capacity_ - 1);
+    this->size_--;
+  }
+
+  ///\brief remove the last element (must not be empty)
+  void pop_back() noexcept(true) {
+    this->at(this->size_ - 1)->~T();
+    this->size_--;
+  }
+
+  ///\brief access the first element (must not be empty)
+  T &front() noexcept(true) { return *this->at(0); }
+
+  ///\brief access the last element (must not be empty)
+  T &back() noexcept(true) { return *this->at(this->size_ - 1); }
+
+  ///\brief remove all elements (keeps the buffer)
+  void clear() noexcept(true) {
+    while (this->size_ > 0) {
+      this->pop_back();
+    }
+    this->head_ = 0;
+  }
+
+  bool empty() const noexcept(true) { return this->size_ == 0; }
+
+  std::size_t size() const noexcept(true) { return this->size_; }
+
+  std::size_t capacity() const noexcept(true) { return this->capacity_; }
+};
+
+}  // namespace vda5050pp::core::common
+
+#endif /* INCLUDE_VDA5050_2B_2B_CORE_COMMON_RING_DEQUE */
@@ -0,0 +1,217 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains the base class of executors shared by multiple Handles
+//
+
+#ifndef INCLUDE_VDA5050_2B_2B_CORE_COMMON_SHARED_EXECUTOR
+#define INCLUDE_VDA5050_2B_2B_CORE_COMMON_SHARED_EXECUTOR
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <unordered_map>
+
+#include "vda5050++/core/common/ring_deque.h"
+#include "vda5050++/core/common/task.h"
+
+namespace vda5050pp::core::common {
+
+///
+///\brief Runs the timers and the pending tasks of multiple Handles
+///
+/// Handles attach as participants. A participant notifies the executor, when it has pending
+/// tasks and is run by the executor afterwards. Timers belong to a key (i.e. the Handle), such
+/// that detaching a Handle cancels its timers.
+///
+/// Derived classes decide when and on which thread timers and participants run
+/// @see SimulationExecutor @see ThreadPoolExecutor
+///
+class SharedExecutor {
+public:
+  using Clock = std::chrono::system_clock;
+  using TimePoint = Clock::time_point;
+  using Duration = Clock::duration;
+
+  ///
+  ///\brief Runs all pending work of a participant
+  ///
+  ///\return true if any work was done
+  ///
+  using Participant = std::function<bool()>;
+
+  ///\brief Identifies a scheduled timer
+  struct TimerId {
+    TimePoint at;
+    uint64_t seq = 0;
+
+    bool operator<(const TimerId &other) const noexcept(true) {
+      return std::tie(this->at, this->seq) < std::tie(other.at, other.seq);
+    }
+  };
+
+  ///\brief Counters of the executor
+  struct Statistics {
+    ///\brief number of timers, which fired
+    uint64_t timers_fired = 0;
+    ///\brief number of participant runs
+    uint64_t participant_runs = 0;
+    ///\brief number of participant runs, which did not find any work
+    uint64_t idle_runs = 0;
+  };
+
+private:
+  struct Timer {
+    const void *key;
+    Task task;
+  };
+
+  struct Slot {
+    Participant participant;
+    ///\brief is the participant in the ready queue
+    bool ready = false;
+  };
+
+  static thread_local const void *current_key_;
+
+  uint64_t next_seq_ = 0;
+  std::map<TimerId, Timer> timers_;
+  std::unordered_map<const void *, Slot> participants_;
+  RingDeque<const void *> ready_;
+  ///\brief number of running participants and timers per key
+  std::unordered_map<const void *, uint32_t> running_;
+  std::condition_variable running_cv_;
+  Statistics statistics_;
+
+  ///\brief run fn for a key with the mutex unlocked and track it as running
+  template <typename Fn>
+  void runUnlocked(std::unique_lock<std::mutex> &lock, const void *key, Fn &fn) noexcept(false);
+
+protected:
+  ///\brief guards all members (and those of derived classes)
+  mutable std::mutex mutex_;
+
+  ///
+  ///\brief Called (with the mutex held), when there is a new ready participant or timer
+  ///
+  virtual void wake() noexcept(true) {}
+
+  ///
+  ///\brief Get the time point of the next timer (mutex held)
+  ///
+  ///\return std::optional<TimePoint>
+  ///
+  std::optional<TimePoint> nextTimerLocked() const noexcept(true);
+
+  ///
+  ///\brief Run the next ready participant, unlocks the mutex while running (mutex held)
+  ///
+  ///\return true if a participant was run
+  ///
+  bool runReadyLocked(std::unique_lock<std::mutex> &lock) noexcept(false);
+
+  ///
+  ///\brief Fire the next timer due until a time point, unlocks the mutex while running
+  /// (mutex held)
+  ///
+  ///\param until the time point
+  ///\param on_take called (with the mutex held) with the time point of the timer before it fires
+  ///\return true if a timer fired
+  ///
+  bool fireTimerLocked(std::unique_lock<std::mutex> &lock, TimePoint until,
+                       const std::function<void(TimePoint)> &on_take) noexcept(false);
+
+public:
+  SharedExecutor() = default;
+  virtual ~SharedExecutor() = default;
+  SharedExecutor(const SharedExecutor &) = delete;
+  SharedExecutor(SharedExecutor &&) = delete;
+  void operator=(const SharedExecutor &) = delete;
+  void operator=(SharedExecutor &&) = delete;
+
+  ///
+  ///\brief Get the current time of the executor
+  ///
+  ///\return TimePoint
+  ///
+  virtual TimePoint now() const noexcept(true) = 0;
+
+  ///
+  ///\brief Schedule a task at a time point (time points in the past fire next, thread-safe)
+  ///
+  ///\param key the owner of the timer (i.e. the address of the Handle)
+  ///\param at the time point to run the task at
+  ///\param task the task
+  ///\return TimerId the id to cancel the timer with
+  ///
+  TimerId schedule(const void *key, TimePoint at, Task task) noexcept(false);
+
+  ///
+  ///\brief Schedule a task relative to the current time (thread-safe)
+  ///
+  ///\param key the owner of the timer (i.e. the address of the Handle)
+  ///\param delay the delay
+  ///\param task the task
+  ///\return TimerId the id to cancel the timer with
+  ///
+  TimerId scheduleAfter(const void *key, Duration delay, Task task) noexcept(false);
+
+  ///
+  ///\brief Cancel a timer, which did not fire, yet (thread-safe, does not wait)
+  ///
+  ///\param id the id of the timer
+  ///\return true if the timer was cancelled
+  ///
+  bool cancel(const TimerId &id) noexcept(true);
+
+  ///
+  ///\brief Get the time point of the next timer
+  ///
+  ///\return std::optional<TimePoint> the time point, if there is a timer
+  ///
+  std::optional<TimePoint> nextTimer() const noexcept(true);
+
+  ///
+  ///\brief Attach a participant, which is run after each notify() (and once after attaching)
+  ///
+  ///\param key identifies the participant (i.e. the address of the Handle)
+  ///\param participant the function running all pending work
+  ///
+  void attach(const void *key, Participant participant) noexcept(false);
+
+  ///
+  ///\brief Notify the executor, that a participant has pending work (thread-safe)
+  ///
+  /// Notifications for participants, which are not attached, are ignored.
+  ///\param key the key the participant was attached with
+  ///
+  void notify(const void *key) noexcept(false);
+
+  ///
+  ///\brief Detach a participant and cancel all timers of the key
+  ///
+  /// Blocks until running timers and runs of the participant returned (unless called by one
+  /// of them).
+  ///\param key the key the participant was attached with
+  ///
+  void detach(const void *key) noexcept(true);
+
+  ///
+  ///\brief Get the counters of the executor
+  ///
+  ///\return Statistics
+  ///
+  Statistics getStatistics() const noexcept(true);
+};
+
+}  // namespace vda5050pp::core::common
+
+#endif /* INCLUDE_VDA5050_2B_2B_CORE_COMMON_SHARED_EXECUTOR */
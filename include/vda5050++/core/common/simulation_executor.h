@@ -0,0 +1,72 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains a caller-driven executor with a virtual clock
+//
+
+#ifndef INCLUDE_VDA5050_2B_2B_CORE_COMMON_SIMULATION_EXECUTOR
+#define INCLUDE_VDA5050_2B_2B_CORE_COMMON_SIMULATION_EXECUTOR
+
+#include "vda5050++/core/common/shared_executor.h"
+
+namespace vda5050pp::core::common {
+
+///
+///\brief A deterministic single-threaded executor, which advances a virtual clock
+///
+/// Instead of sleeping threads, the timers of the library (state updates, visualization)
+/// are scheduled on the executor. Nothing happens, unless the caller advances the executor,
+/// so multiple Handles can be simulated faster than real time on a single thread.
+///
+/// Timers due at the same time point fire in the order they were scheduled, participants
+/// run in the order they were notified. So for the same inputs, each run yields the same
+/// sequence of events and timestamps.
+///
+/// NOTE: advancing must not be done concurrently or from within a timer / participant.
+///
+class SimulationExecutor : public SharedExecutor {
+private:
+  TimePoint now_;
+
+public:
+  ///
+  ///\brief Construct a new SimulationExecutor
+  ///
+  ///\param start the initial virtual time (default: the epoch of the system_clock)
+  ///
+  explicit SimulationExecutor(TimePoint start = TimePoint{}) noexcept(true);
+
+  ///
+  ///\brief Get the current virtual time
+  ///
+  ///\return TimePoint
+  ///
+  TimePoint now() const noexcept(true) override;
+
+  ///
+  ///\brief Run the notified participants until none is left (without advancing time)
+  ///
+  void runReady() noexcept(false);
+
+  ///
+  ///\brief Advance the virtual time, firing all timers until (and including) the time point
+  ///
+  /// After each timer, the notified participants run until none is left.
+  ///\param until the new virtual time (never goes backwards)
+  ///
+  void advanceTo(TimePoint until) noexcept(false);
+
+  ///
+  ///\brief Advance the virtual time by a duration @see advanceTo
+  ///
+  ///\param duration the duration
+  ///
+  void advanceBy(Duration duration) noexcept(false);
+};
+
+}  // namespace vda5050pp::core::common
+
+#endif /* INCLUDE_VDA5050_2B_2B_CORE_COMMON_SIMULATION_EXECUTOR */
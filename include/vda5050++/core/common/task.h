@@ -0,0 +1,175 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains a move-only task type with inline storage
+//
+
+#ifndef INCLUDE_VDA5050_2B_2B_CORE_COMMON_TASK
+#define INCLUDE_VDA5050_2B_2B_CORE_COMMON_TASK
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace vda5050pp::core::common {
+
+///
+///\brief A move-only void() callable, which stores small callables without allocation
+///
+/// Callables up to InlineSize bytes (which are nothrow move constructible) are stored inline,
+/// larger ones are moved to the heap.
+///
+///\tparam InlineSize size of the inline storage in bytes
+///
+template <std::size_t InlineSize> class BasicTask {
+private:
+  static_assert(InlineSize >= sizeof(void *), "BasicTask needs space for at least a pointer");
+
+  struct VTable {
+    void (*invoke)(void *storage);
+    ///\brief move construct into dst and destroy src
+    void (*relocate)(void *dst, void *src);
+    void (*destroy)(void *storage);
+  };
+
+  template <typename F>
+  static constexpr bool k_fits_inline = sizeof(F) <= InlineSize &&
+                                        alignof(F) <= alignof(std::max_align_t) &&
+                                        std::is_nothrow_move_constructible_v<F>;
+
+  template <typename F> static const VTable *vtableFor() noexcept(true) {
+    if constexpr (k_fits_inline<F>) {
+      static constexpr VTable vtable{
+          [](void *storage) { (*static_cast<F *>(storage))(); },
+          [](void *dst, void *src) {
+            new (dst) F(std::move(*static_cast<F *>(src)));
+            static_cast<F *>(src)->~F();
+          },
+          [](void *storage) { static_cast<F *>(storage)->~F(); },
+      };
+      return &vtable;
+    } else {
+      static constexpr VTable vtable{
+          [](void *storage) { (**static_cast<F **>(storage))(); },
+          [](void *dst, void *src) { *static_cast<F **>(dst) = *static_cast<F **>(src); },
+          [](void *storage) { delete *static_cast<F **>(storage); },
+      };
+      return &vtable;
+    }
+  }
+
+  alignas(std::max_align_t) unsigned char storage_[InlineSize];
+  const VTable *vtable_ = nullptr;
+
+  void reset() noexcept(true) {
+    if (this->vtable_ != nullptr) {
+      this->vtable_->destroy(this->storage_);
+      this->vtable_ = nullptr;
+    }
+  }
+
+public:
+  ///
+  ///\brief Check if a callable type is stored without allocation
+  ///
+  ///\tparam F the callable type
+  ///\return true if it is stored inline
+  ///
+  template <typename F> static constexpr bool fitsInline() noexcept(true) {
+    return k_fits_inline<std::decay_t<F>>;
+  }
+
+  ///\brief Construct an empty task
+  BasicTask() noexcept(true) = default;
+
+  ///\brief Construct an empty task
+  BasicTask(std::nullptr_t) noexcept(true) {}
+
+  ///
+  ///\brief Construct a task from a callable
+  ///
+  ///\param fn the callable to store (moved from, if it is an rvalue)
+  ///
+  template <typename F,
+            typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, BasicTask> &&
+                                        !std::is_same_v<std::decay_t<F>, std::nullptr_t>>>
+  BasicTask(F &&fn) noexcept(k_fits_inline<std::decay_t<F>>) {
+    using Fn = std::decay_t<F>;
+    if constexpr (k_fits_inline<Fn>) {
+      new (this->storage_) Fn(std::forward<F>(fn));
+    } else {
+      *reinterpret_cast<Fn **>(this->storage_) = new Fn(std::forward<F>(fn));
+    }
+    this->vtable_ = vtableFor<Fn>();
+  }
+
+  ///\brief move construct
+  BasicTask(BasicTask &&other) noexcept(true) : vtable_(other.vtable_) {
+    if (this->vtable_ != nullptr) {
+      this->vtable_->relocate(this->storage_, other.storage_);
+      other.vtable_ = nullptr;
+    }
+  }
+
+  ///\brief move assign
+  BasicTask &operator=(BasicTask &&other) noexcept(true) {
+    if (this != &other) {
+      this->reset();
+      if (other.vtable_ != nullptr) {
+        other.vtable_->relocate(this->storage_, other.storage_);
+        this->vtable_ = other.vtable_;
+        other.vtable_ = nullptr;
+      }
+    }
+    return *this;
+  }
+
+  ///\brief reset to an empty task
+  BasicTask &operator=(std::nullptr_t) noexcept(true) {
+    this->reset();
+    return *this;
+  }
+
+  ///\brief disallow copy
+  BasicTask(const BasicTask &) = delete;
+  ///\brief disallow copy
+  BasicTask &operator=(const BasicTask &) = delete;
+
+  ~BasicTask() noexcept(true) { this->reset(); }
+
+  ///
+  ///\brief Call the stored callable (must not be empty)
+  ///
+  void operator()() { this->vtable_->invoke(this->storage_); }
+
+  ///
+  ///\brief Check if the task contains a callable
+  ///
+  explicit operator bool() const noexcept(true) { return this->vtable_ != nullptr; }
+};
+
+///\brief inline storage of a Task, such that a Task fills a single cache line
+constexpr std::size_t k_task_inline_size = 48;
+
+///\brief The task type of the Handle task queue
+using Task = BasicTask<k_task_inline_size>;
+
+///
+///\brief Create a Task for a hot dispatch path, which must not allocate. Fails to compile, if
+/// the callable is not stored inline (i.e. because its captures grew)
+///
+///\param fn the callable
+///\return Task the task
+///
+template <typename F> Task inlineTask(F &&fn) noexcept(true) {
+  static_assert(Task::fitsInline<F>(), "Tasks of hot dispatch paths must be stored inline");
+  return Task(std::forward<F>(fn));
+}
+
+}  // namespace vda5050pp::core::common
+
+#endif /* INCLUDE_VDA5050_2B_2B_CORE_COMMON_TASK */
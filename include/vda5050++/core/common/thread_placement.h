@@ -0,0 +1,156 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains the placement (name, CPU affinity, scheduling) of library threads
+//
+
+#ifndef INCLUDE_VDA5050_2B_2B_CORE_COMMON_THREAD_PLACEMENT
+#define INCLUDE_VDA5050_2B_2B_CORE_COMMON_THREAD_PLACEMENT
+
+#include <pthread.h>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace vda5050pp::core::common {
+
+///\brief The scheduling policy of a thread
+enum class SchedulingPolicy {
+  ///\brief keep the policy inherited from the creating thread
+  k_inherit,
+  ///\brief SCHED_OTHER, the priority is the nice value (-20..19)
+  k_other,
+  ///\brief SCHED_FIFO, the priority is the real-time priority (1..99)
+  k_fifo,
+  ///\brief SCHED_RR, the priority is the real-time priority (1..99)
+  k_round_robin,
+};
+
+///
+///\brief Where and how a library thread runs
+///
+/// Real-time policies and negative nice values usually require CAP_SYS_NICE. A placement, which
+/// cannot be applied, does not stop the thread; the error is part of the ThreadInfo.
+///
+struct ThreadPlacement {
+  ///\brief the name of the thread (truncated to 15 characters, empty keeps the name)
+  std::string name;
+  ///\brief the CPUs the thread may run on (empty keeps the affinity, Linux only)
+  std::vector<uint16_t> cpus;
+  ///\brief the scheduling policy
+  SchedulingPolicy policy = SchedulingPolicy::k_inherit;
+  ///\brief the priority within the policy (ignored for k_inherit)
+  int priority = 0;
+};
+
+///
+///\brief The placement of all threads created by a Handle
+///
+struct ThreadingConfig {
+  static constexpr const char *k_spinner_role = "spinner";
+  static constexpr const char *k_state_update_role = "state_update";
+  static constexpr const char *k_visualization_role = "visualization";
+
+  ///\brief the threads created by Handle::spinParallel (numbered)
+  ThreadPlacement spinner{"vda5050-spin", {}, SchedulingPolicy::k_inherit, 0};
+  ///\brief the thread sending periodic state updates
+  ThreadPlacement state_update{"vda5050-state", {}, SchedulingPolicy::k_inherit, 0};
+  ///\brief the thread sending automatic visualization messages
+  ThreadPlacement visualization{"vda5050-vis", {}, SchedulingPolicy::k_inherit, 0};
+};
+
+///
+///\brief The actual placement of a running thread
+///
+struct ThreadInfo {
+  ///\brief the role of the thread within the library (i.e. "spinner")
+  std::string role;
+  ///\brief the number of the thread within its role
+  uint16_t index = 0;
+  ///\brief the kernel thread id (0 if unknown)
+  int64_t tid = 0;
+  ///\brief the actual name of the thread
+  std::string name;
+  ///\brief the CPUs the thread may run on
+  std::vector<uint16_t> cpus;
+  ///\brief the actual scheduling policy
+  SchedulingPolicy policy = SchedulingPolicy::k_other;
+  ///\brief the actual priority (nice value for k_other)
+  int priority = 0;
+  ///\brief the errors of the last attempt to apply the placement (empty on success)
+  std::string error;
+};
+
+///
+///\brief Keeps track of the threads created by the library and places them
+///
+/// Threads register themselves with enter() once started and leave() before they return.
+/// Changing the placement of a role also applies it to the running threads of the role.
+///
+class ThreadRegistry {
+private:
+  struct Entry {
+    std::string role;
+    uint16_t index;
+    bool numbered;
+    pthread_t handle;
+    int64_t tid;
+    std::string error;
+  };
+
+  mutable std::mutex mutex_;
+  std::map<std::string, ThreadPlacement> placements_;
+  std::map<std::thread::id, Entry> entries_;
+  std::function<void(const std::string &)> on_error_;
+
+  ///\brief apply the placement of the entry's role (mutex held)
+  void applyLocked(Entry &entry) noexcept(true);
+
+public:
+  ///
+  ///\brief Set the placement of a role and apply it to its running threads
+  ///
+  ///\param role the role
+  ///\param placement the placement
+  ///
+  void setPlacement(const std::string &role, ThreadPlacement placement) noexcept(false);
+
+  ///
+  ///\brief Set a function, which is called with a message, when a placement cannot be applied
+  ///
+  ///\param on_error the function
+  ///
+  void setErrorHandler(std::function<void(const std::string &)> on_error) noexcept(false);
+
+  ///
+  ///\brief Register the calling thread and apply the placement of its role
+  ///
+  ///\param role the role of the calling thread
+  ///\param numbered append the number of the thread within its role to the name
+  ///
+  void enter(const std::string &role, bool numbered = false) noexcept(false);
+
+  ///
+  ///\brief Unregister the calling thread
+  ///
+  void leave() noexcept(true);
+
+  ///
+  ///\brief Get the actual placement of all registered threads
+  ///
+  ///\return std::vector<ThreadInfo>
+  ///
+  std::vector<ThreadInfo> report() const noexcept(false);
+};
+
+}  // namespace vda5050pp::core::common
+
+#endif /* INCLUDE_VDA5050_2B_2B_CORE_COMMON_THREAD_PLACEMENT */
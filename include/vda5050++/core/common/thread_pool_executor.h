@@ -0,0 +1,88 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains a thread pool, which runs the timers and tasks of multiple Handles
+//
+
+#ifndef INCLUDE_VDA5050_2B_2B_CORE_COMMON_THREAD_POOL_EXECUTOR
+#define INCLUDE_VDA5050_2B_2B_CORE_COMMON_THREAD_POOL_EXECUTOR
+
+#include <condition_variable>
+#include <thread>
+#include <vector>
+
+#include "vda5050++/core/common/shared_executor.h"
+#include "vda5050++/core/common/thread_placement.h"
+
+namespace vda5050pp::core::common {
+
+///
+///\brief A fixed number of threads, which run the timers and tasks of all attached Handles
+///
+/// Hosting many vehicles in one process with one thread per timer and spinner of each Handle
+/// does not scale. Handles attached to a ThreadPoolExecutor share its threads instead, so the
+/// number of threads does not depend on the number of vehicles.
+///
+/// Timers fire in real time (system_clock). A participant may run on multiple threads at once,
+/// if it is notified while running (like Handle::spinParallel).
+///
+class ThreadPoolExecutor : public SharedExecutor {
+public:
+  static constexpr const char *k_role = "pool";
+
+private:
+  ThreadRegistry thread_registry_;
+  std::condition_variable cv_;
+  bool stop_ = false;
+  std::vector<std::thread> threads_;
+
+  void work() noexcept(true);
+
+protected:
+  void wake() noexcept(true) override;
+
+public:
+  ///
+  ///\brief Start the threads of the pool
+  ///
+  ///\param num_threads the number of threads (at least one)
+  ///\param placement the placement of the threads (their names are numbered)
+  ///
+  explicit ThreadPoolExecutor(
+      std::size_t num_threads,
+      ThreadPlacement placement = {"vda5050-pool", {}, SchedulingPolicy::k_inherit, 0}) noexcept(
+      false);
+
+  ///
+  ///\brief Stop and join the threads (all Handles have to be detached before)
+  ///
+  ~ThreadPoolExecutor() override;
+
+  ///
+  ///\brief Get the current time of the system_clock
+  ///
+  ///\return TimePoint
+  ///
+  TimePoint now() const noexcept(true) override;
+
+  ///
+  ///\brief Get the number of threads of the pool
+  ///
+  ///\return std::size_t
+  ///
+  std::size_t size() const noexcept(true);
+
+  ///
+  ///\brief Get the actual placement of the threads of the pool
+  ///
+  ///\return std::vector<ThreadInfo>
+  ///
+  std::vector<ThreadInfo> getThreadReport() const noexcept(false);
+};
+
+}  // namespace vda5050pp::core::common
+
+#endif /* INCLUDE_VDA5050_2B_2B_CORE_COMMON_THREAD_POOL_EXECUTOR */
@@ -0,0 +1,78 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains a pollable wakeup file descriptor
+//
+
+#ifndef INCLUDE_VDA5050_2B_2B_CORE_COMMON_WAKEUP_FD
+#define INCLUDE_VDA5050_2B_2B_CORE_COMMON_WAKEUP_FD
+
+#include <chrono>
+
+namespace vda5050pp::core::common {
+
+///
+///\brief A file descriptor, which becomes readable when notified
+///
+/// Uses an eventfd on linux and a pipe otherwise. The fd can be added to an external
+/// event loop (poll/epoll/select), which calls drain() once it was woken up.
+///
+class WakeupFd final {
+private:
+  int read_fd_ = -1;
+  int write_fd_ = -1;
+
+public:
+  ///
+  ///\brief Create a new (not notified) WakeupFd
+  ///
+  ///\throws std::system_error if the fd could not be created
+  ///
+  WakeupFd() noexcept(false);
+
+  ///\brief close the fd
+  ~WakeupFd();
+
+  ///\brief disallow copy
+  WakeupFd(const WakeupFd &) = delete;
+  ///\brief disallow move
+  WakeupFd(WakeupFd &&) = delete;
+  ///\brief disallow copy
+  void operator=(const WakeupFd &) = delete;
+  ///\brief disallow move
+  void operator=(WakeupFd &&) = delete;
+
+  ///
+  ///\brief Get the pollable file descriptor (readable, if notified)
+  ///
+  ///\return int the fd
+  ///
+  int fd() const noexcept(true);
+
+  ///
+  ///\brief Make the fd readable (thread-safe, async-signal-safe)
+  ///
+  void notify() noexcept(true);
+
+  ///
+  ///\brief Reset the fd to the not notified state
+  ///
+  ///\return true if the fd was notified before
+  ///
+  bool drain() noexcept(true);
+
+  ///
+  ///\brief Wait until the fd is notified (does not drain)
+  ///
+  ///\param timeout the maximum time to wait
+  ///\return true if the fd is notified
+  ///
+  bool wait(std::chrono::milliseconds timeout) const noexcept(true);
+};
+
+}  // namespace vda5050pp::core::common
+
+#endif /* INCLUDE_VDA5050_2B_2B_CORE_COMMON_WAKEUP_FD */
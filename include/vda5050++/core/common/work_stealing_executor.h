@@ -0,0 +1,330 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains a work-stealing task executor
+//
+
+#ifndef INCLUDE_VDA5050_2B_2B_CORE_COMMON_WORK_STEALING_EXECUTOR
+#define INCLUDE_VDA5050_2B_2B_CORE_COMMON_WORK_STEALING_EXECUTOR
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "vda5050++/core/common/histogram.h"
+#include "vda5050++/core/common/ring_deque.h"
+#include "vda5050++/core/common/task.h"
+
+namespace vda5050pp::core::common {
+
+///
+///\brief The priority lanes of the WorkStealingExecutor (highest priority first)
+///
+enum class TaskLane : uint8_t {
+  ///\brief stopping/pausing and incoming messages (which may request a stop)
+  k_stop = 0,
+  ///\brief navigation handler callbacks
+  k_navigation = 1,
+  ///\brief action handler callbacks
+  k_action = 2,
+  ///\brief cleanup work
+  k_housekeeping = 3,
+};
+
+///\brief number of TaskLanes
+constexpr std::size_t k_task_lanes = 4;
+
+///
+///\brief Task queue for multiple spinning threads, based on work-stealing
+///
+/// Each attached worker thread owns a deque. Tasks pushed by a worker land in its own
+/// deque, tasks pushed by other threads in a shared injection queue. A worker pops from its own
+/// deque first, then from the injection queue and finally steals from other workers.
+/// Threads, which are not attached (i.e. Handle::spinOnce), take from the injection queue and
+/// steal from the workers.
+///
+/// Tasks pushed with the same OrderKey are executed in FIFO order and never concurrently
+/// (like a strand). Tasks without a key have no ordering guarantees, when multiple threads are
+/// attached.
+///
+/// Each deque is split into TaskLanes, which are served by strict priority. A lane, which was
+/// skipped for starvation limit times in a row, is served before the higher priority lanes.
+///
+/// Once warmed up, pushing and popping tasks, which fit into a Task, does not allocate.
+///
+class WorkStealingExecutor {
+public:
+  using Task = vda5050pp::core::common::Task;
+
+  ///\brief Identifies a group of tasks, which have to be executed in order (i.e. a task manager)
+  using OrderKey = const void *;
+
+  ///\brief Metrics of a single lane
+  struct LaneStatistics {
+    ///\brief number of pushed tasks
+    uint64_t pushed = 0;
+    ///\brief number of tasks taken for execution
+    uint64_t started = 0;
+    ///\brief number of tasks waiting (including ordered tasks waiting for their predecessors)
+    uint64_t depth = 0;
+    ///\brief the greatest depth seen
+    uint64_t max_depth = 0;
+    ///\brief time between push and start of the tasks
+    LatencyHistogram wait_time;
+  };
+
+  ///\brief Counters of the executor
+  struct Statistics {
+    ///\brief number of pushed tasks (ordered tasks only count once)
+    uint64_t pushed = 0;
+    ///\brief tasks popped from the own deque of a worker
+    uint64_t popped_local = 0;
+    ///\brief tasks popped from the injection queue
+    uint64_t popped_injected = 0;
+    ///\brief tasks stolen from other workers
+    uint64_t stolen = 0;
+    ///\brief number of times a starving lane was served before a higher priority lane
+    uint64_t starvation_promotions = 0;
+    ///\brief metrics of each lane (index = TaskLane)
+    std::array<LaneStatistics, k_task_lanes> lanes;
+  };
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Entry {
+    Task task;
+    ///\brief push time, Clock::time_point{} for internal tasks, which are not measured
+    Clock::time_point pushed;
+  };
+
+  using Lanes = std::array<RingDeque<Entry>, k_task_lanes>;
+
+  struct Worker {
+    std::mutex mutex;
+    Lanes lanes;
+    const WorkStealingExecutor *owner = nullptr;
+  };
+
+  struct OrderedTask {
+    Task task;
+    TaskLane lane;
+    Clock::time_point pushed;
+  };
+
+  using OrderQueues = std::unordered_map<OrderKey, RingDeque<OrderedTask>>;
+
+  struct OrderShard {
+    std::mutex mutex;
+    ///\brief an entry exists, while the key is scheduled, the front task may be running
+    OrderQueues queues;
+    ///\brief recycled map nodes (with their buffers), to avoid allocations per scheduled key
+    std::vector<OrderQueues::node_type> spare_nodes;
+  };
+
+  struct LaneMetrics {
+    std::atomic_uint64_t pushed = 0;
+    std::atomic_uint64_t started = 0;
+    std::atomic_uint64_t depth = 0;
+    std::atomic_uint64_t max_depth = 0;
+    ///\brief number of runnable entries in the deques
+    std::atomic_size_t runnable = 0;
+    ///\brief consecutive pops, which skipped this (non-empty) lane
+    std::atomic_uint32_t skipped = 0;
+    mutable std::mutex wait_time_mutex;
+    LatencyHistogram wait_time{defaultLatencyBounds()};
+  };
+
+  static constexpr std::size_t k_order_shards = 16;
+  static constexpr std::size_t k_ordered_batch = 8;
+  static constexpr std::size_t k_spare_nodes = 4;
+
+  static thread_local Worker *current_worker_;
+
+  std::mutex injection_mutex_;
+  Lanes injection_;
+
+  mutable std::shared_mutex workers_mutex_;
+  std::vector<std::shared_ptr<Worker>> workers_;
+
+  std::array<OrderShard, k_order_shards> order_shards_;
+
+  std::atomic_size_t pending_ = 0;
+  std::atomic_size_t idle_ = 0;
+  std::atomic_uint64_t wake_epoch_ = 0;
+  std::mutex idle_mutex_;
+  std::condition_variable idle_cv_;
+
+  std::array<LaneMetrics, k_task_lanes> lanes_;
+  std::atomic_uint32_t starvation_limit_ = 16;
+
+  std::atomic_uint64_t pushed_ = 0;
+  std::atomic_uint64_t popped_local_ = 0;
+  std::atomic_uint64_t popped_injected_ = 0;
+  std::atomic_uint64_t stolen_ = 0;
+  std::atomic_uint64_t starvation_promotions_ = 0;
+
+  std::function<void()> push_notifier_;
+
+  Worker *currentWorker() const noexcept(true);
+
+  void enqueue(Entry &&entry, TaskLane lane) noexcept(false);
+
+  void countPush(TaskLane lane) noexcept(true);
+
+  void countStart(TaskLane lane, Clock::time_point pushed) noexcept(true);
+
+  void runOrdered(OrderKey key) noexcept(false);
+
+  static RingDeque<OrderedTask> &scheduleKey(OrderShard &shard, OrderKey key) noexcept(false);
+
+  static void unscheduleKey(OrderShard &shard, OrderQueues::iterator it) noexcept(false);
+
+  std::optional<Entry> takeFromLane(std::size_t lane, Worker *self) noexcept(true);
+
+  std::optional<Task> take() noexcept(true);
+
+public:
+  WorkStealingExecutor() = default;
+  ~WorkStealingExecutor() = default;
+  WorkStealingExecutor(const WorkStealingExecutor &) = delete;
+  WorkStealingExecutor(WorkStealingExecutor &&) = delete;
+  void operator=(const WorkStealingExecutor &) = delete;
+  void operator=(WorkStealingExecutor &&) = delete;
+
+  ///
+  ///\brief Push a task without ordering constraints into the action lane (thread-safe)
+  ///
+  ///\param task the task to push
+  ///
+  void push(Task task) noexcept(false);
+
+  ///
+  ///\brief Push a task without ordering constraints (thread-safe)
+  ///
+  ///\param lane the priority lane of the task
+  ///\param task the task to push
+  ///
+  void push(TaskLane lane, Task task) noexcept(false);
+
+  ///
+  ///\brief Push a task into the action lane, which runs after all tasks previously pushed with
+  /// the same key (thread-safe)
+  ///
+  ///\param key the ordering key (i.e. the address of the pushing object)
+  ///\param task the task to push
+  ///
+  void push(OrderKey key, Task task) noexcept(false);
+
+  ///
+  ///\brief Push a task, which runs after all tasks previously pushed with the same key
+  /// (thread-safe)
+  ///
+  /// The lane only prioritizes the key against other keys, the FIFO order of the key is kept.
+  ///\param key the ordering key (i.e. the address of the pushing object)
+  ///\param lane the priority lane of the task
+  ///\param task the task to push
+  ///
+  void push(OrderKey key, TaskLane lane, Task task) noexcept(false);
+
+  ///
+  ///\brief pop and return the next task if available (thread-safe)
+  ///
+  ///\return std::optional<Task> task, if avaliable, otherwise std::nullopt
+  ///
+  std::optional<Task> try_pop() noexcept(true);
+
+  ///
+  ///\brief Try to pop a task for a specific amount of time (blocking, thread-safe)
+  ///
+  /// Returns early without a task, if wakeAll() was called.
+  ///\param rel_time time to try before returning
+  ///\return task if a task was available \n
+  ///        std::nullopt if no task was available
+  ///
+  std::optional<Task> try_pop_for(std::chrono::steady_clock::duration rel_time) noexcept(true);
+
+  ///
+  ///\brief Pop a task, blocking without a timeout until one is available (thread-safe)
+  ///
+  /// Returns early without a task, if wakeAll() was called. cancelled is checked under the same
+  /// lock as wakeAll(), such that a flag set before calling wakeAll() is never missed.
+  ///\param cancelled returns true, if the caller should stop waiting
+  ///\return task if a task was available \n
+  ///        std::nullopt if woken up by wakeAll()
+  ///
+  std::optional<Task> pop(const std::function<bool()> &cancelled) noexcept(true);
+
+  ///
+  ///\brief Register the calling thread as a worker with an own deque
+  ///
+  void attachWorker() noexcept(false);
+
+  ///
+  ///\brief Unregister the calling thread, the tasks of its deque are moved to the injection queue
+  ///
+  void detachWorker() noexcept(false);
+
+  ///
+  ///\brief Wake up all threads blocking in try_pop_for or pop
+  ///
+  void wakeAll() noexcept(true);
+
+  ///
+  ///\brief Set a function, which is called after each push (i.e. to wake up an event loop)
+  ///
+  /// NOTE: This is not synchronized, set it before the executor is used concurrently.
+  ///\param notifier the function to call (empty to disable)
+  ///
+  void setPushNotifier(std::function<void()> notifier) noexcept(true);
+
+  ///
+  ///\brief Set how often a non-empty lane may be skipped in favour of higher priority lanes
+  ///
+  ///\param limit the number of pops (0 disables priorities, default 16)
+  ///
+  void setStarvationLimit(uint32_t limit) noexcept(true);
+
+  ///
+  ///\brief Check if there is no runnable task
+  ///
+  /// Ordered tasks are only runnable, if no other task with the same key is running.
+  ///\return true no runnable task
+  ///
+  bool empty() const noexcept(true);
+
+  ///
+  ///\brief Return the number of runnable tasks
+  ///
+  ///\return std::size_t count
+  ///
+  std::size_t size() const noexcept(true);
+
+  ///
+  ///\brief Get the current counters
+  ///
+  ///\return Statistics
+  ///
+  Statistics getStatistics() const noexcept(true);
+
+  ///
+  ///\brief Reset the lane metrics and counters (not the current depth)
+  ///
+  void resetStatistics() noexcept(true);
+};
+
+}  // namespace vda5050pp::core::common
+
+#endif /* INCLUDE_VDA5050_2B_2B_CORE_COMMON_WORK_STEALING_EXECUTOR */
@@ -80,7 +80,7 @@ public:
   const vda5050pp::core::messages::Messages &getMessages() const noexcept(true);
 
   ///
-  ///\brief Return a valid logger for the Handle. Either the configured handle, or
+  ///\brief Return the logger of the Handle. Either the configured logger, or
   /// a logger stub, discarding all values
   ///
   ///\return vda5050pp::interface_agv::Logger&
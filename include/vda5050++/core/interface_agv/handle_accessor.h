@@ -122,7 +122,7 @@ public:
   vda5050pp::core::messages::Messages &getMessages() noexcept(true);
 
   ///
-  ///\brief Return a valid logger for the Handle. Either the configured handle, or
+  ///\brief Return the logger of the Handle. Either the configured logger, or
   /// a logger stub, discarding all values
   ///
   ///\return vda5050pp::interface_agv::Logger&
@@ -175,7 +175,22 @@ public:
   ///
   bool isStepBasedNavigation() const noexcept(true);
 
-  vda5050pp::core::common::BlockingQueue<std::function<void()>> &getTaskQueue() noexcept(true);
+  vda5050pp::core::common::WorkStealingExecutor &getTaskQueue() noexcept(true);
+
+  ///
+  ///\brief Get the executor running the timers and tasks of the Handle
+  ///
+  ///\return std::shared_ptr<vda5050pp::core::common::SharedExecutor> (nullptr for own threads)
+  ///
+  std::shared_ptr<vda5050pp::core::common::SharedExecutor> getSharedExecutor() const
+      noexcept(true);
+
+  ///
+  ///\brief Get the registry of the threads created by the Handle
+  ///
+  ///\return vda5050pp::core::common::ThreadRegistry&
+  ///
+  vda5050pp::core::common::ThreadRegistry &getThreadRegistry() noexcept(true);
 
   const vda5050pp::interface_agv::agv_description::AGVDescription &getAGVDescription() const
       noexcept(true);
@@ -187,6 +202,13 @@ public:
   ///
   std::chrono::system_clock::duration getStateUpdatePeriod() const noexcept(true);
 
+  ///
+  ///\brief get the number of time steps interpreted ahead of the vehicle
+  ///
+  ///\return std::size_t the window (0 = unlimited)
+  ///
+  std::size_t getInterpretationWindow() const noexcept(true);
+
   ///
   ///\brief Get a shared_ptr to the currently set OdometryHandler
   ///
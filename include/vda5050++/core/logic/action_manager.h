@@ -51,6 +51,11 @@ public:
   ///
   ActionManager(vda5050pp::interface_agv::Handle &handle, vda5050pp::Action action, SeqNrT seq);
 
+  ///
+  ///\brief Unset the manager reference of the handler, which might be held by the user
+  ///
+  ~ActionManager() noexcept(true);
+
   ///
   /// \brief Get a pointer to the associated ActionHandler
   ///
@@ -39,6 +39,9 @@ public:
 
   virtual void attachToNet(Net &composed_net) noexcept(false) override;
 
+  void getOwnIDs(std::vector<LogicTaskNetID> &places,
+                 std::vector<LogicTaskNetID> &transitions) const noexcept(false) override;
+
   /// \brief Get the Place before the cancel place
   LogicTaskNetID getPrePlaceID() const noexcept(true);
   /// \brief Get the cancel place
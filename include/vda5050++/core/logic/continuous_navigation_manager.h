@@ -64,6 +64,11 @@ public:
                               const vda5050pp::Node &node, const vda5050pp::Edge &edge,
                               std::vector<std::string> &&cancel_action_ids) noexcept(true);
 
+  ///
+  ///\brief Unset the manager of the handler, which might be held by the user
+  ///
+  ~ContinuousNavigationManager() noexcept(true);
+
   void append(const vda5050pp::Node &node, const std::optional<vda5050pp::Edge> &edge,
               std::vector<std::string> &&cancel_action_ids) noexcept(true);
 
@@ -80,6 +85,22 @@ public:
   bool intercept() noexcept(true);
   bool isActive() const noexcept(true);
   std::shared_ptr<ContinuousNavigationSingleStepTask> getInterceptedMgr() noexcept(true);
+
+  ///
+  ///\brief Hand over the step of a node, after the NetManager removed it from the net
+  ///
+  ///\param node_seq the sequence id of the step's node
+  ///\return std::shared_ptr<ContinuousNavigationSingleStepTask> the step (nullptr if unknown)
+  ///
+  std::shared_ptr<ContinuousNavigationSingleStepTask> releaseStep(uint32_t node_seq) noexcept(
+      true);
+
+  ///
+  ///\brief Are there steps, which were not released yet?
+  ///
+  ///\return true if there are steps left
+  ///
+  bool hasSteps() const noexcept(true);
 };
 
 }  // namespace vda5050pp::core::logic
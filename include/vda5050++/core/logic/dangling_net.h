@@ -27,6 +27,9 @@ public:
 
   void attachToNet(Net &composed_net) noexcept(false) override;
 
+  void getOwnIDs(std::vector<LogicTaskNetID> &places,
+                 std::vector<LogicTaskNetID> &transitions) const noexcept(false) override;
+
   LogicTaskNetID getBeginPlace() const noexcept(true);
 
   LogicTaskNetID getInvokePlace() const noexcept(true);
@@ -59,6 +59,11 @@ public:
                      std::optional<vda5050pp::Edge> via_edge, vda5050pp::Node goal_node,
                      SeqNrT seq);
 
+  ///
+  ///\brief Unset the manager reference of the handler, which might be held by the user
+  ///
+  ~DriveToNodeManager() noexcept(true);
+
   ///
   ///\brief Pause the associated driving task (forward to handle.onPause)
   ///
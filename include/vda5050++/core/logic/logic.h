@@ -12,6 +12,7 @@
 
 #include "vda5050++/core/logic/instant_actions_manager.h"
 #include "vda5050++/core/logic/net_manager.h"
+#include "vda5050++/core/logic/net_trace.h"
 #include "vda5050++/model/Action.h"
 #include "vda5050++/model/Order.h"
 
@@ -27,6 +28,8 @@ namespace vda5050pp::core::logic {
 ///
 class Logic {
 private:
+  ///\brief declared before the net manager, because the hooks of the net refer to it
+  NetTrace net_trace_;
   NetManager net_manager_;
   InstantActionsManager instant_actions_manager_;
 
@@ -88,6 +91,20 @@ public:
   void abortOrder(const std::function<void()> &and_then = nullptr) noexcept(true);
 
   void notifyHorizonChanged() noexcept(true);
+
+  ///
+  ///\brief Get the firing trace of the logic net
+  ///
+  ///\return NetTrace&
+  ///
+  NetTrace &getNetTrace() noexcept(true);
+
+  ///
+  ///\brief Get the firing trace of the logic net
+  ///
+  ///\return const NetTrace&
+  ///
+  const NetTrace &getNetTrace() const noexcept(true);
 };
 
 }  // namespace vda5050pp::core::logic
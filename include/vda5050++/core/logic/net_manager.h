@@ -10,18 +10,22 @@
 #ifndef INCLUDE_VDA5050_2B_2B_CORE_LOGIC_NET_MANAGER
 #define INCLUDE_VDA5050_2B_2B_CORE_LOGIC_NET_MANAGER
 
+#include <atomic>
 #include <functional>
 #include <list>
 #include <map>
 #include <memory>
-#include <set>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "../../model/Order.h"
 #include "action_manager.h"
 #include "continuous_navigation_manager.h"
 #include "drive_to_node_manager.h"
+#include "net_trace.h"
+#include "partial_net.h"
 #include "types.h"
 
 /// Forward declaration of Handle, to avoid cyclic dependencies
@@ -36,19 +40,64 @@ namespace vda5050pp::core::logic {
 ///
 class NetManager {
 private:
+  ///
+  ///\brief All partial nets and managers of a single time step.
+  ///
+  /// A time step is removed from the net, once its tail place was left and all of its tasks
+  /// exited. Intercepting actions are added to the latest time step.
+  ///
+  struct TimeStep {
+    ///\brief the places added to the net
+    std::vector<LogicTaskNetID> place_ids;
+    ///\brief the transitions added to the net
+    std::vector<LogicTaskNetID> transition_ids;
+    ///\brief the exited places of all tasks of this step
+    std::vector<std::shared_ptr<Net::PlaceT>> exited_places;
+    ///\brief the failed places of the tasks of this step (without intercepting actions)
+    std::vector<std::shared_ptr<Net::PlaceT>> fail_places;
+    ///\brief the finished places of the tasks of this step (without intercepting actions)
+    std::vector<std::shared_ptr<Net::PlaceT>> finish_places;
+    ///\brief the action managers owned by this step
+    std::vector<std::pair<std::string, std::shared_ptr<ActionManager>>> action_managers;
+    ///\brief the drive to node managers owned by this step
+    std::vector<std::pair<uint32_t, std::shared_ptr<DriveToNodeManager>>> drive_to_node_managers;
+    ///\brief the continuous navigation steps (owner, node seq), the owner keeps them until the
+    ///       time step is collected
+    std::vector<std::pair<ContinuousNavigationManager *, uint32_t>> continuous_navigation_steps;
+    ///\brief the place, which is launching the next time step
+    std::shared_ptr<Net::PlaceT> tail_place;
+    ///\brief was a token taken from the tail place (i.e. the next step was launched)
+    bool left = false;
+  };
+
+  ///\brief managers indexed by their address
+  template <typename ManagerT>
+  using ManagerIndex = std::unordered_map<const TaskManager *, std::shared_ptr<ManagerT>>;
+
   Net net_;
   SeqNrT next_seq_ = 0;
 
   std::shared_ptr<Net::PlaceT> tail_place_;
-  std::vector<std::shared_ptr<Net::PlaceT>> fail_places_;
-  std::vector<std::shared_ptr<Net::PlaceT>> finish_places_;
-  std::set<LogicTaskNetID> un_exited_ids_;
+  std::unordered_set<LogicTaskNetID> un_exited_ids_;
+  std::list<TimeStep> time_steps_;
+  ///\brief transitions added since the last tick, which may already be enabled
+  std::vector<LogicTaskNetID> pending_transitions_;
+  ///\brief is an interpretation of the next window queued?
+  std::atomic_bool interpretation_pending_ = false;
 
   std::list<std::shared_ptr<ContinuousNavigationManager>> continuous_navigation_managers_;
   std::map<std::string, std::shared_ptr<ActionManager>, std::less<>> action_managers_by_id_;
   std::map<uint32_t, std::shared_ptr<DriveToNodeManager>> drive_to_node_managers_by_id_;
 
+  // The managers, which were not entered yet and the managers, which were entered, but did
+  // not exit yet. Fanning out to them only touches the live tasks, not all of the order.
+  ManagerIndex<ActionManager> pending_action_managers_;
+  ManagerIndex<ActionManager> active_action_managers_;
+  ManagerIndex<DriveToNodeManager> pending_drive_to_node_managers_;
+  ManagerIndex<DriveToNodeManager> active_drive_to_node_managers_;
+
   vda5050pp::interface_agv::Handle &handle_;
+  NetTrace &trace_;
 
   std::function<void(bool)> on_driving_changed_;
   std::function<void(void)> on_tail_reached_;
@@ -95,6 +144,84 @@ private:
   void interpretEdgeThenNode(const vda5050pp::Edge &edge,
                              const vda5050pp::Node &node) noexcept(false);
 
+  ///
+  ///\brief Add a new manager to the pending index, it is moved to the active index once it
+  ///       was entered and removed once it exited
+  ///
+  ///\param mgr the new manager (before it was attached to the net)
+  ///\param pending the pending index
+  ///\param active the active index
+  ///
+  template <typename ManagerT>
+  void index(const std::shared_ptr<ManagerT> &mgr, ManagerIndex<ManagerT> &pending,
+             ManagerIndex<ManagerT> &active) noexcept(false);
+
+  ///
+  ///\brief Interpret the base, until the look-ahead window of the handle is filled
+  ///
+  void interpretWindow() noexcept(false);
+
+  ///
+  ///\brief Get the number of time steps, which were not left yet
+  ///
+  ///\return std::size_t the number of steps ahead of the vehicle
+  ///
+  std::size_t numStepsAhead() const noexcept(true);
+
+  ///
+  ///\brief Is a part of the base not interpreted yet?
+  ///
+  ///\return is anything left to interpret?
+  ///
+  bool hasUninterpreted() const noexcept(true);
+
+  ///
+  ///\brief Queue the interpretation of the next window (once), if anything is left to interpret.
+  ///       The net is not extended from within a firing.
+  ///
+  void scheduleInterpretation() noexcept(true);
+
+  ///
+  ///\brief Fail the actions of the uninterpreted base and mark it as interpreted
+  ///
+  void skipUninterpreted() noexcept(true);
+
+  ///
+  ///\brief Add the initial done place of the net as the first time step
+  ///
+  void addInitialTimeStep() noexcept(true);
+
+  ///
+  ///\brief Add the places and transitions of a partial net to a time step.
+  ///       The transitions are checked during the next tick.
+  ///
+  ///\param step the time step
+  ///\param partial_net the partial net, which was attached to the net
+  ///
+  void addToTimeStep(TimeStep &step, const PartialNet &partial_net) noexcept(true);
+
+  ///
+  ///\brief Add a task manager to a time step. The step is only collected once it exited.
+  ///
+  ///\param step the time step
+  ///\param mgr the manager, which was attached to the net
+  ///
+  void addToTimeStep(TimeStep &step, const TaskManager &mgr) noexcept(true);
+
+  ///
+  ///\brief Set the tail place of a time step and make it the tail place of the net
+  ///
+  ///\param step the (latest) time step
+  ///\param tail_place the new tail place
+  ///
+  void setTailPlace(TimeStep &step, std::shared_ptr<Net::PlaceT> tail_place) noexcept(true);
+
+  ///
+  ///\brief Remove all time steps, which were left and whose tasks exited, from the net.
+  ///       The managers of removed steps are released after their pending tasks ran.
+  ///
+  void collectGarbage() noexcept(true);
+
 public:
   ///
   ///\brief Construct a new Net Manager object
@@ -108,6 +235,9 @@ public:
   ///       When the PTN was extended, then the state.graph_interpreted_seq
   ///       is incremented
   ///
+  /// Only the look-ahead window (see Handle::setInterpretationWindow) is interpreted, the
+  /// window is extended each time the vehicle leaves a time step.
+  ///
   void interpret() noexcept(false);
 
   ///
@@ -116,7 +246,12 @@ public:
   void clear() noexcept(true);
 
   ///
-  ///\brief Tick the net once to fire automatic transitions (Time steps)
+  ///\brief Fire the automatic transitions added since the last tick (Time steps).
+  ///       Afterwards the time steps, which are not needed anymore, are removed from the net.
+  ///
+  /// Transitions, which were already in the net, are fired by the transition, which put a
+  /// token in their ingoing places (deepFire), so a tick only depends on the added transitions
+  /// and not on the size of the net.
   ///
   void tick() noexcept(true);
 
@@ -156,6 +291,29 @@ public:
   ///
   bool isActionActive(const std::string &action_id) noexcept(false);
 
+  ///
+  ///\brief Get the manager of an action, which is still in the net
+  ///
+  ///\param action_id the actions ID
+  ///\return ActionManager* the manager (valid until the next tick) or nullptr on unknown ids
+  ///
+  ActionManager *findActionManager(const std::string &action_id) const noexcept(true);
+
+  ///
+  ///\brief Get the number of continuous navigation managers, which were not released yet
+  ///
+  ///\return std::size_t
+  ///
+  std::size_t numContinuousNavigationManagers() const noexcept(true);
+
+  ///
+  ///\brief Stop the action identified by the given ID, if it is still in the net and active
+  ///
+  ///\param action_id the actions ID
+  ///\return was the action stopped?
+  ///
+  bool stopActionIfActive(const std::string &action_id) noexcept(true);
+
   ///
   ///\brief Pause all running Tasks
   ///
@@ -177,7 +335,7 @@ public:
   void cancelAll() noexcept(true);
 
   ///
-  ///\brief cancel all pending tasks
+  ///\brief cancel all pending tasks (the actions of the uninterpreted base fail)
   ///
   void cancelAllPending() noexcept(true);
 
@@ -233,9 +391,25 @@ public:
   /// \brief pause all driving managers
   void resumeDriving() noexcept(true);
 
-  uint32_t nextSeq() noexcept(true);
+  ///
+  ///\brief Get a new sequence number for a task of the net
+  ///
+  ///\return SeqNrT the sequence number
+  ///
+  SeqNrT nextSeq() noexcept(true);
 
-  void registerNewTaskManager(TaskManager &mgr,
+  ///
+  ///\brief Attach a step of a ContinuousNavigationManager as a new time step
+  ///
+  /// Once the time step is collected, the step is released from its owner and the owner itself
+  /// is released, when it was finalized and has no steps left.
+  ///
+  ///\param owner the ContinuousNavigationManager owning the step
+  ///\param mgr the step
+  ///\param cancel_ids the actions to cancel, when the step is done
+  ///
+  void registerNewTaskManager(ContinuousNavigationManager &owner,
+                              ContinuousNavigationSingleStepTask &mgr,
                               std::vector<std::string> &&cancel_ids) noexcept(true);
 
   ///
@@ -253,20 +427,34 @@ public:
   const std::shared_ptr<Net::PlaceT> &getTailPlace() const noexcept(true);
 
   ///
-  ///\brief Get all finished Places of Tasks
+  ///\brief Get all finished Places of Tasks, which are still in the net
   ///
-  ///\return const std::vector<std::shared_ptr<Net::PlaceT>>&
+  ///\return std::vector<std::shared_ptr<Net::PlaceT>>
   ///
-  const std::vector<std::shared_ptr<Net::PlaceT>> &getFinishPlaces() const noexcept(true);
+  std::vector<std::shared_ptr<Net::PlaceT>> getFinishPlaces() const noexcept(false);
 
   ///
-  ///\brief Get the Fail Places of Tasks
+  ///\brief Get the Fail Places of Tasks, which are still in the net
   ///
-  ///\return const std::vector<std::shared_ptr<Net::PlaceT>>&
+  ///\return std::vector<std::shared_ptr<Net::PlaceT>>
   ///
-  const std::vector<std::shared_ptr<Net::PlaceT>> &getFailPlaces() const noexcept(true);
+  std::vector<std::shared_ptr<Net::PlaceT>> getFailPlaces() const noexcept(false);
 
   void notifyHorizonChanged() noexcept(true);
+
+  ///
+  ///\brief Get the logic PTN
+  ///
+  ///\return const Net&
+  ///
+  const Net &getNet() const noexcept(true);
+
+  ///
+  ///\brief Get the firing trace of the logic PTN
+  ///
+  ///\return NetTrace&
+  ///
+  NetTrace &getNetTrace() noexcept(true);
 };
 
 }  // namespace vda5050pp::core::logic
@@ -0,0 +1,102 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains the NetTemplate declaration
+//
+
+#ifndef INCLUDE_VDA5050_2B_2B_CORE_LOGIC_NET_TEMPLATE_HPP_
+#define INCLUDE_VDA5050_2B_2B_CORE_LOGIC_NET_TEMPLATE_HPP_
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "vda5050++/core/logic/types.h"
+
+namespace vda5050pp::core::logic {
+
+///
+///\brief A place of a NetTemplate, the ID is the type and the seq of the instance
+///
+struct PlaceTemplate {
+  LogicTaskNetTypes type;
+  Net::TokenCounterT tokens;
+};
+
+///
+///\brief A transition of a NetTemplate. All arcs have the weight 1 and connect places of the
+/// same instance.
+///
+struct TransitionTemplate {
+  static constexpr std::size_t k_max_arcs = 3;
+
+  LogicTaskNetTypes type;
+  std::array<LogicTaskNetTypes, k_max_arcs> ingoing;
+  uint8_t num_ingoing;
+  std::array<LogicTaskNetTypes, k_max_arcs> outgoing;
+  uint8_t num_outgoing;
+  bool auto_fire;
+};
+
+///
+///\brief An immutable partial net with a fixed shape, which is instantiated for a seq number.
+///
+/// The places and transitions are compiled once, instantiating it adds them directly to the
+/// composed net (without building and merging an intermediate net).
+///
+class NetTemplate {
+private:
+  const PlaceTemplate *places_;
+  std::size_t num_places_;
+  const TransitionTemplate *transitions_;
+  std::size_t num_transitions_;
+
+public:
+  ///
+  ///\brief Create a new NetTemplate from static tables
+  ///
+  ///\param places the places of the template
+  ///\param transitions the transitions of the template
+  ///
+  template <std::size_t P, std::size_t T>
+  constexpr NetTemplate(const PlaceTemplate (&places)[P],
+                        const TransitionTemplate (&transitions)[T]) noexcept(true)
+      : places_(places), num_places_(P), transitions_(transitions), num_transitions_(T) {}
+
+  ///
+  ///\brief Add an instance of the template to a net
+  ///
+  ///\param composed_net the net to add the instance to
+  ///\param seq the seq of all IDs of the instance
+  ///\param on_change installed at each place of the instance (if not nullptr)
+  ///\throws std::invalid_argument when an ID of the instance already exists
+  ///
+  void instantiate(
+      Net &composed_net, SeqNrT seq,
+      const std::function<void(const Net::PlaceT &, Net::TokenCounterT)> &on_change = nullptr) const
+      noexcept(false);
+
+  ///
+  ///\brief Get the IDs of all places and transitions of an instance
+  ///
+  ///\param seq the seq of the instance
+  ///\param places the place IDs are appended to this
+  ///\param transitions the transition IDs are appended to this
+  ///
+  void getIDs(SeqNrT seq, std::vector<LogicTaskNetID> &places,
+              std::vector<LogicTaskNetID> &transitions) const noexcept(false);
+
+  ///\brief the number of places of an instance
+  std::size_t numPlaces() const noexcept(true);
+
+  ///\brief the number of transitions of an instance
+  std::size_t numTransitions() const noexcept(true);
+};
+
+}  // namespace vda5050pp::core::logic
+
+#endif  // INCLUDE_VDA5050_2B_2B_CORE_LOGIC_NET_TEMPLATE_HPP_
@@ -0,0 +1,207 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains the NetTrace declaration
+//
+
+#ifndef INCLUDE_VDA5050_2B_2B_CORE_LOGIC_NET_TRACE_HPP_
+#define INCLUDE_VDA5050_2B_2B_CORE_LOGIC_NET_TRACE_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+#include "vda5050++/core/logic/types.h"
+
+namespace vda5050pp::core::logic {
+
+///
+///\brief An optional ring buffer of transition firings and place changes of the logic net.
+///
+/// While disabled, recording costs a single atomic load. While enabled, recording an event
+/// claims a slot with an atomic increment and does not take a lock. Once the buffer is full,
+/// the oldest events are overwritten. The recorded events can be exported as Chrome trace JSON,
+/// which can be opened in chrome://tracing or https://ui.perfetto.dev.
+///
+/// Places are only recorded, if they were added to the net while the trace was enabled, so
+/// a disabled trace does not cost anything at the places. Transitions are recorded, when they
+/// are fired via fire() or deepFire(). SimplePTN has no hook for the automatic transitions,
+/// which Transition::deepFire() fires in a cascade. While enabled, the Net indexes the arcs of
+/// the added transitions, and deepFire() fires (and records) the cascade itself in the order of
+/// Transition::deepFire(). Cascades through parts of the net, which were added while the trace
+/// was disabled, are left to Transition::deepFire() and only visible through their places.
+///
+class NetTrace {
+public:
+  using PlaceHook = std::function<void(const Net::PlaceT &, Net::TokenCounterT)>;
+
+  enum class EventType : uint8_t {
+    k_place,
+    k_transition,
+  };
+
+  struct Event {
+    ///\brief steady clock time in ns
+    int64_t time_ns;
+    ///\brief the thread id (as seen by the OS)
+    int64_t thread;
+    ///\brief the ID of the place or transition
+    LogicTaskNetID id;
+    EventType type;
+    ///\brief tokens after the change (only places)
+    Net::TokenCounterT tokens;
+    ///\brief tokens before the change (only places)
+    Net::TokenCounterT prev_tokens;
+  };
+
+private:
+  ///\brief An event slot, which can be written and read concurrently (sequence lock)
+  struct Slot {
+    ///\brief index + 1 of the event in this slot, 0 while it is written
+    std::atomic<uint64_t> stamp = 0;
+    std::atomic<int64_t> time_ns = 0;
+    std::atomic<int64_t> thread = 0;
+    ///\brief LogicTaskNetID::key()
+    std::atomic<uint64_t> key = 0;
+    ///\brief type | tokens << 8 | prev_tokens << 16
+    std::atomic<uint32_t> data = 0;
+  };
+
+  struct Ring {
+    explicit Ring(std::size_t capacity);
+    std::unique_ptr<Slot[]> slots;
+    std::size_t capacity;
+    ///\brief the index of the next recorded event
+    std::atomic<uint64_t> next = 0;
+  };
+
+  std::atomic_bool enabled_ = false;
+  ///\brief incremented by enable() and disable()
+  std::atomic<uint64_t> epoch_ = 0;
+  ///\brief the current ring (nullptr until the first enable())
+  std::atomic<Ring *> ring_ = nullptr;
+
+  ///\brief guards rings_
+  std::mutex rings_mutex_;
+  ///\brief all rings created by enable(), a recording thread may still write into an old one
+  std::vector<std::unique_ptr<Ring>> rings_;
+
+  void record(const Event &event) noexcept(true);
+
+public:
+  ///
+  ///\brief Start recording into a new ring buffer (discards all recorded events)
+  ///
+  /// The previous buffer is kept until the trace is destroyed, because other threads may still
+  /// record into it.
+  ///
+  ///\param capacity the number of events kept
+  ///\throws std::invalid_argument when capacity is 0
+  ///
+  void enable(std::size_t capacity) noexcept(false);
+
+  ///
+  ///\brief Stop recording (the recorded events are kept)
+  ///
+  void disable() noexcept(true);
+
+  ///
+  ///\brief Is the trace recording?
+  ///
+  ///\return is enabled?
+  ///
+  bool isEnabled() const noexcept(true);
+
+  ///
+  ///\brief Get the epoch of the trace, which changes with each enable() and disable()
+  ///
+  /// Arcs indexed in the current epoch were added, while the trace was continuously enabled.
+  ///
+  ///\return uint64_t the epoch
+  ///
+  uint64_t getEpoch() const noexcept(true);
+
+  ///
+  ///\brief Record a place change (if enabled)
+  ///
+  ///\param place the changed place
+  ///\param prev the tokens before the change
+  ///
+  void recordPlace(const Net::PlaceT &place, Net::TokenCounterT prev) noexcept(true);
+
+  ///
+  ///\brief Record a fired transition (if enabled)
+  ///
+  ///\param id the ID of the transition
+  ///
+  void recordTransition(const LogicTaskNetID &id) noexcept(true);
+
+  ///
+  ///\brief Fire a transition and record it (if enabled), if it fired
+  ///
+  ///\param transition the transition
+  ///\return did it fire?
+  ///
+  bool fire(Net::TransitionT &transition) noexcept(true);
+
+  ///
+  ///\brief Fire a transition and the cascade of automatic transitions enabled by it
+  ///       (Transition::deepFire()), recording each fired transition (if enabled)
+  ///
+  ///\param net the net of the transition (its indexed arcs are used)
+  ///\param transition the transition
+  ///\return did it fire?
+  ///
+  bool deepFire(const Net &net, Net::TransitionT &transition) noexcept(true);
+
+  ///
+  ///\brief Wrap a place hook, such that each change is recorded before fn is called
+  ///
+  ///\param fn the hook
+  ///\return PlaceHook the hook to install at the place (fn itself, if disabled)
+  ///
+  PlaceHook traced(PlaceHook fn) noexcept(false);
+
+  ///
+  ///\brief Get a hook for places without a hook of their own
+  ///
+  ///\return PlaceHook a recording hook, if enabled, otherwise nullptr
+  ///
+  PlaceHook hook() noexcept(false);
+
+  ///
+  ///\brief Get the recorded events, oldest first
+  ///
+  ///\return std::vector<Event>
+  ///
+  std::vector<Event> getEvents() const noexcept(false);
+
+  ///
+  ///\brief Get the number of events, which were overwritten since enable()
+  ///
+  ///\return uint64_t the number of dropped events
+  ///
+  uint64_t getDropped() const noexcept(true);
+
+  ///
+  ///\brief Write the recorded events in the Chrome trace event format (JSON)
+  ///
+  /// Places are async slices (from receiving a token until they are empty again), transitions
+  /// are instant events on the firing thread. Changes of places without an open slice are
+  /// omitted (i.e. the begin of the slice was overwritten in the ring buffer).
+  ///
+  ///\param os the stream to write to
+  ///
+  void writeChromeTrace(std::ostream &os) const noexcept(false);
+};
+
+}  // namespace vda5050pp::core::logic
+
+#endif  // INCLUDE_VDA5050_2B_2B_CORE_LOGIC_NET_TRACE_HPP_
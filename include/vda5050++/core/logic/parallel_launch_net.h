@@ -49,7 +49,17 @@ public:
   ///
   const std::vector<LogicTaskNetID> &getLaunchIds() const noexcept(true);
 
+  ///
+  ///\brief Get the NetID of the launch transition
+  ///
+  ///\return LogicTaskNetID
+  ///
+  LogicTaskNetID getTransitionID() const noexcept(true);
+
   virtual void attachToNet(Net &composed_net) noexcept(false) override;
+
+  void getOwnIDs(std::vector<LogicTaskNetID> &places,
+                 std::vector<LogicTaskNetID> &transitions) const noexcept(false) override;
 };
 
 }  // namespace vda5050pp::core::logic
@@ -10,6 +10,8 @@
 #ifndef INCLUDE_VDA5050_2B_2B_CORE_LOGIC_PARTIAL_NET_HPP_
 #define INCLUDE_VDA5050_2B_2B_CORE_LOGIC_PARTIAL_NET_HPP_
 
+#include <vector>
+
 #include "vda5050++/core/logic/types.h"
 
 namespace vda5050pp::core::logic {
@@ -27,6 +29,17 @@ public:
   ///\param composed_net the global composed net
   ///
   virtual void attachToNet(Net &composed_net) noexcept(false) = 0;
+
+  ///
+  ///\brief Get the IDs of all places and transitions, which were added by attachToNet
+  ///
+  /// These can be removed from the composed net, once the partial net is not needed anymore.
+  ///
+  ///\param places the place IDs are appended to this
+  ///\param transitions the transition IDs are appended to this
+  ///
+  virtual void getOwnIDs(std::vector<LogicTaskNetID> &places,
+                         std::vector<LogicTaskNetID> &transitions) const noexcept(false) = 0;
 };
 
 }  // namespace vda5050pp::core::logic
@@ -26,6 +26,8 @@ private:
   LogicTaskNetID transition_id_;
   std::vector<LogicTaskNetID> sync_ids_;
   LogicTaskNetID place_id_;
+  ///\brief was the sync place created by attachToNet
+  bool owns_place_ = false;
 
   void initTransitionID();
 
@@ -63,6 +65,9 @@ public:
   const std::vector<LogicTaskNetID> &getSyncIDs() const noexcept(true);
 
   virtual void attachToNet(Net &composed_net) noexcept(false) override;
+
+  void getOwnIDs(std::vector<LogicTaskNetID> &places,
+                 std::vector<LogicTaskNetID> &transitions) const noexcept(false) override;
 };
 
 }  // namespace vda5050pp::core::logic
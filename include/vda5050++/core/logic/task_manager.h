@@ -12,6 +12,7 @@
 
 #include <functional>
 
+#include "vda5050++/core/logic/net_trace.h"
 #include "vda5050++/core/logic/partial_net.h"
 #include "vda5050++/core/logic/types.h"
 
@@ -32,6 +33,9 @@ protected:
 
 private:
   SeqNrT seq_;
+  NetTrace &trace_;
+  ///\brief the net this task is attached to (set by attachToNet)
+  const Net *net_ = nullptr;
 
   std::shared_ptr<Net::TransitionT> transition_initializing_fail_;
   std::shared_ptr<Net::TransitionT> transition_running_fail_;
@@ -53,6 +57,18 @@ private:
   std::shared_ptr<Net::PlaceT> place_entered_;
   std::shared_ptr<Net::PlaceT> place_exited_;
 
+  std::function<void(LogicTaskNetID exit_id)> on_exited_;
+  std::function<void(bool active)> on_active_changed_;
+
+  ///
+  ///\brief Fire a transition and record it in the NetTrace, if it fired
+  ///
+  ///\param transition the transition to fire
+  ///\param deep also fire (and record) the automatic transitions enabled by it (deepFire)
+  ///\return did it fire?
+  ///
+  bool fireTraced(Net::TransitionT &transition, bool deep = true) noexcept(true);
+
   ///
   ///\brief This will be called each transition, for logging purposes
   ///
@@ -115,6 +131,9 @@ public:
   ///
   virtual void attachToNet(Net &composed_net) noexcept(false) override;
 
+  void getOwnIDs(std::vector<LogicTaskNetID> &places,
+                 std::vector<LogicTaskNetID> &transitions) const noexcept(false) override;
+
   ///
   ///\brief get the PTN ID for the associated readyPlace
   ///
@@ -150,6 +169,27 @@ public:
   ///
   LogicTaskNetID exitedPlace() const noexcept(true);
 
+  ///
+  ///\brief get the associated failed place of the net (set by attachToNet)
+  ///
+  ///\return const std::shared_ptr<Net::PlaceT>&
+  ///
+  const std::shared_ptr<Net::PlaceT> &failedPlacePtr() const noexcept(true);
+
+  ///
+  ///\brief get the associated finished place of the net (set by attachToNet)
+  ///
+  ///\return const std::shared_ptr<Net::PlaceT>&
+  ///
+  const std::shared_ptr<Net::PlaceT> &finishedPlacePtr() const noexcept(true);
+
+  ///
+  ///\brief get the associated exited place of the net (set by attachToNet)
+  ///
+  ///\return const std::shared_ptr<Net::PlaceT>&
+  ///
+  const std::shared_ptr<Net::PlaceT> &exitedPlacePtr() const noexcept(true);
+
   ///
   /// \brief get the PTN ID for the associated intercepting output
   /// which yields the flow to the intercepting task
@@ -169,12 +209,17 @@ public:
   ///
   /// \brief Notify when the task was exited
   ///
-  /// NOTE: the manager hat to be attached to a net before (mgr.attachToNet())
-  ///
   /// \param fn the function to notify
   ///
   void onExited(std::function<void(LogicTaskNetID exit_id)> fn) noexcept(true);
 
+  ///
+  /// \brief Notify when the task was entered (true) and when it was exited (false)
+  ///
+  /// \param fn the function to notify
+  ///
+  void onActiveChanged(std::function<void(bool active)> fn) noexcept(true);
+
   ///
   ///\brief Try to reach the paused state of the net
   ///
@@ -11,11 +11,23 @@
 #define INCLUDE_VDA5050_2B_2B_CORE_LOGIC_TYPES_HPP_
 
 #include <SimplePTN/petri_net.hpp>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <ostream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace vda5050pp::core::logic {
 
-using SeqNrT = uint16_t;
+///
+///\brief The sequence number of a task in the logic net.
+///
+/// Sequence numbers are never reused while an order is appended (the IDs are ordered by them),
+/// so 32 bit are used. At 1000 tasks per second it takes more than 49 days to exhaust them.
+///
+using SeqNrT = uint32_t;
 
 enum class LogicTaskNetTypes {
   k_ready,
@@ -68,20 +80,110 @@ enum class LogicTaskNetTypes {
   k_combinator_dangling_transition,
 };
 
+static_assert(static_cast<int>(LogicTaskNetTypes::k_combinator_dangling_transition) < 256,
+              "LogicTaskNetTypes must fit into the lowest byte of LogicTaskNetID::key()");
+
 struct LogicTaskNetID {
   LogicTaskNetTypes type;
   SeqNrT seq;
 
+  ///
+  ///\brief Pack the ID into a single integer (seq in the upper bits, type in the lowest byte).
+  ///       Keys are ordered like the IDs, so comparisons and hashing only need one integer.
+  ///
+  ///\return uint64_t the key
+  ///
+  constexpr uint64_t key() const {
+    return (static_cast<uint64_t>(this->seq) << 8) | static_cast<uint8_t>(this->type);
+  }
+
   constexpr bool operator==(const LogicTaskNetID &other) const {
-    return this->type == other.type && this->seq == other.seq;
+    return this->key() == other.key();
   }
 
   constexpr bool operator<(const LogicTaskNetID &other) const {
-    return this->seq < other.seq || (this->seq == other.seq && this->type < other.type);
+    return this->key() < other.key();
   }
 };
 
-using Net = sptn::PetriNet<LogicTaskNetID, uint8_t>;
+class NetTrace;
+
+///
+///\brief The composed petri net of the logic
+///
+/// SimplePTN has no hook for fired transitions. While a NetTrace is set and enabled, the net
+/// indexes the arcs of the added transitions, such that the NetTrace can fire the automatic
+/// transitions of a cascade itself (see NetTrace::deepFire) and record them.
+///
+class Net : public sptn::PetriNet<LogicTaskNetID, uint8_t> {
+public:
+  ///\brief The transitions consuming from a place
+  struct Consumers {
+    ///\brief NetTrace::getEpoch() when the place was added
+    uint64_t epoch;
+    ///\brief the transitions in the order they were added
+    std::vector<std::weak_ptr<TransitionT>> transitions;
+  };
+
+  ///\brief The arcs of the places and transitions added while the trace was enabled
+  struct Arcs {
+    ///\brief place key -> consuming transitions
+    std::unordered_map<uint64_t, Consumers> consumers;
+    ///\brief transition key -> outgoing places
+    std::unordered_map<uint64_t, std::vector<LogicTaskNetID>> outgoing;
+  };
+
+private:
+  using BaseT = sptn::PetriNet<LogicTaskNetID, uint8_t>;
+
+  NetTrace *trace_ = nullptr;
+  Arcs arcs_;
+
+public:
+  ///
+  ///\brief Set the trace, which decides, whether the arcs are indexed
+  ///
+  ///\param trace the trace (nullptr never indexes arcs)
+  ///
+  void setTrace(NetTrace *trace) noexcept(true);
+
+  ///
+  ///\brief Get the indexed arcs
+  ///
+  ///\return const Arcs&
+  ///
+  const Arcs &getArcs() const noexcept(true);
+
+  ///
+  ///\brief Add a place (and index it, if the trace is enabled)
+  ///
+  ///\param id the ID of the place
+  ///\param tokens the initial tokens
+  ///\return std::shared_ptr<PlaceT> the place
+  ///
+  std::shared_ptr<PlaceT> addPlace(const LogicTaskNetID &id, TokenCounterT tokens) noexcept(false);
+
+  ///
+  ///\brief Add a transition (and index its arcs, if the trace is enabled)
+  ///
+  ///\param sketch the sketch of the transition
+  ///
+  void addTransition(const TransitionSketch &sketch) noexcept(false);
+
+  ///
+  ///\brief Remove a place (and its index entry)
+  ///
+  ///\param id the ID of the place
+  ///
+  void removePlace(const LogicTaskNetID &id) noexcept(true);
+
+  ///
+  ///\brief Remove a transition (and its index entry)
+  ///
+  ///\param id the ID of the transition
+  ///
+  void removeTransition(const LogicTaskNetID &id) noexcept(true);
+};
 
 inline std::ostream &operator<<(std::ostream &os, const LogicTaskNetTypes &type) {
   switch (type) {
@@ -224,4 +326,12 @@ inline std::ostream &operator<<(std::ostream &os, const LogicTaskNetID &id) {
 }
 }  // namespace vda5050pp::core::logic
 
+namespace std {
+template <> struct hash<vda5050pp::core::logic::LogicTaskNetID> {
+  std::size_t operator()(const vda5050pp::core::logic::LogicTaskNetID &id) const noexcept {
+    return std::hash<uint64_t>()(id.key());
+  }
+};
+}  // namespace std
+
 #endif  // INCLUDE_VDA5050_2B_2B_CORE_LOGIC_TYPES_HPP_
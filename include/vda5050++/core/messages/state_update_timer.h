@@ -18,6 +18,7 @@
 #include <thread>
 
 #include "../common/interruptable_timer.h"
+#include "../common/shared_executor.h"
 #include "update_urgency.h"
 
 namespace vda5050pp::interface_agv {
@@ -30,6 +31,9 @@ namespace vda5050pp::core::messages {
 /// \brief The StateUpdateTimer Class has a thread, that periodically sends a new state.
 /// Upon requests this period might be decreased.
 ///
+/// If the Handle is attached to a SharedExecutor, there is no thread, the next update is
+/// scheduled as a timer on the executor instead.
+///
 class StateUpdateTimer {
 private:
   using TimePointT = std::chrono::system_clock::time_point;
@@ -44,8 +48,20 @@ private:
 
   vda5050pp::interface_agv::Handle &handle_;
 
+  std::shared_ptr<vda5050pp::core::common::SharedExecutor> executor_;
+  std::optional<vda5050pp::core::common::SharedExecutor::TimerId> executor_timer_;
+  /// \brief guards the update time points, if the timer runs on the executor
+  std::mutex executor_mutex_;
+
   void timerRoutine();
 
+  TimePointT nextWakeupTimePoint() const noexcept(true);
+
+  ///
+  /// \brief (Re)schedule the next update on the executor (executor_mutex_ held)
+  ///
+  void scheduleOnExecutor() noexcept(true);
+
 public:
   explicit StateUpdateTimer(vda5050pp::interface_agv::Handle &handle);
 
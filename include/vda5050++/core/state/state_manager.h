@@ -12,6 +12,7 @@
 
 #include <functional>
 #include <list>
+#include <optional>
 
 #include "vda5050++/core/state/state.h"
 #include "vda5050++/model/InstantActions.h"
@@ -47,6 +48,14 @@ public:
   ///
   vda5050pp::Action getActionById(const std::string &id) const noexcept(false);
 
+  ///
+  /// \brief Get an action by it's id, if it exists (for ids, which may legitimately be unknown)
+  ///
+  /// \param id the action's id
+  /// \return std::optional<vda5050pp::Action> std::nullopt on unknown id
+  ///
+  std::optional<vda5050pp::Action> tryGetActionById(const std::string &id) const noexcept(true);
+
   ///
   /// \brief Set the ActionStatus of an action
   ///
@@ -56,6 +65,15 @@ public:
   ///
   void setActionStatus(const std::string &id, vda5050pp::ActionStatus status) noexcept(false);
 
+  ///
+  /// \brief Set the ActionStatus of an action, if it exists
+  ///
+  /// \param id the action's id
+  /// \param status the status
+  /// \return was the id known?
+  ///
+  bool trySetActionStatus(const std::string &id, vda5050pp::ActionStatus status) noexcept(true);
+
   ///
   /// \brief Set the ActionResult of an action
   ///
@@ -365,6 +383,14 @@ public:
   ///
   vda5050pp::Node getNodeBySeq(uint32_t seq) const noexcept(false);
 
+  ///
+  /// \brief Get the Node with a certain sequenceId, if it exists
+  ///
+  /// \param seq
+  /// \return std::optional<vda5050pp::Node> std::nullopt if seq is not associated
+  ///
+  std::optional<vda5050pp::Node> tryGetNodeBySeq(uint32_t seq) const noexcept(true);
+
   ///
   /// \brief Get the Edge with a certain sequenceId
   ///
@@ -374,6 +400,14 @@ public:
   ///
   vda5050pp::Edge getEdgeBySeq(uint32_t seq) const noexcept(false);
 
+  ///
+  /// \brief Get the Edge with a certain sequenceId, if it exists
+  ///
+  /// \param seq
+  /// \return std::optional<vda5050pp::Edge> std::nullopt if seq is not associated
+  ///
+  std::optional<vda5050pp::Edge> tryGetEdgeBySeq(uint32_t seq) const noexcept(true);
+
   ///
   /// \brief Get the last sequenceId of the base
   ///
@@ -10,10 +10,12 @@
 #ifndef INCLUDE_VDA5050_2B_2B_CORE_VALIDATION_ACTION_DECLARED_VALIDATOR_HPP_
 #define INCLUDE_VDA5050_2B_2B_CORE_VALIDATION_ACTION_DECLARED_VALIDATOR_HPP_
 
+#include <memory>
 #include <optional>
 #include <string>
 
 #include "vda5050++/core/interface_agv/handle_accessor.h"
+#include "vda5050++/core/validation/action_validation_plan.h"
 #include "vda5050++/core/validation/validator.h"
 #include "vda5050++/model/Action.h"
 #include "vda5050++/model/Error.h"
@@ -26,7 +28,7 @@ namespace validation {
 ///
 class ActionDeclaredValidator : public vda5050pp::core::validation::Validator<vda5050pp::Action> {
 private:
-  vda5050pp::core::interface_agv::HandleAccessor handle_accessor_;
+  std::shared_ptr<const ActionValidationPlan> plan_;
 
   bool ctxt_edge_;
   bool ctxt_instant_;
@@ -34,7 +36,7 @@ private:
 
 public:
   ///
-  ///\brief Construct a new Action Declared Validator object
+  ///\brief Construct a new Action Declared Validator object (compiles the AGVDescription)
   ///
   ///\param handle
   ///\param ctxt_node in node context
@@ -44,6 +46,17 @@ public:
   ActionDeclaredValidator(vda5050pp::interface_agv::Handle &handle, bool ctxt_edge,
                           bool ctxt_instant, bool ctxt_node);
 
+  ///
+  ///\brief Construct a new Action Declared Validator object with an already compiled plan
+  ///
+  ///\param plan the compiled AGVDescription (shared by all contexts)
+  ///\param ctxt_node in node context
+  ///\param ctxt_instant in intant context
+  ///\param ctxt_edge in edge context
+  ///
+  ActionDeclaredValidator(std::shared_ptr<const ActionValidationPlan> plan, bool ctxt_edge,
+                          bool ctxt_instant, bool ctxt_node);
+
   ///
   ///\brief Run the check
   ///
@@ -0,0 +1,137 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains the ActionValidationPlan declaration
+//
+
+#ifndef INCLUDE_VDA5050_2B_2B_CORE_VALIDATION_ACTION_VALIDATION_PLAN_HPP_
+#define INCLUDE_VDA5050_2B_2B_CORE_VALIDATION_ACTION_VALIDATION_PLAN_HPP_
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "vda5050++/interface_agv/agv_description/agv_description.h"
+#include "vda5050++/interface_agv/agv_description/serialized_value.h"
+#include "vda5050++/model/BlockingType.h"
+
+namespace vda5050pp::core::validation {
+
+///
+///\brief An ordinal bound of a ParameterRange, numeric bounds are parsed once
+///
+/// Comparisons behave like the comparison of SerializedValues with the type of the bound.
+///
+class OrdinalBound {
+private:
+  vda5050pp::interface_agv::agv_description::SerializedValue bound_;
+  bool parsed_ = false;
+  int64_t integer_ = 0;
+  double float_ = 0.0;
+
+public:
+  ///
+  ///\brief Parse a bound (a bound, which cannot be parsed, fails each comparison)
+  ///
+  ///\param bound the serialized bound
+  ///
+  explicit OrdinalBound(
+      const vda5050pp::interface_agv::agv_description::SerializedValue &bound) noexcept(false);
+
+  ///
+  ///\brief Is a serialized value less than the bound (the bound is a minimum)?
+  ///
+  ///\param value the serialized value (with the type of the bound)
+  ///\throws std::exception when the value or the bound cannot be parsed
+  ///\return value < bound
+  ///
+  bool undercutBy(const std::string &value) const noexcept(false);
+
+  ///
+  ///\brief Is a serialized value greater than the bound (the bound is a maximum)?
+  ///
+  ///\param value the serialized value (with the type of the bound)
+  ///\throws std::exception when the value or the bound cannot be parsed
+  ///\return value > bound
+  ///
+  bool exceededBy(const std::string &value) const noexcept(false);
+};
+
+///
+///\brief The compiled ParameterRange of an action parameter
+///
+struct ParameterPlan {
+  ///\brief is the parameter mandatory?
+  bool mandatory;
+  ///\brief the allowed values (if it is enumerated)
+  std::optional<std::unordered_set<std::string>> value_set;
+  std::optional<OrdinalBound> ordinal_min;
+  std::optional<OrdinalBound> ordinal_max;
+};
+
+///
+///\brief The compiled ActionDeclaration of an action type
+///
+struct ActionPlan {
+  bool instant;
+  bool node;
+  bool edge;
+  ///\brief a bit for each allowed BlockingType
+  uint8_t blocking_types;
+  ///\brief the mandatory and optional parameters by key
+  std::unordered_map<std::string, ParameterPlan> parameters;
+  ///\brief the keys of the mandatory parameters (ordered)
+  std::vector<std::string> mandatory_keys;
+
+  ///
+  ///\brief Is the blocking type allowed?
+  ///
+  ///\param blocking_type the blocking type
+  ///\return allowed?
+  ///
+  bool allows(vda5050pp::BlockingType blocking_type) const noexcept(true);
+};
+
+///
+///\brief The supported actions of an AGVDescription (and the control actions), compiled once
+/// into hashed lookups with pre-parsed bounds
+///
+class ActionValidationPlan {
+private:
+  bool enabled_;
+  std::unordered_map<std::string, ActionPlan> actions_;
+
+public:
+  ///
+  ///\brief Compile the supported actions of an AGVDescription
+  ///
+  ///\param description the AGVDescription
+  ///
+  explicit ActionValidationPlan(
+      const vda5050pp::interface_agv::agv_description::AGVDescription &description) noexcept(false);
+
+  ///
+  ///\brief Are actions validated (does the AGVDescription declare supported actions)?
+  ///
+  ///\return enabled?
+  ///
+  bool isEnabled() const noexcept(true);
+
+  ///
+  ///\brief Find the plan of an action type
+  ///
+  ///\param action_type the action type
+  ///\return const ActionPlan* the plan or nullptr, when the type is not supported
+  ///
+  const ActionPlan *find(const std::string &action_type) const noexcept(true);
+};
+
+}  // namespace vda5050pp::core::validation
+
+#endif  // INCLUDE_VDA5050_2B_2B_CORE_VALIDATION_ACTION_VALIDATION_PLAN_HPP_
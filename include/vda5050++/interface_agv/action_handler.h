@@ -10,6 +10,8 @@
 #ifndef INCLUDE_VDA5050_2B_2B_INTERFACE_AGV_ACTION_HANDLER
 #define INCLUDE_VDA5050_2B_2B_INTERFACE_AGV_ACTION_HANDLER
 
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <utility>
 #include <vector>
@@ -46,10 +48,17 @@ private:
   ///       types)
   vda5050pp::interface_agv::Handle *handle_ = nullptr;
 
+  ///\brief The ActionManager of this handler, it is unset, when the manager is released
+  ///       (shared with copies, the mutex is held while calling into the manager)
+  struct ManagerReference {
+    std::recursive_mutex mutex;
+    vda5050pp::core::logic::ActionManager *manager = nullptr;
+  };
+
   ///\brief To avoid passing this via the constructor (and the interface)
   ///       the pointer is set later. (Sadly std::reference_wrapper does not support incomplete
   ///       types)
-  vda5050pp::core::logic::ActionManager *action_manager_ = nullptr;
+  std::shared_ptr<ManagerReference> action_manager_ = std::make_shared<ManagerReference>();
 
   ///\brief the concerning action
   vda5050pp::Action action_;
@@ -77,6 +86,12 @@ private:
   ///
   void setManagerReference(vda5050pp::core::logic::ActionManager &manager) noexcept(true);
 
+  ///
+  /// \brief Unset the Manager Reference object, when the ActionManager is released
+  /// NOTE: Blocks until running calls into the manager returned, later calls are ignored
+  ///
+  void unsetManagerReference() noexcept(true);
+
 protected:
   ///
   /// \brief Report an error associated with this action.
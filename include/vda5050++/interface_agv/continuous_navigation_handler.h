@@ -11,6 +11,8 @@
 #define INCLUDE_VDA5050_2B_2B_INTERFACE_AGV_CONTINUOUS_NAVIGATION_HANDLER
 
 #include <list>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include "vda5050++/core/common/math/linear_path_length_calculator.h"
@@ -49,10 +51,17 @@ private:
   ///       types)
   vda5050pp::interface_agv::Handle *handle_ = nullptr;
 
+  ///\brief The ContinuousNavigationManager of this handler, it is unset, when the manager is
+  ///       done with it (shared with copies, the mutex is held while calling into the manager)
+  struct ManagerReference {
+    std::recursive_mutex mutex;
+    vda5050pp::core::logic::ContinuousNavigationManager *manager = nullptr;
+  };
+
   ///\brief To avoid passing this via the constructor (and the interface)
   ///       the pointer is set later. (Sadly std::reference_wrapper does not support incomplete
   ///       types)
-  vda5050pp::core::logic::ContinuousNavigationManager *manager_ = nullptr;
+  std::shared_ptr<ManagerReference> manager_ = std::make_shared<ManagerReference>();
 
   ///\brief current base
   std::list<vda5050pp::Node> base_nodes_;
@@ -84,6 +93,12 @@ private:
   ///
   void setManager(vda5050pp::core::logic::ContinuousNavigationManager &mgr) noexcept(true);
 
+  ///
+  /// \brief Unset the manager, when it is done with this handler or released
+  /// NOTE: Blocks until running calls into the manager returned, later calls throw
+  ///
+  void unsetManager() noexcept(true);
+
   ///
   /// \brief Set the Initial Base
   ///
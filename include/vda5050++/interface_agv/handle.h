@@ -10,14 +10,20 @@
 #ifndef INCLUDE_VDA5050_2B_2B_INTERFACE_AGV_HANDLE
 #define INCLUDE_VDA5050_2B_2B_INTERFACE_AGV_HANDLE
 
+#include <atomic>
 #include <condition_variable>
 #include <list>
+#include <optional>
+#include <ostream>
 #include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
-#include "vda5050++/core/common/blocking_queue.h"
+#include "vda5050++/core/common/shared_executor.h"
+#include "vda5050++/core/common/thread_placement.h"
+#include "vda5050++/core/common/wakeup_fd.h"
+#include "vda5050++/core/common/work_stealing_executor.h"
 #include "vda5050++/core/logic/logic.h"
 #include "vda5050++/core/messages/messages.h"
 #include "vda5050++/core/state/state_manager.h"
@@ -83,22 +89,26 @@ public:
   /// this library. All configuration can be done via member functions
   ///
   ///\param agv_description the vehicle description to refer to
+  ///\param logger the logger of this Handle, also passed to the connector (the process-wide
+  /// Logger::setCurrentLogger is not changed, it is only used by code without a Handle)
+  ///\param executor if set, timers and pending tasks of the Handle run on this executor, which
+  /// may be shared with other Handles, instead of own threads. A
+  /// vda5050pp::core::common::SimulationExecutor runs the Handle in virtual time.
   ///
   template <typename Handlers, typename Connector>
   explicit Handle(const agv_description::AGVDescription &agv_description,
                   std::shared_ptr<Connector> connector, Handlers,
-                  std::shared_ptr<vda5050pp::interface_agv::Logger> logger = nullptr)
-      : shutdown_((Logger::setCurrentLogger(logger),
-                   false)),  // Workaround to initialize the logger before any component
+                  std::shared_ptr<vda5050pp::interface_agv::Logger> logger = nullptr,
+                  std::shared_ptr<vda5050pp::core::common::SharedExecutor> executor = nullptr)
+      : logger_(logger != nullptr ? logger : Logger::getNullLogger()),
+        shutdown_(false),
+        executor_(std::move(executor)),
         create_action_handler_(std::make_shared<typename Handlers::ActionHandler_>),
         create_pause_resume_handler_(std::make_shared<typename Handlers::PauseResumeHandler_>),
         agv_description_(agv_description),
         logic_(*this),
         validation_provider_(*this),
         messages_(*this) {
-    using namespace std::chrono_literals;
-    this->state_update_period_ = 30s;
-
     // Check Action and PauseResume Handler ////////////////////////////////////
     static_assert(
         std::is_base_of_v<ActionHandler, typename Handlers::ActionHandler_>,
@@ -139,9 +149,29 @@ public:
     if constexpr (std::is_base_of_v<vda5050pp::interface_mc::ConnectorPassive, Connector>) {
       this->connector_passive_ = connector;
       this->connector_ = this->connector_passive_;
+      this->connector_notifies_ =
+          this->connector_passive_->setWakeupNotifier([this] { this->connectorWakeup(); });
     } else {
       this->connector_ = connector;
     }
+    this->connector_->setLogger(this->logger_);
+
+    this->task_queue_.setPushNotifier([this] {
+      if (this->wakeup_fd_enabled_) {
+        this->wakeup_fd_.notify();
+      }
+      if (this->executor_ != nullptr) {
+        this->executor_->notify(this);
+      }
+    });
+
+    this->thread_registry_.setErrorHandler(
+        [this](const std::string &message) { this->logger_->logWarn(message); });
+    this->setThreadingConfig({});
+
+    if (this->executor_ != nullptr) {
+      this->attachExecutor();
+    }
 
     this->messages_.connect();
   }
@@ -169,16 +199,29 @@ public:
   void setStateUpdatePeriod(const std::chrono::system_clock::duration &period);
 
   ///
-  ///\brief Set the current logger. This sets the static Logger::current_logger_ instance.
+  ///\brief Set how many time steps of an order are interpreted ahead of the vehicle
+  ///       (default: 64, 0 interprets the whole base at once)
+  ///
+  /// The rest of the base is interpreted, while the vehicle leaves the interpreted steps.
+  ///
+  ///\param steps the number of time steps
+  ///
+  void setInterpretationWindow(std::size_t steps) noexcept(true);
+
+  ///
+  ///\brief Set the logger of this Handle and its connector (do not call it, while the library
+  /// is spinning)
   ///
-  ///\param logger
+  ///\param logger the logger (nullptr discards all messages)
   ///
-  void setLogger(std::shared_ptr<vda5050pp::interface_agv::Logger> logger) const;
+  void setLogger(std::shared_ptr<vda5050pp::interface_agv::Logger> logger);
 
   ///
   /// \brief Evaluate library calls and poll messages (if passive), until the library is shut down.
   /// NOTE: can be called by multiple threads for parallel handling (given
-  /// ConnectorPassive::spinOnce may run in parallel). Returns when the library is shut down
+  /// ConnectorPassive::spinOnce may run in parallel). Returns when the library is shut down.
+  /// While idle, the thread blocks until there is work, only passive connectors without
+  /// vda5050pp::interface_mc::ConnectorPassive::setWakeupNotifier are polled every 10ms.
   ///
   void spin() noexcept(true);
 
@@ -210,6 +253,74 @@ public:
   ///
   void shutdown() noexcept(true);
 
+  ///
+  ///\brief Get a file descriptor, which becomes readable, when there is work for the library
+  ///
+  /// This can be used to integrate the library into an external event loop (poll/epoll/select):
+  /// once the fd is readable, call spinAll() (or spinOnce()), which also resets the fd.
+  /// Passive connectors only wake the fd, if they support
+  /// vda5050pp::interface_mc::ConnectorPassive::setWakeupNotifier.
+  ///
+  ///\return int the fd (owned by the Handle)
+  ///
+  int getWakeupFd() noexcept(true);
+
+  ///
+  ///\brief Get the metrics of the task queue (i.e. depth and wait time per priority lane)
+  ///
+  ///\return vda5050pp::core::common::WorkStealingExecutor::Statistics
+  ///
+  vda5050pp::core::common::WorkStealingExecutor::Statistics getTaskStatistics() const
+      noexcept(true);
+
+  ///
+  ///\brief Set the names, CPU affinities and scheduling of all threads created by this Handle
+  ///
+  /// Applies to running and future threads. Threads of a shared executor are configured at the
+  /// executor (i.e. vda5050pp::core::common::ThreadPoolExecutor), threads of connectors at the
+  /// connector. Placements, which cannot be applied, are logged as warning.
+  ///
+  ///\param config the configuration
+  ///
+  void setThreadingConfig(const vda5050pp::core::common::ThreadingConfig &config) noexcept(false);
+
+  ///
+  ///\brief Get the actual placement of all running threads created by this Handle
+  ///
+  ///\return std::vector<vda5050pp::core::common::ThreadInfo>
+  ///
+  std::vector<vda5050pp::core::common::ThreadInfo> getThreadReport() const noexcept(false);
+
+  ///
+  ///\brief Get the current time of the library (the time of the executor, if attached)
+  ///
+  ///\return std::chrono::system_clock::time_point
+  ///
+  std::chrono::system_clock::time_point now() const noexcept(true);
+
+  ///
+  ///\brief Record the transition firings and place changes of the logic net into a ring buffer
+  ///
+  /// Enable it before the order is received, to record all places of its tasks.
+  ///
+  ///\param capacity the number of events kept (the oldest are overwritten)
+  ///\throws std::invalid_argument when capacity is 0
+  ///
+  void enableNetTrace(std::size_t capacity) noexcept(false);
+
+  ///
+  ///\brief Stop recording the logic net (the recorded events are kept)
+  ///
+  void disableNetTrace() noexcept(true);
+
+  ///
+  ///\brief Write the recorded events of the logic net as Chrome trace JSON
+  ///       (open it in chrome://tracing or https://ui.perfetto.dev)
+  ///
+  ///\param os the stream to write to
+  ///
+  void writeNetTrace(std::ostream &os) const noexcept(false);
+
   void setOdometryHandler(
       std::shared_ptr<vda5050pp::interface_agv::OdometryHandler> handler) noexcept(true);
 
@@ -225,7 +336,7 @@ public:
 private:
   class Spinner final {
   private:
-    bool stop_ = false;
+    std::atomic_bool stop_ = false;
     Handle &handle_;
     std::thread thread_;
     void spin();
@@ -235,8 +346,73 @@ private:
     ~Spinner();
   };
 
+  ///\brief the logger of this Handle (never nullptr)
+  std::shared_ptr<vda5050pp::interface_agv::Logger> logger_;
+
   ///\brief indicates shutdown of the library
-  bool shutdown_;
+  std::atomic_bool shutdown_;
+
+  ///
+  ///\brief Set shutdown_ and wake up all spinning threads and the wakeup fd
+  ///
+  void setShutdown() noexcept(true);
+
+  ///
+  ///\brief Wait for the next task of a spinning thread. Blocks without a timeout, unless the
+  /// passive connector has to be polled (fallback for connectors without setWakeupNotifier)
+  ///
+  ///\param cancelled returns true, if the spinning thread has to stop
+  ///\return std::optional<vda5050pp::core::common::Task> the task, if one was available
+  ///
+  std::optional<vda5050pp::core::common::Task> waitForTask(
+      const std::function<bool()> &cancelled) noexcept(true);
+
+  ///\brief all threads created by this Handle (outlives them)
+  vda5050pp::core::common::ThreadRegistry thread_registry_;
+
+  ///\brief runs timers and tasks, instead of own threads (may be nullptr)
+  std::shared_ptr<vda5050pp::core::common::SharedExecutor> executor_;
+
+  ///
+  ///\brief Attach to the executor (and schedule connector polls, if required)
+  ///
+  void attachExecutor() noexcept(false);
+
+  ///
+  ///\brief Schedule the next connector poll on the executor
+  ///
+  void scheduleExecutorPoll() noexcept(false);
+
+  ///
+  ///\brief Run all pending tasks (and poll the connector), called by the executor
+  ///
+  ///\return true if any task was run
+  ///
+  bool spinExecutor() noexcept(true);
+
+  ///\brief signaled on each task push, once getWakeupFd() was called
+  vda5050pp::core::common::WakeupFd wakeup_fd_;
+
+  ///\brief was the wakeup fd requested
+  std::atomic_bool wakeup_fd_enabled_ = false;
+
+  ///\brief does the passive connector call connectorWakeup, instead of beeing polled
+  bool connector_notifies_ = false;
+
+  ///\brief is a connector spinOnce task queued
+  std::atomic_bool connector_spin_pending_ = false;
+
+  ///
+  ///\brief Queue a single spinOnce call of the passive connector (coalesces multiple wakeups)
+  ///
+  void connectorWakeup() noexcept(true);
+
+  ///
+  ///\brief Poll the passive connector, if it does not notify the library by itself
+  ///
+  ///\return true if the connector is polled
+  ///
+  bool pollConnector() noexcept(true);
 
   std::vector<std::unique_ptr<Spinner>> spinners_;
 
@@ -249,7 +425,10 @@ private:
   std::shared_ptr<vda5050pp::interface_agv::OdometryHandler> odometry_handler_;
 
   ///\brief period of automatic state updates
-  std::chrono::system_clock::duration state_update_period_;
+  std::chrono::system_clock::duration state_update_period_ = std::chrono::seconds(30);
+
+  ///\brief number of time steps interpreted ahead of the vehicle (0 = unlimited)
+  std::size_t interpretation_window_ = 64;
 
   ///\brief functor for creating user handles
   std::function<std::shared_ptr<StepBasedNavigationHandler>()> create_navigate_to_node_handler_;
@@ -268,7 +447,7 @@ private:
   /// \brief The CallbackQueue contains all calls to Handlers, the are run by calling the spin
   /// functions
   ///
-  vda5050pp::core::common::BlockingQueue<std::function<void()>> task_queue_;
+  vda5050pp::core::common::WorkStealingExecutor task_queue_;
 
   ///
   ///\brief The description of the AGV using this library
@@ -21,25 +21,35 @@ enum class LogLevel { k_debug, k_info, k_warn, k_error, k_fatal };
 ///
 /// \brief Logger interface used by the library
 ///
+/// Each Handle has an own logger. The process-wide current logger is used by code, which is
+/// not associated with a Handle (i.e. connectors).
+///
 class Logger {
 private:
   static std::shared_ptr<Logger> current_logger_;
 
 public:
   ///
-  /// \brief Get the currently set logger
+  /// \brief Get the process-wide logger (thread-safe)
   ///
-  /// \return std::shared_ptr<Logger>
+  /// \return std::shared_ptr<Logger> the logger, or a logger discarding all messages
   ///
   static std::shared_ptr<Logger> getCurrentLogger();
 
   ///
-  /// \brief Overwrite the currently set logger
+  /// \brief Overwrite the process-wide logger (thread-safe)
   ///
   /// \param instance
   ///
   static void setCurrentLogger(std::shared_ptr<Logger> instance);
 
+  ///
+  /// \brief Get a logger, which discards all messages
+  ///
+  /// \return std::shared_ptr<Logger>
+  ///
+  static std::shared_ptr<Logger> getNullLogger();
+
   virtual ~Logger() = default;
 
   ///
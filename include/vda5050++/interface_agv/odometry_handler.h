@@ -7,12 +7,15 @@
 #define INCLUDE_VDA5050_2B_2B_INTERFACE_AGV_ODOMETRY_HANDLER_H_
 
 #include <chrono>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <stdexcept>
 #include <thread>
 
 #include "vda5050++/core/common/interruptable_timer.h"
+#include "vda5050++/core/common/shared_executor.h"
 #include "vda5050++/model/AGVPosition.h"
 #include "vda5050++/model/Velocity.h"
 
@@ -38,6 +41,21 @@ private:
 
   vda5050pp::core::common::InterruptableTimer visualization_timer_;
 
+  ///\brief the executor of the visualization timer, if the Handle uses a SharedExecutor
+  std::shared_ptr<vda5050pp::core::common::SharedExecutor> visualization_executor_;
+
+  std::optional<vda5050pp::core::common::SharedExecutor::TimerId> visualization_timer_id_;
+
+  ///\brief incremented on disable, such that a running timer does not reschedule itself
+  uint64_t visualization_generation_ = 0;
+
+  ///\brief guards the visualization timer members
+  std::mutex visualization_mutex_;
+
+  void scheduleVisualization(std::chrono::system_clock::time_point at,
+                             std::chrono::system_clock::duration period,
+                             uint64_t generation) noexcept(true);
+
 public:
   class InitializePositionError : public std::runtime_error {
   public:
@@ -81,6 +99,7 @@ public:
 
   ///
   ///\brief Starts a thread, which periodically sends Visualization Messages
+  /// (a timer on the SharedExecutor of the Handle, if set)
   ///
   ///\param period the message rate period
   ///
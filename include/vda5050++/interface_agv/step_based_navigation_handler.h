@@ -8,6 +8,8 @@
 #ifndef INCLUDE_VDA5050_2B_2B_INTERFACE_AGV_STEP_BASED_NAVIGATION_HANDLER
 #define INCLUDE_VDA5050_2B_2B_INTERFACE_AGV_STEP_BASED_NAVIGATION_HANDLER
 
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <vector>
 
@@ -44,10 +46,17 @@ private:
   ///       types)
   vda5050pp::interface_agv::Handle *handle_ = nullptr;
 
+  ///\brief The DriveToNodeManager of this handler, it is unset, when the manager is released
+  ///       (shared with copies, the mutex is held while calling into the manager)
+  struct ManagerReference {
+    std::recursive_mutex mutex;
+    vda5050pp::core::logic::DriveToNodeManager *manager = nullptr;
+  };
+
   ///\brief To avoid passing this via the constructor (and the interface)
   ///       the pointer is set later. (Sadly std::reference_wrapper does not support incomplete
   ///       types)
-  vda5050pp::core::logic::DriveToNodeManager *manager_ = nullptr;
+  std::shared_ptr<ManagerReference> manager_ = std::make_shared<ManagerReference>();
 
   ///\brief the associated goal node
   vda5050pp::Node goal_node_;
@@ -72,6 +81,12 @@ private:
   ///
   void setManager(vda5050pp::core::logic::DriveToNodeManager &manager) noexcept(true);
 
+  ///
+  /// \brief Unset the Manager Reference object, when the DriveToNodeManager is released
+  /// NOTE: Blocks until running calls into the manager returned, later calls are ignored
+  ///
+  void unsetManager() noexcept(true);
+
   ///
   /// \brief Set the Handle Reference object
   /// NOTE: Needs to be set after construction
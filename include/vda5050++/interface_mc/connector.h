@@ -12,6 +12,7 @@
 
 #include <memory>
 
+#include "vda5050++/interface_agv/logger.h"
 #include "vda5050++/interface_mc/message_consumer.h"
 #include "vda5050++/model/Connection.h"
 #include "vda5050++/model/State.h"
@@ -38,6 +39,19 @@ public:
   virtual void setConsumer(
       std::weak_ptr<vda5050pp::interface_mc::MessageConsumer> consumer) noexcept(true) = 0;
 
+  ///
+  ///\brief Set the logger of the Handle using this connector (called by the Handle)
+  ///
+  /// Connectors should log through this logger instead of the process-wide logger, so the
+  /// messages of a vehicle end up in the logger of its Handle. The default ignores it.
+  ///
+  ///\param logger the logger
+  ///
+  virtual void setLogger(std::shared_ptr<vda5050pp::interface_agv::Logger> logger) noexcept(
+      true) {
+    static_cast<void>(logger);
+  }
+
   ///\brief Queue a connection message for sending
   virtual void queueConnection(const vda5050pp::Connection &connection) noexcept(false) = 0;
 
@@ -10,6 +10,8 @@
 #ifndef INCLUDE_VDA5050_2B_2B_INTERFACE_MC_CONNECTOR_PASSIVE
 #define INCLUDE_VDA5050_2B_2B_INTERFACE_MC_CONNECTOR_PASSIVE
 
+#include <functional>
+
 #include "vda5050++/interface_mc/connector.h"
 
 namespace vda5050pp::interface_mc {
@@ -28,6 +30,21 @@ public:
   /// \brief poll messages once and pass them to the consumer
   ///
   virtual void spinOnce() noexcept(true) = 0;
+
+  ///
+  ///\brief Set a function, which has to be called (from any thread) whenever there are messages
+  /// to poll with spinOnce
+  ///
+  /// If the connector supports this (returns true), the library only calls spinOnce after
+  /// it was notified, instead of polling it each spin.
+  ///
+  ///\param notifier the function to call
+  ///\return true if the connector will call the notifier
+  ///\return false if the connector has to be polled (default)
+  ///
+  virtual bool setWakeupNotifier(std::function<void()> /*notifier*/) noexcept(true) {
+    return false;
+  }
 };
 
 }  // namespace vda5050pp::interface_mc
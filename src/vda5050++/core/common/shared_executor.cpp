@@ -0,0 +1,156 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains the implementation of the SharedExecutor
+//
+
+#include "vda5050++/core/common/shared_executor.h"
+
+using namespace vda5050pp::core::common;
+
+thread_local const void *SharedExecutor::current_key_ = nullptr;
+
+template <typename Fn>
+void SharedExecutor::runUnlocked(std::unique_lock<std::mutex> &lock, const void *key,
+                                 Fn &fn) noexcept(false) {
+  this->running_[key]++;
+  auto outer_key = std::exchange(current_key_, key);
+  lock.unlock();
+
+  auto finish = [this, &lock, key, outer_key] {
+    lock.lock();
+    current_key_ = outer_key;
+    if (auto it = this->running_.find(key); --it->second == 0) {
+      this->running_.erase(it);
+      this->running_cv_.notify_all();
+    }
+  };
+
+  try {
+    fn();
+  } catch (...) {
+    finish();
+    throw;
+  }
+  finish();
+}
+
+std::optional<SharedExecutor::TimePoint> SharedExecutor::nextTimerLocked() const noexcept(true) {
+  if (this->timers_.empty()) {
+    return std::nullopt;
+  }
+  return this->timers_.begin()->first.at;
+}
+
+bool SharedExecutor::runReadyLocked(std::unique_lock<std::mutex> &lock) noexcept(false) {
+  while (!this->ready_.empty()) {
+    auto key = this->ready_.front();
+    this->ready_.pop_front();
+    auto it = this->participants_.find(key);
+    if (it == this->participants_.end() || !it->second.ready) {
+      continue;  // detached meanwhile
+    }
+
+    // work pushed while running notifies (and queues) the participant again
+    it->second.ready = false;
+    this->statistics_.participant_runs++;
+    // copy, since it may be detached while running
+    auto participant = it->second.participant;
+    bool had_work = false;
+    auto run = [&participant, &had_work] { had_work = participant(); };
+    this->runUnlocked(lock, key, run);
+    if (!had_work) {
+      this->statistics_.idle_runs++;
+    }
+    return true;
+  }
+  return false;
+}
+
+bool SharedExecutor::fireTimerLocked(std::unique_lock<std::mutex> &lock, TimePoint until,
+                                     const std::function<void(TimePoint)> &on_take) noexcept(
+    false) {
+  if (this->timers_.empty() || this->timers_.begin()->first.at > until) {
+    return false;
+  }
+
+  auto node = this->timers_.extract(this->timers_.begin());
+  this->statistics_.timers_fired++;
+  if (on_take) {
+    on_take(node.key().at);
+  }
+  this->runUnlocked(lock, node.mapped().key, node.mapped().task);
+  return true;
+}
+
+SharedExecutor::TimerId SharedExecutor::schedule(const void *key, TimePoint at,
+                                                 Task task) noexcept(false) {
+  std::scoped_lock lock(this->mutex_);
+  TimerId id{at, this->next_seq_++};
+  auto it = this->timers_.emplace(id, Timer{key, std::move(task)}).first;
+  if (it == this->timers_.begin()) {
+    this->wake();
+  }
+  return id;
+}
+
+SharedExecutor::TimerId SharedExecutor::scheduleAfter(const void *key, Duration delay,
+                                                      Task task) noexcept(false) {
+  return this->schedule(key, this->now() + delay, std::move(task));
+}
+
+bool SharedExecutor::cancel(const TimerId &id) noexcept(true) {
+  std::scoped_lock lock(this->mutex_);
+  return this->timers_.erase(id) > 0;
+}
+
+std::optional<SharedExecutor::TimePoint> SharedExecutor::nextTimer() const noexcept(true) {
+  std::scoped_lock lock(this->mutex_);
+  return this->nextTimerLocked();
+}
+
+void SharedExecutor::attach(const void *key, Participant participant) noexcept(false) {
+  std::scoped_lock lock(this->mutex_);
+  auto &slot = this->participants_[key];
+  slot.participant = std::move(participant);
+  if (!slot.ready) {
+    slot.ready = true;
+    this->ready_.push_back(std::move(key));
+    this->wake();
+  }
+}
+
+void SharedExecutor::notify(const void *key) noexcept(false) {
+  std::scoped_lock lock(this->mutex_);
+  if (auto it = this->participants_.find(key);
+      it != this->participants_.end() && !it->second.ready) {
+    it->second.ready = true;
+    this->ready_.push_back(std::move(key));
+    this->wake();
+  }
+}
+
+void SharedExecutor::detach(const void *key) noexcept(true) {
+  std::unique_lock lock(this->mutex_);
+  // a stale entry in the ready queue is skipped by runReadyLocked
+  this->participants_.erase(key);
+  for (auto it = this->timers_.begin(); it != this->timers_.end();) {
+    if (it->second.key == key) {
+      it = this->timers_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  if (current_key_ != key) {
+    this->running_cv_.wait(lock, [this, key] { return this->running_.count(key) == 0; });
+  }
+}
+
+SharedExecutor::Statistics SharedExecutor::getStatistics() const noexcept(true) {
+  std::scoped_lock lock(this->mutex_);
+  return this->statistics_;
+}
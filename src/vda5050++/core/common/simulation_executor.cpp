@@ -0,0 +1,43 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains the implementation of the SimulationExecutor
+//
+
+#include "vda5050++/core/common/simulation_executor.h"
+
+#include <algorithm>
+
+using namespace vda5050pp::core::common;
+
+SimulationExecutor::SimulationExecutor(TimePoint start) noexcept(true) : now_(start) {}
+
+SimulationExecutor::TimePoint SimulationExecutor::now() const noexcept(true) {
+  std::scoped_lock lock(this->mutex_);
+  return this->now_;
+}
+
+void SimulationExecutor::runReady() noexcept(false) {
+  std::unique_lock lock(this->mutex_);
+  while (this->runReadyLocked(lock)) {
+  }
+}
+
+void SimulationExecutor::advanceTo(TimePoint until) noexcept(false) {
+  std::unique_lock lock(this->mutex_);
+  auto set_now = [this](TimePoint at) { this->now_ = std::max(this->now_, at); };
+
+  do {
+    while (this->runReadyLocked(lock)) {
+    }
+  } while (this->fireTimerLocked(lock, until, set_now));
+
+  set_now(until);
+}
+
+void SimulationExecutor::advanceBy(Duration duration) noexcept(false) {
+  this->advanceTo(this->now() + duration);
+}
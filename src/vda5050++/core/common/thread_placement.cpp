@@ -0,0 +1,208 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains the implementation of the ThreadRegistry
+//
+
+#include "vda5050++/core/common/thread_placement.h"
+
+#include <sched.h>
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <system_error>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace vda5050pp::core::common;
+
+static constexpr std::size_t k_max_name_length = 15;
+
+static void appendError(std::string &errors, const char *what, int err) {
+  if (!errors.empty()) {
+    errors += "; ";
+  }
+  errors += what;
+  errors += ": ";
+  errors += std::error_code(err, std::generic_category()).message();
+}
+
+static std::string threadName(const std::string &name, bool numbered, uint16_t index) {
+  if (name.empty()) {
+    return name;
+  }
+  auto suffix = numbered ? "-" + std::to_string(index) : std::string();
+  // keep the number, if the name is too long
+  return name.substr(0, k_max_name_length - std::min(suffix.size(), k_max_name_length)) + suffix;
+}
+
+static int nativePolicy(SchedulingPolicy policy) {
+  switch (policy) {
+    case SchedulingPolicy::k_fifo:
+      return SCHED_FIFO;
+    case SchedulingPolicy::k_round_robin:
+      return SCHED_RR;
+    default:
+      return SCHED_OTHER;
+  }
+}
+
+void ThreadRegistry::applyLocked(Entry &entry) noexcept(true) {
+  entry.error.clear();
+  auto it = this->placements_.find(entry.role);
+  if (it == this->placements_.end()) {
+    return;
+  }
+  const auto &placement = it->second;
+
+  if (auto name = threadName(placement.name, entry.numbered, entry.index); !name.empty()) {
+#ifdef __linux__
+    if (int err = pthread_setname_np(entry.handle, name.c_str()); err != 0) {
+      appendError(entry.error, "name", err);
+    }
+#else
+    appendError(entry.error, "name", ENOTSUP);
+#endif
+  }
+
+  if (!placement.cpus.empty()) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (auto cpu : placement.cpus) {
+      if (cpu < CPU_SETSIZE) {
+        CPU_SET(cpu, &set);
+      }
+    }
+    if (int err = pthread_setaffinity_np(entry.handle, sizeof(set), &set); err != 0) {
+      appendError(entry.error, "affinity", err);
+    }
+#else
+    appendError(entry.error, "affinity", ENOTSUP);
+#endif
+  }
+
+  if (placement.policy != SchedulingPolicy::k_inherit) {
+    auto policy = nativePolicy(placement.policy);
+    sched_param param{};
+    param.sched_priority = policy == SCHED_OTHER ? 0 : placement.priority;
+    if (int err = pthread_setschedparam(entry.handle, policy, &param); err != 0) {
+      appendError(entry.error, "scheduling", err);
+    } else if (policy == SCHED_OTHER && entry.tid != 0) {
+      // On Linux the nice value is per thread
+      if (setpriority(PRIO_PROCESS, static_cast<id_t>(entry.tid), placement.priority) != 0) {
+        appendError(entry.error, "nice", errno);
+      }
+    }
+  }
+
+  if (!entry.error.empty() && this->on_error_) {
+    this->on_error_("Could not place thread " + entry.role + "[" + std::to_string(entry.index) +
+                    "]: " + entry.error);
+  }
+}
+
+void ThreadRegistry::setPlacement(const std::string &role,
+                                  ThreadPlacement placement) noexcept(false) {
+  std::scoped_lock lock(this->mutex_);
+  this->placements_[role] = std::move(placement);
+  for (auto &[id, entry] : this->entries_) {
+    if (entry.role == role) {
+      this->applyLocked(entry);
+    }
+  }
+}
+
+void ThreadRegistry::setErrorHandler(
+    std::function<void(const std::string &)> on_error) noexcept(false) {
+  std::scoped_lock lock(this->mutex_);
+  this->on_error_ = std::move(on_error);
+}
+
+void ThreadRegistry::enter(const std::string &role, bool numbered) noexcept(false) {
+  std::scoped_lock lock(this->mutex_);
+
+  // use the lowest free number of the role
+  auto taken = [this, &role](uint16_t index) {
+    return std::any_of(this->entries_.begin(), this->entries_.end(), [&role, index](auto &kv) {
+      return kv.second.role == role && kv.second.index == index;
+    });
+  };
+  uint16_t index = 0;
+  while (taken(index)) {
+    index++;
+  }
+
+#ifdef __linux__
+  int64_t tid = ::syscall(SYS_gettid);
+#else
+  int64_t tid = 0;
+#endif
+
+  auto &entry = this->entries_[std::this_thread::get_id()];
+  entry = Entry{role, index, numbered, pthread_self(), tid, {}};
+  this->applyLocked(entry);
+}
+
+void ThreadRegistry::leave() noexcept(true) {
+  std::scoped_lock lock(this->mutex_);
+  this->entries_.erase(std::this_thread::get_id());
+}
+
+std::vector<ThreadInfo> ThreadRegistry::report() const noexcept(false) {
+  std::scoped_lock lock(this->mutex_);
+  std::vector<ThreadInfo> infos;
+  infos.reserve(this->entries_.size());
+
+  for (const auto &[id, entry] : this->entries_) {
+    ThreadInfo info;
+    info.role = entry.role;
+    info.index = entry.index;
+    info.tid = entry.tid;
+    info.error = entry.error;
+
+#ifdef __linux__
+    char name[k_max_name_length + 1] = {};
+    if (pthread_getname_np(entry.handle, name, sizeof(name)) == 0) {
+      info.name = name;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (pthread_getaffinity_np(entry.handle, sizeof(set), &set) == 0) {
+      for (uint16_t cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, &set)) {
+          info.cpus.push_back(cpu);
+        }
+      }
+    }
+#endif
+
+    int policy = SCHED_OTHER;
+    sched_param param{};
+    if (pthread_getschedparam(entry.handle, &policy, &param) == 0) {
+      if (policy == SCHED_FIFO) {
+        info.policy = SchedulingPolicy::k_fifo;
+        info.priority = param.sched_priority;
+      } else if (policy == SCHED_RR) {
+        info.policy = SchedulingPolicy::k_round_robin;
+        info.priority = param.sched_priority;
+      } else {
+        info.policy = SchedulingPolicy::k_other;
+        info.priority =
+            entry.tid != 0 ? getpriority(PRIO_PROCESS, static_cast<id_t>(entry.tid)) : 0;
+      }
+    }
+
+    infos.push_back(std::move(info));
+  }
+
+  return infos;
+}
@@ -0,0 +1,66 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains the implementation of the ThreadPoolExecutor
+//
+
+#include "vda5050++/core/common/thread_pool_executor.h"
+
+#include <algorithm>
+
+using namespace vda5050pp::core::common;
+
+ThreadPoolExecutor::ThreadPoolExecutor(std::size_t num_threads,
+                                       ThreadPlacement placement) noexcept(false) {
+  this->thread_registry_.setPlacement(k_role, std::move(placement));
+  num_threads = std::max<std::size_t>(num_threads, 1);
+  this->threads_.reserve(num_threads);
+  for (std::size_t i = 0; i < num_threads; i++) {
+    this->threads_.emplace_back([this] { this->work(); });
+  }
+}
+
+ThreadPoolExecutor::~ThreadPoolExecutor() {
+  {
+    std::scoped_lock lock(this->mutex_);
+    this->stop_ = true;
+  }
+  this->cv_.notify_all();
+  for (auto &thread : this->threads_) {
+    thread.join();
+  }
+}
+
+void ThreadPoolExecutor::wake() noexcept(true) { this->cv_.notify_one(); }
+
+void ThreadPoolExecutor::work() noexcept(true) {
+  this->thread_registry_.enter(k_role, true);
+  std::unique_lock lock(this->mutex_);
+
+  while (!this->stop_) {
+    if (this->runReadyLocked(lock) || this->fireTimerLocked(lock, this->now(), nullptr)) {
+      continue;
+    }
+
+    if (auto next = this->nextTimerLocked(); next.has_value()) {
+      this->cv_.wait_until(lock, *next);
+    } else {
+      this->cv_.wait(lock);
+    }
+  }
+  lock.unlock();
+  this->thread_registry_.leave();
+}
+
+ThreadPoolExecutor::TimePoint ThreadPoolExecutor::now() const noexcept(true) {
+  return Clock::now();
+}
+
+std::size_t ThreadPoolExecutor::size() const noexcept(true) { return this->threads_.size(); }
+
+std::vector<ThreadInfo> ThreadPoolExecutor::getThreadReport() const noexcept(false) {
+  return this->thread_registry_.report();
+}
@@ -0,0 +1,72 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+
+#include "vda5050++/core/common/wakeup_fd.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <system_error>
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+
+using namespace vda5050pp::core::common;
+
+WakeupFd::WakeupFd() noexcept(false) {
+#ifdef __linux__
+  this->read_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (this->read_fd_ < 0) {
+    throw std::system_error(errno, std::generic_category(), "WakeupFd: eventfd()");
+  }
+  this->write_fd_ = this->read_fd_;
+#else
+  int fds[2];
+  if (::pipe(fds) != 0) {
+    throw std::system_error(errno, std::generic_category(), "WakeupFd: pipe()");
+  }
+  for (int fd : fds) {
+    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+    ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+  }
+  this->read_fd_ = fds[0];
+  this->write_fd_ = fds[1];
+#endif
+}
+
+WakeupFd::~WakeupFd() {
+  if (this->write_fd_ != this->read_fd_) {
+    ::close(this->write_fd_);
+  }
+  ::close(this->read_fd_);
+}
+
+int WakeupFd::fd() const noexcept(true) { return this->read_fd_; }
+
+void WakeupFd::notify() noexcept(true) {
+  uint64_t one = 1;
+  // EAGAIN means the fd is already notified (counter/pipe full)
+  [[maybe_unused]] auto ret = ::write(this->write_fd_, &one, sizeof(one));
+}
+
+bool WakeupFd::drain() noexcept(true) {
+  bool notified = false;
+  uint64_t buf[8];
+  while (::read(this->read_fd_, buf, sizeof(buf)) > 0) {
+    notified = true;
+  }
+  return notified;
+}
+
+bool WakeupFd::wait(std::chrono::milliseconds timeout) const noexcept(true) {
+  pollfd pfd{this->read_fd_, POLLIN, 0};
+  return ::poll(&pfd, 1, static_cast<int>(timeout.count())) > 0;
+}
@@ -0,0 +1,421 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+//
+
+#include "vda5050++/core/common/work_stealing_executor.h"
+
+#include <algorithm>
+
+using namespace vda5050pp::core::common;
+
+thread_local WorkStealingExecutor::Worker *WorkStealingExecutor::current_worker_ = nullptr;
+
+WorkStealingExecutor::Worker *WorkStealingExecutor::currentWorker() const noexcept(true) {
+  auto worker = current_worker_;
+  return (worker != nullptr && worker->owner == this) ? worker : nullptr;
+}
+
+void WorkStealingExecutor::enqueue(Entry &&entry, TaskLane lane) noexcept(false) {
+  auto idx = static_cast<std::size_t>(lane);
+
+  // Count the entry before it becomes visible, a thief may take it right away and the unsigned
+  // counters must not wrap around. Until then, a thread may see a count without finding the entry
+  this->lanes_[idx].runnable++;
+  this->pending_++;
+
+  try {
+    if (auto worker = this->currentWorker(); worker != nullptr) {
+      std::unique_lock lock(worker->mutex);
+      worker->lanes[idx].push_back(std::move(entry));
+    } else {
+      std::unique_lock lock(this->injection_mutex_);
+      this->injection_[idx].push_back(std::move(entry));
+    }
+  } catch (...) {
+    this->lanes_[idx].runnable--;
+    this->pending_--;
+    throw;
+  }
+
+  if (this->idle_ > 0) {
+    std::unique_lock lock(this->idle_mutex_);
+    this->idle_cv_.notify_one();
+  }
+
+  if (this->push_notifier_) {
+    this->push_notifier_();
+  }
+}
+
+void WorkStealingExecutor::countPush(TaskLane lane) noexcept(true) {
+  auto &metrics = this->lanes_[static_cast<std::size_t>(lane)];
+
+  this->pushed_.fetch_add(1, std::memory_order_relaxed);
+  metrics.pushed.fetch_add(1, std::memory_order_relaxed);
+  auto depth = metrics.depth.fetch_add(1, std::memory_order_relaxed) + 1;
+  auto max_depth = metrics.max_depth.load(std::memory_order_relaxed);
+  while (depth > max_depth &&
+         !metrics.max_depth.compare_exchange_weak(max_depth, depth, std::memory_order_relaxed)) {
+  }
+}
+
+void WorkStealingExecutor::countStart(TaskLane lane, Clock::time_point pushed) noexcept(true) {
+  auto &metrics = this->lanes_[static_cast<std::size_t>(lane)];
+
+  metrics.started.fetch_add(1, std::memory_order_relaxed);
+  metrics.depth.fetch_sub(1, std::memory_order_relaxed);
+
+  auto wait_time = Clock::now() - pushed;
+  std::unique_lock lock(metrics.wait_time_mutex);
+  metrics.wait_time.record(wait_time);
+}
+
+RingDeque<WorkStealingExecutor::OrderedTask> &WorkStealingExecutor::scheduleKey(
+    OrderShard &shard, OrderKey key) noexcept(false) {
+  if (auto it = shard.queues.find(key); it != shard.queues.end()) {
+    return it->second;
+  }
+  if (shard.spare_nodes.empty()) {
+    return shard.queues[key];
+  }
+  auto node = std::move(shard.spare_nodes.back());
+  shard.spare_nodes.pop_back();
+  node.key() = key;
+  return shard.queues.insert(std::move(node)).position->second;
+}
+
+void WorkStealingExecutor::unscheduleKey(OrderShard &shard,
+                                         OrderQueues::iterator it) noexcept(false) {
+  if (shard.spare_nodes.size() < k_spare_nodes) {
+    shard.spare_nodes.push_back(shard.queues.extract(it));
+  } else {
+    shard.queues.erase(it);
+  }
+}
+
+void WorkStealingExecutor::runOrdered(OrderKey key) noexcept(false) {
+  auto &shard = this->order_shards_[std::hash<OrderKey>()(key) % k_order_shards];
+
+  std::unique_lock lock(shard.mutex);
+  auto it = shard.queues.find(key);
+
+  // Run a few tasks at once, then yield to other keys
+  for (std::size_t i = 0; i < k_ordered_batch; i++) {
+    // Keep the (moved from) front, such that the key stays scheduled while the task runs
+    auto &front = it->second.front();
+    auto task = std::move(front.task);
+    auto lane = front.lane;
+    auto pushed = front.pushed;
+    lock.unlock();
+
+    this->countStart(lane, pushed);
+    task();
+
+    lock.lock();
+    // rehashing may have invalidated the iterator
+    it = shard.queues.find(key);
+    it->second.pop_front();
+    if (it->second.empty()) {
+      unscheduleKey(shard, it);
+      return;
+    }
+  }
+  auto lane = it->second.front().lane;
+  lock.unlock();
+
+  this->enqueue({[this, key] { this->runOrdered(key); }, Clock::time_point{}}, lane);
+}
+
+std::optional<WorkStealingExecutor::Entry> WorkStealingExecutor::takeFromLane(
+    std::size_t lane, Worker *self) noexcept(true) {
+  auto pop_front = [this, lane](RingDeque<Entry> &queue) {
+    auto entry = std::move(queue.front());
+    queue.pop_front();
+    this->lanes_[lane].runnable--;
+    this->pending_--;
+    return entry;
+  };
+
+  if (self != nullptr) {
+    std::unique_lock lock(self->mutex);
+    if (auto &queue = self->lanes[lane]; !queue.empty()) {
+      this->popped_local_.fetch_add(1, std::memory_order_relaxed);
+      return pop_front(queue);
+    }
+  }
+
+  {
+    std::unique_lock lock(this->injection_mutex_);
+    if (auto &queue = this->injection_[lane]; !queue.empty()) {
+      this->popped_injected_.fetch_add(1, std::memory_order_relaxed);
+      return pop_front(queue);
+    }
+  }
+
+  std::shared_lock workers_lock(this->workers_mutex_);
+  auto n = this->workers_.size();
+  // start at a thread dependent victim, such that thieves do not all contend on the first one
+  auto start = std::hash<const void *>()(self) % std::max<std::size_t>(n, 1);
+  for (std::size_t i = 0; i < n; i++) {
+    auto &victim = this->workers_[(start + i) % n];
+    if (victim.get() == self) {
+      continue;
+    }
+    std::unique_lock lock(victim->mutex);
+    if (auto &queue = victim->lanes[lane]; !queue.empty()) {
+      auto entry = std::move(queue.back());
+      queue.pop_back();
+      this->lanes_[lane].runnable--;
+      this->pending_--;
+      this->stolen_.fetch_add(1, std::memory_order_relaxed);
+      return entry;
+    }
+  }
+
+  return std::nullopt;
+}
+
+std::optional<WorkStealingExecutor::Task> WorkStealingExecutor::take() noexcept(true) {
+  if (this->pending_ == 0) {
+    return std::nullopt;
+  }
+
+  auto self = this->currentWorker();
+  auto limit = this->starvation_limit_.load(std::memory_order_relaxed);
+
+  // Serve the most skipped lane first, if it starves
+  std::optional<std::size_t> starving;
+  uint32_t most_skipped = 0;
+  for (std::size_t lane = 0; lane < k_task_lanes; lane++) {
+    auto skipped = this->lanes_[lane].skipped.load(std::memory_order_relaxed);
+    if (this->lanes_[lane].runnable > 0 && skipped >= limit &&
+        (!starving.has_value() || skipped > most_skipped)) {
+      starving = lane;
+      most_skipped = skipped;
+    }
+  }
+
+  std::array<std::size_t, k_task_lanes> order;
+  std::size_t n = 0;
+  if (starving.has_value()) {
+    order[n++] = *starving;
+  }
+  for (std::size_t lane = 0; lane < k_task_lanes; lane++) {
+    if (lane != starving) {
+      order[n++] = lane;
+    }
+  }
+
+  for (auto lane : order) {
+    if (this->lanes_[lane].runnable == 0) {
+      continue;
+    }
+    auto entry = this->takeFromLane(lane, self);
+    if (!entry.has_value()) {
+      continue;
+    }
+
+    this->lanes_[lane].skipped.store(0, std::memory_order_relaxed);
+    bool promoted = false;
+    for (std::size_t other = 0; other < k_task_lanes; other++) {
+      if (this->lanes_[other].runnable == 0) {
+        continue;
+      }
+      if (other < lane) {
+        promoted = true;
+      } else if (other > lane) {
+        this->lanes_[other].skipped.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+    if (promoted) {
+      this->starvation_promotions_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (entry->pushed != Clock::time_point{}) {
+      this->countStart(static_cast<TaskLane>(lane), entry->pushed);
+    }
+    return std::move(entry->task);
+  }
+
+  return std::nullopt;
+}
+
+void WorkStealingExecutor::push(Task task) noexcept(false) {
+  this->push(TaskLane::k_action, std::move(task));
+}
+
+void WorkStealingExecutor::push(TaskLane lane, Task task) noexcept(false) {
+  this->countPush(lane);
+  this->enqueue({std::move(task), Clock::now()}, lane);
+}
+
+void WorkStealingExecutor::push(OrderKey key, Task task) noexcept(false) {
+  this->push(key, TaskLane::k_action, std::move(task));
+}
+
+void WorkStealingExecutor::push(OrderKey key, TaskLane lane, Task task) noexcept(false) {
+  this->countPush(lane);
+
+  auto &shard = this->order_shards_[std::hash<OrderKey>()(key) % k_order_shards];
+  bool schedule = false;
+  {
+    std::unique_lock lock(shard.mutex);
+    auto &queue = scheduleKey(shard, key);
+    schedule = queue.empty();
+    queue.push_back({std::move(task), lane, Clock::now()});
+  }
+
+  if (schedule) {
+    this->enqueue({[this, key] { this->runOrdered(key); }, Clock::time_point{}}, lane);
+  }
+}
+
+std::optional<WorkStealingExecutor::Task> WorkStealingExecutor::try_pop() noexcept(true) {
+  return this->take();
+}
+
+std::optional<WorkStealingExecutor::Task> WorkStealingExecutor::try_pop_for(
+    std::chrono::steady_clock::duration rel_time) noexcept(true) {
+  auto deadline = Clock::now() + rel_time;
+
+  while (true) {
+    if (auto task = this->take(); task.has_value()) {
+      return task;
+    }
+
+    std::unique_lock lock(this->idle_mutex_);
+    auto epoch = this->wake_epoch_.load();
+    this->idle_++;
+    bool woken = this->idle_cv_.wait_until(lock, deadline, [this, epoch] {
+      return this->pending_ > 0 || this->wake_epoch_ != epoch;
+    });
+    this->idle_--;
+
+    if (!woken || this->wake_epoch_ != epoch) {
+      lock.unlock();
+      return this->take();
+    }
+  }
+}
+
+std::optional<WorkStealingExecutor::Task> WorkStealingExecutor::pop(
+    const std::function<bool()> &cancelled) noexcept(true) {
+  while (true) {
+    if (auto task = this->take(); task.has_value()) {
+      return task;
+    }
+
+    std::unique_lock lock(this->idle_mutex_);
+    auto epoch = this->wake_epoch_.load();
+    this->idle_++;
+    this->idle_cv_.wait(lock, [this, epoch, &cancelled] {
+      return this->pending_ > 0 || this->wake_epoch_ != epoch || cancelled();
+    });
+    this->idle_--;
+
+    if (this->wake_epoch_ != epoch || cancelled()) {
+      lock.unlock();
+      return this->take();
+    }
+  }
+}
+
+void WorkStealingExecutor::attachWorker() noexcept(false) {
+  auto worker = std::make_shared<Worker>();
+  worker->owner = this;
+
+  std::unique_lock lock(this->workers_mutex_);
+  this->workers_.push_back(worker);
+  current_worker_ = worker.get();
+}
+
+void WorkStealingExecutor::detachWorker() noexcept(false) {
+  auto self = this->currentWorker();
+  if (self == nullptr) {
+    return;
+  }
+
+  {
+    std::unique_lock lock(this->workers_mutex_);
+    auto it = std::find_if(this->workers_.begin(), this->workers_.end(),
+                           [self](auto &w) { return w.get() == self; });
+    auto worker = *it;
+    this->workers_.erase(it);
+    current_worker_ = nullptr;
+
+    // Hand over the remaining tasks (pending_ stays the same)
+    std::scoped_lock tasks_lock(worker->mutex, this->injection_mutex_);
+    for (std::size_t lane = 0; lane < k_task_lanes; lane++) {
+      auto &queue = worker->lanes[lane];
+      while (!queue.empty()) {
+        this->injection_[lane].push_back(std::move(queue.front()));
+        queue.pop_front();
+      }
+    }
+  }
+
+  if (this->idle_ > 0) {
+    std::unique_lock lock(this->idle_mutex_);
+    this->idle_cv_.notify_all();
+  }
+}
+
+void WorkStealingExecutor::wakeAll() noexcept(true) {
+  std::unique_lock lock(this->idle_mutex_);
+  this->wake_epoch_++;
+  this->idle_cv_.notify_all();
+}
+
+void WorkStealingExecutor::setPushNotifier(std::function<void()> notifier) noexcept(true) {
+  this->push_notifier_ = std::move(notifier);
+}
+
+void WorkStealingExecutor::setStarvationLimit(uint32_t limit) noexcept(true) {
+  this->starvation_limit_ = limit;
+}
+
+bool WorkStealingExecutor::empty() const noexcept(true) { return this->pending_ == 0; }
+
+std::size_t WorkStealingExecutor::size() const noexcept(true) { return this->pending_; }
+
+WorkStealingExecutor::Statistics WorkStealingExecutor::getStatistics() const noexcept(true) {
+  Statistics statistics;
+  statistics.pushed = this->pushed_.load(std::memory_order_relaxed);
+  statistics.popped_local = this->popped_local_.load(std::memory_order_relaxed);
+  statistics.popped_injected = this->popped_injected_.load(std::memory_order_relaxed);
+  statistics.stolen = this->stolen_.load(std::memory_order_relaxed);
+  statistics.starvation_promotions = this->starvation_promotions_.load(std::memory_order_relaxed);
+
+  for (std::size_t lane = 0; lane < k_task_lanes; lane++) {
+    auto &metrics = this->lanes_[lane];
+    auto &lane_statistics = statistics.lanes[lane];
+    lane_statistics.pushed = metrics.pushed.load(std::memory_order_relaxed);
+    lane_statistics.started = metrics.started.load(std::memory_order_relaxed);
+    lane_statistics.depth = metrics.depth.load(std::memory_order_relaxed);
+    lane_statistics.max_depth = metrics.max_depth.load(std::memory_order_relaxed);
+    std::unique_lock lock(metrics.wait_time_mutex);
+    lane_statistics.wait_time = metrics.wait_time;
+  }
+
+  return statistics;
+}
+
+void WorkStealingExecutor::resetStatistics() noexcept(true) {
+  this->pushed_ = 0;
+  this->popped_local_ = 0;
+  this->popped_injected_ = 0;
+  this->stolen_ = 0;
+  this->starvation_promotions_ = 0;
+
+  for (auto &metrics : this->lanes_) {
+    metrics.pushed = 0;
+    metrics.started = 0;
+    metrics.max_depth = metrics.depth.load();
+    std::unique_lock lock(metrics.wait_time_mutex);
+    metrics.wait_time.reset();
+  }
+}
@@ -40,8 +40,7 @@ const vda5050pp::core::messages::Messages &ConstHandleAccessor::getMessages() co
 
 vda5050pp::interface_agv::Logger &vda5050pp::core::interface_agv::ConstHandleAccessor::getLogger()
     const noexcept(true) {
-  return *vda5050pp::interface_agv::Logger::getCurrentLogger();  // TODO: change this awful
-                                                                 // dereference
+  return *this->handle_.logger_;
 }
 
 const vda5050pp::interface_agv::agv_description::AGVDescription &
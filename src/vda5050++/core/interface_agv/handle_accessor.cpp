@@ -63,15 +63,22 @@ vda5050pp::core::messages::Messages &HandleAccessor::getMessages() noexcept(true
 
 vda5050pp::interface_agv::Logger &vda5050pp::core::interface_agv::HandleAccessor::getLogger() const
     noexcept(true) {
-  return *vda5050pp::interface_agv::Logger::getCurrentLogger();  // TODO: change this awful
-                                                                 // dereference
+  return *this->handle_.logger_;
 }
 
-vda5050pp::core::common::BlockingQueue<std::function<void()>>
-    &HandleAccessor::getTaskQueue() noexcept(true) {
+vda5050pp::core::common::WorkStealingExecutor &HandleAccessor::getTaskQueue() noexcept(true) {
   return this->handle_.task_queue_;
 }
 
+std::shared_ptr<vda5050pp::core::common::SharedExecutor> HandleAccessor::getSharedExecutor() const
+    noexcept(true) {
+  return this->handle_.executor_;
+}
+
+vda5050pp::core::common::ThreadRegistry &HandleAccessor::getThreadRegistry() noexcept(true) {
+  return this->handle_.thread_registry_;
+}
+
 std::shared_ptr<vda5050pp::interface_agv::ActionHandler> HandleAccessor::createActionHandler() const
     noexcept(true) {
   if (this->handle_.create_action_handler_ == nullptr) {
@@ -124,6 +131,10 @@ std::chrono::system_clock::duration HandleAccessor::getStateUpdatePeriod() const
   return this->handle_.state_update_period_;
 }
 
+std::size_t HandleAccessor::getInterpretationWindow() const noexcept(true) {
+  return this->handle_.interpretation_window_;
+}
+
 std::shared_ptr<vda5050pp::interface_agv::OdometryHandler> HandleAccessor::getOdometryHandler()
     const noexcept(true) {
   return this->handle_.odometry_handler_;
@@ -12,6 +12,7 @@
 #include "vda5050++/core/interface_agv/handle_accessor.h"
 
 using namespace vda5050pp::core::logic;
+using vda5050pp::core::common::inlineTask;
 
 ActionManager::ActionManager(vda5050pp::interface_agv::Handle &handle, vda5050pp::Action action,
                              SeqNrT seq)
@@ -23,6 +24,10 @@ ActionManager::ActionManager(vda5050pp::interface_agv::Handle &handle, vda5050pp
   this->action_handler_->setManagerReference(*this);
 }
 
+ActionManager::~ActionManager() noexcept(true) {
+  this->action_handler_->unsetManagerReference();
+}
+
 std::shared_ptr<vda5050pp::interface_agv::ActionHandler> ActionManager::getHandler() const
     noexcept(true) {
   return this->action_handler_;
@@ -35,9 +40,9 @@ void ActionManager::taskInitialize() noexcept(true) {
   auto &q = ha.getTaskQueue();
   auto &messages = ha.getMessages();
 
-  state.setActionStatus(action.actionId, vda5050pp::ActionStatus::INITIALIZING);
+  state.trySetActionStatus(action.actionId, vda5050pp::ActionStatus::INITIALIZING);
 
-  q.push([this] {
+  q.push(this, vda5050pp::core::common::TaskLane::k_action, inlineTask([this] {
     try {
       this->action_handler_->start(this->action_handler_->getAction());
     } catch (const std::exception &e) {
@@ -48,7 +53,7 @@ void ActionManager::taskInitialize() noexcept(true) {
       }
       ha.getLogic().abortOrder();
     }
-  });
+  }));
 
   messages.requestStateUpdate(messages::UpdateUrgency::k_high);
 }
@@ -57,7 +62,7 @@ void ActionManager::taskRunning() noexcept(true) {
   auto &msgs = vda5050pp::core::interface_agv::HandleAccessor(this->handle_).getMessages();
   auto &action = this->action_handler_->getAction();
 
-  state.setActionStatus(action.actionId, vda5050pp::ActionStatus::RUNNING);
+  state.trySetActionStatus(action.actionId, vda5050pp::ActionStatus::RUNNING);
   msgs.requestStateUpdate(messages::UpdateUrgency::k_medium);
 }
 void ActionManager::taskPaused() noexcept(true) {
@@ -65,7 +70,7 @@ void ActionManager::taskPaused() noexcept(true) {
   auto &msgs = vda5050pp::core::interface_agv::HandleAccessor(this->handle_).getMessages();
   auto &action = this->action_handler_->getAction();
 
-  state.setActionStatus(action.actionId, vda5050pp::ActionStatus::PAUSED);
+  state.trySetActionStatus(action.actionId, vda5050pp::ActionStatus::PAUSED);
   msgs.requestStateUpdate(messages::UpdateUrgency::k_medium);
 }
 void ActionManager::taskFinished() noexcept(true) {
@@ -73,7 +78,7 @@ void ActionManager::taskFinished() noexcept(true) {
   auto &msgs = vda5050pp::core::interface_agv::HandleAccessor(this->handle_).getMessages();
   auto &action = this->action_handler_->getAction();
 
-  state.setActionStatus(action.actionId, vda5050pp::ActionStatus::FINISHED);
+  state.trySetActionStatus(action.actionId, vda5050pp::ActionStatus::FINISHED);
   msgs.requestStateUpdate(messages::UpdateUrgency::k_high);
 }
 void ActionManager::taskFailed() noexcept(true) {
@@ -81,7 +86,7 @@ void ActionManager::taskFailed() noexcept(true) {
   auto &msgs = vda5050pp::core::interface_agv::HandleAccessor(this->handle_).getMessages();
   auto &action = this->action_handler_->getAction();
 
-  state.setActionStatus(action.actionId, vda5050pp::ActionStatus::FAILED);
+  state.trySetActionStatus(action.actionId, vda5050pp::ActionStatus::FAILED);
   msgs.requestStateUpdate(messages::UpdateUrgency::k_high);
 }
 
@@ -105,7 +110,7 @@ void ActionManager::logPlaceReached(const Net::PlaceT &place) noexcept(true) {
 
 void ActionManager::pause() noexcept(true) {
   auto &q = vda5050pp::core::interface_agv::HandleAccessor(this->handle_).getTaskQueue();
-  q.push([this] {
+  q.push(this, vda5050pp::core::common::TaskLane::k_stop, inlineTask([this] {
     this->logTransition("pause()", true);
     try {
       this->action_handler_->pause(this->action_handler_->getAction());
@@ -118,12 +123,12 @@ void ActionManager::pause() noexcept(true) {
       ha.getState().addError(error);
       ha.getLogic().abortOrder();
     }
-  });
+  }));
 }
 
 void ActionManager::resume() noexcept(true) {
   auto &q = vda5050pp::core::interface_agv::HandleAccessor(this->handle_).getTaskQueue();
-  q.push([this] {
+  q.push(this, vda5050pp::core::common::TaskLane::k_action, inlineTask([this] {
     this->logTransition("resume()", true);
     try {
       this->action_handler_->resume(this->action_handler_->getAction());
@@ -137,13 +142,13 @@ void ActionManager::resume() noexcept(true) {
       ha.getState().addError(error);
       ha.getLogic().abortOrder();
     }
-  });
+  }));
 }
 
 void ActionManager::stop() noexcept(true) {
   auto &q = vda5050pp::core::interface_agv::HandleAccessor(this->handle_).getTaskQueue();
 
-  q.push([this] {
+  q.push(this, vda5050pp::core::common::TaskLane::k_stop, inlineTask([this] {
     this->logTransition("stop()", true);
     try {
       this->action_handler_->stop(this->action_handler_->getAction());
@@ -156,5 +161,5 @@ void ActionManager::stop() noexcept(true) {
       ha.getState().addError(error);
       ha.getLogic().abortOrder();
     }
-  });
+  }));
 }
\ No newline at end of file
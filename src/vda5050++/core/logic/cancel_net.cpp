@@ -7,8 +7,6 @@
 
 #include "vda5050++/core/logic/cancel_net.h"
 
-#include <stdexcept>
-
 using namespace vda5050pp::core::logic;
 
 CancelNet::CancelNet(std::vector<std::string> &&cancel_action_ids, LogicTaskNetID pre_place_id,
@@ -24,29 +22,30 @@ CancelNet::CancelNet(std::vector<std::string> &&cancel_action_ids, LogicTaskNetI
 }
 
 void CancelNet::attachToNet(Net &composed_net) noexcept(false) {
-  Net partial_net;
-  auto self_ptr = partial_net.addPlace(this->self_place_id_, 0);
-  auto post_ptr = partial_net.addPlace(this->post_place_id_, 0);
+  // Add the places directly, merging an intermediate net would copy them
+  auto self_ptr = composed_net.addPlace(this->self_place_id_, 0);
+  composed_net.addPlace(this->post_place_id_, 0);
 
   // <this> might not exist, when this lambda is called.
   // It is guaranteed, that net_manager is still valid (because the lambda function object is owned
   // by the manager). the cancel_action_ids have to be copied.
-  self_ptr->onChange([&net_manager = this->net_manager_, c_ids = this->cancel_action_ids_](
-                         const Net::PlaceT &place, Net::TokenCounterT prev) {
-    if (place.getTokens() == 1 && prev == 0)
-      for (const auto &id : c_ids) {
-        if (net_manager.isActionActive(id)) {
-          net_manager.stopAction(id);
-        }
-      }
-  });
+  self_ptr->onChange(this->net_manager_.getNetTrace().traced(
+      [&net_manager = this->net_manager_, c_ids = this->cancel_action_ids_](
+          const Net::PlaceT &place, Net::TokenCounterT prev) {
+        if (place.getTokens() == 1 && prev == 0)
+          for (const auto &id : c_ids) {
+            // the action may already have exited and been removed from the net
+            net_manager.stopActionIfActive(id);
+          }
+      }));
 
   Net::TransitionSketch pre_transition = {
       this->transition_pre_id_, {{this->pre_place_id_, 1}}, {{this->self_place_id_, 1}}};
   Net::TransitionSketch post_transition = {
       this->transition_post_id_, {{this->self_place_id_, 1}}, {{this->post_place_id_, 1}}};
 
-  composed_net.merge(std::move(partial_net), {pre_transition, post_transition});
+  composed_net.addTransition(pre_transition);
+  composed_net.addTransition(post_transition);
 
   composed_net.findTransition(this->transition_pre_id_)->autoFire();
   composed_net.findTransition(this->transition_post_id_)->autoFire();
@@ -54,4 +53,12 @@ void CancelNet::attachToNet(Net &composed_net) noexcept(false) {
 
 LogicTaskNetID CancelNet::getPrePlaceID() const noexcept(true) { return this->pre_place_id_; }
 LogicTaskNetID CancelNet::getSelfPlaceID() const noexcept(true) { return this->self_place_id_; }
-LogicTaskNetID CancelNet::getPlaceID() const noexcept(true) { return this->post_place_id_; }
\ No newline at end of file
+LogicTaskNetID CancelNet::getPlaceID() const noexcept(true) { return this->post_place_id_; }
+
+void CancelNet::getOwnIDs(std::vector<LogicTaskNetID> &places,
+                          std::vector<LogicTaskNetID> &transitions) const noexcept(false) {
+  places.push_back(this->self_place_id_);
+  places.push_back(this->post_place_id_);
+  transitions.push_back(this->transition_pre_id_);
+  transitions.push_back(this->transition_post_id_);
+}
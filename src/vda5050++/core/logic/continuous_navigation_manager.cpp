@@ -12,6 +12,7 @@
 #include "vda5050++/core/logic/net_manager.h"
 
 using namespace vda5050pp::core::logic;
+using vda5050pp::core::common::inlineTask;
 
 void ContinuousNavigationManager::startHandler() {
   vda5050pp::core::interface_agv::HandleAccessor ha(this->handle_);
@@ -23,7 +24,7 @@ void ContinuousNavigationManager::startHandler() {
   this->start_nodes_.clear();
   this->start_edges_.clear();
 
-  q.push([this] {
+  q.push(this, vda5050pp::core::common::TaskLane::k_navigation, inlineTask([this] {
     const auto &nodes = this->handler_->base_nodes_;
     const auto &edges = this->handler_->base_edges_;
     try {
@@ -38,10 +39,15 @@ void ContinuousNavigationManager::startHandler() {
       ha.getState().addError(error);
       ha.getLogic().abortOrder();
     }
-  });
+  }));
 }
 
-void ContinuousNavigationManager::destroyHandler() { this->handler_.reset(); }
+void ContinuousNavigationManager::destroyHandler() {
+  if (this->handler_ != nullptr) {
+    this->handler_->unsetManager();
+  }
+  this->handler_.reset();
+}
 
 void ContinuousNavigationManager::stepDrivingChanged(bool driving) const noexcept(true) {
   if (this->on_driving_changed_ != nullptr) {
@@ -70,7 +76,8 @@ void ContinuousNavigationManager::stepExited(ContinuousNavigationSingleStepTask
     this->stepDrivingChanged(false);
     ha.getMessages().requestStateUpdate(vda5050pp::core::messages::UpdateUrgency::k_medium);
     if (this->isFinalized()) {
-      ha.getTaskQueue().push(std::bind(&ContinuousNavigationManager::destroyHandler, this));
+      ha.getTaskQueue().push(this, vda5050pp::core::common::TaskLane::k_housekeeping,
+                             inlineTask([this] { this->destroyHandler(); }));
     }
   }
 }
@@ -135,12 +142,16 @@ ContinuousNavigationManager::ContinuousNavigationManager(
   this->append(node, edge, std::move(cancel_action_ids));
 }
 
+ContinuousNavigationManager::~ContinuousNavigationManager() noexcept(true) {
+  this->destroyHandler();
+}
+
 void ContinuousNavigationManager::append(
     const vda5050pp::Node &node, const std::optional<vda5050pp::Edge> &edge,
     std::vector<std::string> &&cancel_action_ids) noexcept(true) {
   auto step = std::make_shared<ContinuousNavigationSingleStepTask>(handle_, *this, node.sequenceId,
                                                                    this->net_manager_.nextSeq());
-  this->net_manager_.registerNewTaskManager(*step, std::move(cancel_action_ids));
+  this->net_manager_.registerNewTaskManager(*this, *step, std::move(cancel_action_ids));
   this->single_step_tasks_[node.sequenceId] = std::move(step);
 
   // Store for when the handler will be started (or appendings are commited)
@@ -160,7 +171,7 @@ void ContinuousNavigationManager::commitAppendings() {
     this->handler_->appendToBase(std::move(this->start_nodes_), std::move(this->start_edges_));
     this->start_nodes_.clear();
     this->start_edges_.clear();
-    q.push([this] {
+    q.push(this, vda5050pp::core::common::TaskLane::k_navigation, inlineTask([this] {
       auto nodes = this->handler_->getBaseDeltaNodes();
       auto edges = this->handler_->getBaseDeltaEdges();
       try {
@@ -175,7 +186,7 @@ void ContinuousNavigationManager::commitAppendings() {
         ha.getState().addError(error);
         ha.getLogic().abortOrder();
       }
-    });
+    }));
   }
 }
 
@@ -189,7 +200,7 @@ void ContinuousNavigationManager::pause() {
   if (this->handler_ != nullptr) {
     vda5050pp::core::interface_agv::HandleAccessor ha(this->handle_);
     auto &q = ha.getTaskQueue();
-    q.push([this] {
+    q.push(this, vda5050pp::core::common::TaskLane::k_stop, inlineTask([this] {
       try {
         this->handler_->pause();
       } catch (const std::exception &e) {
@@ -202,7 +213,7 @@ void ContinuousNavigationManager::pause() {
         ha.getState().addError(error);
         ha.getLogic().abortOrder();
       }
-    });
+    }));
   }
 }
 
@@ -210,7 +221,7 @@ void ContinuousNavigationManager::resume() {
   if (this->handler_ != nullptr) {
     vda5050pp::core::interface_agv::HandleAccessor ha(this->handle_);
     auto &q = ha.getTaskQueue();
-    q.push([this] {
+    q.push(this, vda5050pp::core::common::TaskLane::k_navigation, inlineTask([this] {
       try {
         this->handler_->resume();
       } catch (const std::exception &e) {
@@ -223,7 +234,7 @@ void ContinuousNavigationManager::resume() {
         ha.getState().addError(error);
         ha.getLogic().abortOrder();
       }
-    });
+    }));
   }
 }
 
@@ -231,7 +242,7 @@ void ContinuousNavigationManager::stop() {
   if (this->handler_ != nullptr) {
     vda5050pp::core::interface_agv::HandleAccessor ha(this->handle_);
     auto &q = ha.getTaskQueue();
-    q.push([this] {
+    q.push(this, vda5050pp::core::common::TaskLane::k_stop, inlineTask([this] {
       try {
         this->handler_->stop();
       } catch (const std::exception &e) {
@@ -244,7 +255,7 @@ void ContinuousNavigationManager::stop() {
         ha.getState().addError(error);
         ha.getLogic().abortOrder();
       }
-    });
+    }));
   }
 }
 
@@ -259,7 +270,7 @@ void ContinuousNavigationManager::horizonChanged() {
 
   this->handler_->setNewHorizon(state.getHorizonNodes(), state.getHorizonEdges());
 
-  q.push([this] {
+  q.push(this, vda5050pp::core::common::TaskLane::k_navigation, inlineTask([this] {
     auto &nodes = this->handler_->getHorizonNodes();
     auto &edges = this->handler_->getHorizonEdges();
     try {
@@ -274,7 +285,7 @@ void ContinuousNavigationManager::horizonChanged() {
       error.errorLevel = vda5050pp::ErrorLevel::WARNING;
       ha.getState().addError(error);
     }
-  });
+  }));
 }
 
 bool ContinuousNavigationManager::intercept() noexcept(true) {
@@ -304,3 +315,13 @@ ContinuousNavigationManager::getInterceptedMgr() noexcept(true) {
   auto seq = this->current_step_->get().getNodeSequence();
   return this->single_step_tasks_.at(seq);
 }
+
+std::shared_ptr<ContinuousNavigationSingleStepTask> ContinuousNavigationManager::releaseStep(
+    uint32_t node_seq) noexcept(true) {
+  auto node = this->single_step_tasks_.extract(node_seq);
+  return node.empty() ? nullptr : std::move(node.mapped());
+}
+
+bool ContinuousNavigationManager::hasSteps() const noexcept(true) {
+  return !this->single_step_tasks_.empty();
+}
@@ -29,4 +29,10 @@ LogicTaskNetID DanglingNet::getInvokePlace() const noexcept(true) { return this-
 
 LogicTaskNetID DanglingNet::getTransition() const noexcept(true) {
   return this->initial_transition_;
-}
\ No newline at end of file
+}
+
+void DanglingNet::getOwnIDs(std::vector<LogicTaskNetID> &places,
+                            std::vector<LogicTaskNetID> &transitions) const noexcept(false) {
+  places.push_back(this->begin_place_);
+  transitions.push_back(this->initial_transition_);
+}
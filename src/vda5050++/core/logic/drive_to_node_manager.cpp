@@ -14,6 +14,7 @@
 #include "vda5050++/core/interface_agv/handle_accessor.h"
 
 using namespace vda5050pp::core::logic;
+using vda5050pp::core::common::inlineTask;
 
 bool DriveToNodeManager::logTransition(const std::string &name, bool ret) noexcept(true) {
   vda5050pp::core::interface_agv::HandleAccessor(this->handle_)
@@ -37,7 +38,7 @@ void DriveToNodeManager::taskInitialize() noexcept(true) {
   vda5050pp::core::interface_agv::HandleAccessor ha(this->handle_);
   auto &q = ha.getTaskQueue();
 
-  q.push([this] {
+  q.push(this, vda5050pp::core::common::TaskLane::k_navigation, inlineTask([this] {
     try {
       this->navigate_to_node_handler_->start(this->navigate_to_node_handler_->getViaEdge(),
                                              this->navigate_to_node_handler_->getGoalNode());
@@ -50,7 +51,7 @@ void DriveToNodeManager::taskInitialize() noexcept(true) {
       }
       ha.getState().addError(error);
     }
-  });
+  }));
 }
 
 void DriveToNodeManager::taskRunning() noexcept(true) {
@@ -117,10 +118,14 @@ DriveToNodeManager::DriveToNodeManager(vda5050pp::interface_agv::Handle &handle,
   this->navigate_to_node_handler_->setManager(*this);
 }
 
+DriveToNodeManager::~DriveToNodeManager() noexcept(true) {
+  this->navigate_to_node_handler_->unsetManager();
+}
+
 void DriveToNodeManager::pause() noexcept(true) {
   vda5050pp::core::interface_agv::HandleAccessor ha(this->handle_);
   auto &q = ha.getTaskQueue();
-  q.push([this] {
+  q.push(this, vda5050pp::core::common::TaskLane::k_stop, inlineTask([this] {
     try {
       this->navigate_to_node_handler_->pause();
     } catch (const std::exception &e) {
@@ -132,13 +137,13 @@ void DriveToNodeManager::pause() noexcept(true) {
       }
       ha.getState().addError(error);
     }
-  });
+  }));
 }
 
 void DriveToNodeManager::resume() noexcept(true) {
   vda5050pp::core::interface_agv::HandleAccessor ha(this->handle_);
   auto &q = ha.getTaskQueue();
-  q.push([this] {
+  q.push(this, vda5050pp::core::common::TaskLane::k_navigation, inlineTask([this] {
     try {
       this->navigate_to_node_handler_->resume();
     } catch (const std::exception &e) {
@@ -150,13 +155,13 @@ void DriveToNodeManager::resume() noexcept(true) {
       }
       ha.getState().addError(error);
     }
-  });
+  }));
 }
 
 void DriveToNodeManager::stop() noexcept(true) {
   vda5050pp::core::interface_agv::HandleAccessor ha(this->handle_);
   auto &q = ha.getTaskQueue();
-  q.push([this] {
+  q.push(this, vda5050pp::core::common::TaskLane::k_stop, inlineTask([this] {
     try {
       this->navigate_to_node_handler_->stop();
     } catch (const std::exception &e) {
@@ -168,7 +173,7 @@ void DriveToNodeManager::stop() noexcept(true) {
       }
       ha.getState().addError(error);
     }
-  });
+  }));
 }
 
 void DriveToNodeManager::onDrivingChanged(const std::function<void(bool driving)> &fn) noexcept(
@@ -48,8 +48,8 @@ void InstantActionsManager::doInitPosition(const vda5050pp::Action &action) noex
     }
   }
 
-  std::function<void()> init_task = [this, aid = action.actionId, at = action.actionType, x, y,
-                                     theta, mapId, lastNodeId] {
+  auto init_task = [this, aid = action.actionId, at = action.actionType, x, y, theta, mapId,
+                    lastNodeId] {
     vda5050pp::AGVPosition pos;
     pos.x = double(x);
     pos.y = double(y);
@@ -87,7 +87,7 @@ void InstantActionsManager::doInitPosition(const vda5050pp::Action &action) noex
   };
 
   vda5050pp::core::interface_agv::HandleAccessor ha(this->handle_);
-  ha.getTaskQueue().push(std::move(init_task));
+  ha.getTaskQueue().push(vda5050pp::core::common::TaskLane::k_action, std::move(init_task));
 }
 
 void InstantActionsManager::doInstantAction(const vda5050pp::Action &action) noexcept(false) {
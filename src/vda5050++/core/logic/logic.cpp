@@ -38,4 +38,8 @@ void Logic::abortOrder(const std::function<void()> &and_then) noexcept(true) {
   this->net_manager_.onAllExited(and_then);
 }
 
-void Logic::notifyHorizonChanged() noexcept(true) { this->net_manager_.notifyHorizonChanged(); }
\ No newline at end of file
+void Logic::notifyHorizonChanged() noexcept(true) { this->net_manager_.notifyHorizonChanged(); }
+
+NetTrace &Logic::getNetTrace() noexcept(true) { return this->net_trace_; }
+
+const NetTrace &Logic::getNetTrace() const noexcept(true) { return this->net_trace_; }
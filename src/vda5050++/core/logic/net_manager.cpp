@@ -22,9 +22,177 @@
 #include "vda5050++/core/logic/sync_net.h"
 
 using namespace vda5050pp::core::logic;
+using vda5050pp::core::common::inlineTask;
+
+// Copy the managers of an index, the index may change while they are notified
+template <typename ManagerT>
+static std::vector<std::shared_ptr<ManagerT>> snapshot(
+    const std::unordered_map<const TaskManager *, std::shared_ptr<ManagerT>> &index) {
+  std::vector<std::shared_ptr<ManagerT>> managers;
+  managers.reserve(index.size());
+  for (const auto &[_, mgr] : index) {
+    managers.push_back(mgr);
+  }
+  return managers;
+}
+
+// The throwing lookup on top of NetManager::findActionManager
+static ActionManager &expectActionManager(ActionManager *mgr, const std::string &action_id) {
+  if (mgr == nullptr) {
+    throw std::invalid_argument("No ActionManager for action_id: " + action_id);
+  }
+  return *mgr;
+}
+
+NetManager::NetManager(vda5050pp::interface_agv::Handle &handle) noexcept(true)
+    : handle_(handle),
+      trace_(vda5050pp::core::interface_agv::HandleAccessor(handle).getLogic().getNetTrace()) {
+  this->net_.setTrace(&this->trace_);
+  this->addInitialTimeStep();
+}
+
+void NetManager::addInitialTimeStep() noexcept(true) {
+  LogicTaskNetID id = {LogicTaskNetTypes::k_done, 0};
+  this->next_seq_ = 1;
+
+  auto &step = this->time_steps_.emplace_back();
+  step.place_ids.push_back(id);
+  this->setTailPlace(step, this->net_.addPlace(id, 1));
+}
+
+template <typename ManagerT>
+void NetManager::index(const std::shared_ptr<ManagerT> &mgr, ManagerIndex<ManagerT> &pending,
+                       ManagerIndex<ManagerT> &active) noexcept(false) {
+  const TaskManager *key = mgr.get();
+  pending[key] = mgr;
+  mgr->onActiveChanged([&pending, &active, key](bool is_active) {
+    auto node = pending.extract(key);
+    if (is_active && !node.empty()) {
+      active.insert(std::move(node));
+    } else if (!is_active) {
+      active.erase(key);
+    }
+  });
+}
+
+void NetManager::addToTimeStep(TimeStep &step, const PartialNet &partial_net) noexcept(true) {
+  auto first_new = step.transition_ids.size();
+  partial_net.getOwnIDs(step.place_ids, step.transition_ids);
+  this->pending_transitions_.insert(end(this->pending_transitions_),
+                                    begin(step.transition_ids) + first_new,
+                                    end(step.transition_ids));
+}
+
+void NetManager::addToTimeStep(TimeStep &step, const TaskManager &mgr) noexcept(true) {
+  this->addToTimeStep(step, static_cast<const PartialNet &>(mgr));
+  if (mgr.exitedPlacePtr() != nullptr) {
+    step.exited_places.push_back(mgr.exitedPlacePtr());
+  }
+}
+
+void NetManager::setTailPlace(TimeStep &step,
+                              std::shared_ptr<Net::PlaceT> tail_place) noexcept(true) {
+  // The hook stays until the step is collected, the list keeps the step's address stable
+  step.tail_place = tail_place;
+  step.tail_place->onChange(
+      this->trace_.traced([this, &step](const Net::PlaceT &place, Net::TokenCounterT prev) {
+        if (place.getTokens() < prev) {
+          step.left = true;
+          this->scheduleInterpretation();
+        }
+        if (&place == this->tail_place_.get() && this->on_tail_reached_ != nullptr &&
+            !this->hasUninterpreted()) {
+          this->on_tail_reached_();
+        }
+      }));
+  this->tail_place_ = std::move(tail_place);
+}
+
+void NetManager::collectGarbage() noexcept(true) {
+  if (this->time_steps_.size() < 2) {
+    return;
+  }
+
+  vda5050pp::core::interface_agv::HandleAccessor ha(this->handle_);
+  auto &q = ha.getTaskQueue();
+  bool collected = false;
+
+  auto is_exited = [](const std::shared_ptr<Net::PlaceT> &place) {
+    return place->getTokens() > 0;
+  };
+
+  // the latest step holds the tail place, it is never collected
+  auto last = std::prev(this->time_steps_.end());
+  for (auto it = this->time_steps_.begin(); it != last;) {
+    if (!it->left) {
+      // the following time steps cannot be launched before this one was left
+      break;
+    }
+    if (!std::all_of(begin(it->exited_places), end(it->exited_places), is_exited)) {
+      ++it;
+      continue;
+    }
+
+    it->tail_place->onChange(nullptr);
+    for (const auto &id : it->place_ids) {
+      this->net_.removePlace(id);
+    }
+    for (const auto &id : it->transition_ids) {
+      this->net_.removeTransition(id);
+    }
+
+    // Tasks of a manager are ordered by it's address, so the release runs after them
+    for (auto &[id, mgr] : it->action_managers) {
+      if (auto found = this->action_managers_by_id_.find(id);
+          found != end(this->action_managers_by_id_) && found->second == mgr) {
+        this->action_managers_by_id_.erase(found);
+      }
+      auto key = mgr.get();
+      q.push(key, vda5050pp::core::common::TaskLane::k_housekeeping,
+             inlineTask([mgr = std::move(mgr)]() mutable { mgr.reset(); }));
+    }
+    for (auto &[seq, mgr] : it->drive_to_node_managers) {
+      if (auto found = this->drive_to_node_managers_by_id_.find(seq);
+          found != end(this->drive_to_node_managers_by_id_) && found->second == mgr) {
+        this->drive_to_node_managers_by_id_.erase(found);
+      }
+      auto key = mgr.get();
+      q.push(key, vda5050pp::core::common::TaskLane::k_housekeeping,
+             inlineTask([mgr = std::move(mgr)]() mutable { mgr.reset(); }));
+    }
+
+    for (auto &[owner, node_seq] : it->continuous_navigation_steps) {
+      auto mgr = owner->releaseStep(node_seq);
+      auto key = mgr.get();
+      q.push(key, vda5050pp::core::common::TaskLane::k_housekeeping,
+             inlineTask([mgr = std::move(mgr)]() mutable { mgr.reset(); }));
+    }
+
+    it = this->time_steps_.erase(it);
+    collected = true;
+  }
 
-NetManager::NetManager(vda5050pp::interface_agv::Handle &handle) noexcept(true) : handle_(handle) {
-  this->tail_place_ = this->net_.addPlace({LogicTaskNetTypes::k_done, this->next_seq_++}, 1);
+  if (!collected) {
+    return;
+  }
+
+  // Finalized continuous navigation managers without steps will not be entered again
+  for (auto it = this->continuous_navigation_managers_.begin();
+       it != this->continuous_navigation_managers_.end();) {
+    if (!(*it)->isFinalized() || (*it)->hasSteps()) {
+      ++it;
+      continue;
+    }
+    auto mgr = std::move(*it);
+    auto key = mgr.get();
+    q.push(key, vda5050pp::core::common::TaskLane::k_housekeeping,
+           inlineTask([mgr = std::move(mgr)]() mutable { mgr.reset(); }));
+    it = this->continuous_navigation_managers_.erase(it);
+  }
+
+  ha.getLogger().logDebug(vda5050pp::core::common::format(
+      "Collected time steps: #Places={} #Transitions={}", this->net_.numPlaces(),
+      this->net_.numTransitions()));
 }
 
 void NetManager::insertTimeStepAction(const std::vector<std::string> &action_ids,
@@ -36,11 +204,11 @@ void NetManager::insertTimeStepAction(const std::vector<std::string> &action_ids
 
   std::vector<LogicTaskNetID> ready_ids;
   std::vector<LogicTaskNetID> done_ids;
-  std::vector<LogicTaskNetID> finish_ids;
-  std::vector<LogicTaskNetID> fail_ids;
 
   ha.getLogger().logDebug(vda5050pp::core::common::logstring("---BEGIN ACTION GROUP---"));
 
+  auto &step = this->time_steps_.emplace_back();
+
   // Create manager for each action
   for (const auto &id : action_ids) {
     auto action = state.getActionById(id);
@@ -51,15 +219,19 @@ void NetManager::insertTimeStepAction(const std::vector<std::string> &action_ids
 
     auto mgr_seq = this->next_seq_++;
     auto mgr_ptr = std::make_shared<ActionManager>(this->handle_, std::move(action), mgr_seq);
+    this->index(mgr_ptr, this->pending_action_managers_, this->active_action_managers_);
 
     ready_ids.push_back(mgr_ptr->readyPlace());
-    finish_ids.push_back(mgr_ptr->finishedPlace());
-    fail_ids.push_back(mgr_ptr->failedPlace());
     if (sync_this_action) {
       done_ids.push_back(mgr_ptr->donePlace());
     }
 
     mgr_ptr->attachToNet(this->net_);
+    this->addToTimeStep(step, *mgr_ptr);
+    // register finish and fail places
+    step.finish_places.push_back(mgr_ptr->finishedPlacePtr());
+    step.fail_places.push_back(mgr_ptr->failedPlacePtr());
+    step.action_managers.emplace_back(id, mgr_ptr);
 
     // Exit logic. Call on_all_exited when each mgr reached it's exited place
     this->un_exited_ids_.insert(mgr_ptr->exitedPlace());
@@ -69,7 +241,7 @@ void NetManager::insertTimeStepAction(const std::vector<std::string> &action_ids
           .getLogger()
           .logDebug(vda5050pp::core::common::format("Mgr exited: #UnExited={}",
                                                     this->un_exited_ids_.size()));
-      if (this->un_exited_ids_.empty() && this->on_all_exited_ != nullptr) {
+      if (!this->isAnythingActive() && this->on_all_exited_ != nullptr) {
         this->on_all_exited_();
       }
     });
@@ -77,20 +249,6 @@ void NetManager::insertTimeStepAction(const std::vector<std::string> &action_ids
     this->action_managers_by_id_[id] = std::move(mgr_ptr);
   }
 
-  auto id_to_place_ptr = [this](const LogicTaskNetID &id) -> std::shared_ptr<Net::PlaceT> {
-    auto ptr = this->net_.findPlace(id);
-    if (ptr == nullptr) {
-      throw IdNotFoundError(id);
-    }
-    return ptr;
-  };
-
-  // register finish and fail places
-  std::transform(begin(finish_ids), end(finish_ids), std::back_inserter(this->finish_places_),
-                 id_to_place_ptr);
-  std::transform(begin(fail_ids), end(fail_ids), std::back_inserter(this->fail_places_),
-                 id_to_place_ptr);
-
   std::shared_ptr<Net::PlaceT> new_tail_place;
 
   // When there is nothing to synchronize
@@ -102,17 +260,21 @@ void NetManager::insertTimeStepAction(const std::vector<std::string> &action_ids
     LogicTaskNetID sync_id = {LogicTaskNetTypes::k_combinator_sync, this->next_seq_};
     ready_ids.push_back(sync_id);
     new_tail_place = this->net_.addPlace(sync_id, 0);
+    step.place_ids.push_back(sync_id);
 
     ParallelLaunchNet pl(this->tail_place_->getID(), std::move(ready_ids));
     pl.attachToNet(this->net_);
+    this->addToTimeStep(step, pl);
 
   } else {
     // Normal case
     ParallelLaunchNet pl(this->tail_place_->getID(), std::move(ready_ids));
     pl.attachToNet(this->net_);
+    this->addToTimeStep(step, pl);
 
     SyncNet sn(std::move(done_ids), {LogicTaskNetTypes::k_combinator_sync, this->next_seq_++});
     sn.attachToNet(this->net_);
+    this->addToTimeStep(step, sn);
 
     new_tail_place = this->net_.findPlace(sn.getPlaceID());
     if (new_tail_place == nullptr) {
@@ -120,11 +282,7 @@ void NetManager::insertTimeStepAction(const std::vector<std::string> &action_ids
     }
   }
 
-  this->tail_place_->onChange(nullptr);
-  this->tail_place_ = new_tail_place;
-  this->tail_place_->onChange([this](auto, auto) {
-    if (this->on_tail_reached_ != nullptr) this->on_tail_reached_();
-  });
+  this->setTailPlace(step, std::move(new_tail_place));
 
   ha.getLogger().logDebug(vda5050pp::core::common::logstring("---END ACTION GROUP---"));
 }
@@ -156,15 +314,21 @@ void NetManager::insertTimeStepDriveToNode(
   // Create manager
   auto mgr_seq = this->next_seq_++;
   auto mgr_ptr = std::make_shared<DriveToNodeManager>(ha.getHandle(), edge, node, mgr_seq);
+  this->index(mgr_ptr, this->pending_drive_to_node_managers_,
+              this->active_drive_to_node_managers_);
   mgr_ptr->onDrivingChanged(this->on_driving_changed_);
 
   mgr_ptr->attachToNet(this->net_);
 
+  auto &step = this->time_steps_.emplace_back();
+  this->addToTimeStep(step, *mgr_ptr);
+  step.drive_to_node_managers.emplace_back(node.sequenceId, mgr_ptr);
+
   // Exit logic. Call on all exited when each mgr reached it's exited place
   this->un_exited_ids_.insert(mgr_ptr->exitedPlace());
   mgr_ptr->onExited([this, ha](const auto &id) {
     this->un_exited_ids_.extract(id);
-    if (this->un_exited_ids_.empty() && this->on_all_exited_ != nullptr) {
+    if (!this->isAnythingActive() && this->on_all_exited_ != nullptr) {
       using namespace std::string_literals;
       ha.getLogger().logDebug(vda5050pp::core::common::logstring("Last exited: ", id));
       this->on_all_exited_();
@@ -180,23 +344,21 @@ void NetManager::insertTimeStepDriveToNode(
   };
 
   // Save fail and finish places
-  this->fail_places_.push_back(id_to_place_ptr(mgr_ptr->failedPlace()));
-  this->finish_places_.push_back(id_to_place_ptr(mgr_ptr->finishedPlace()));
+  step.fail_places.push_back(mgr_ptr->failedPlacePtr());
+  step.finish_places.push_back(mgr_ptr->finishedPlacePtr());
 
   // Create launch net
   ParallelLaunchNet pl(this->tail_place_->getID(), {mgr_ptr->readyPlace()});
   pl.attachToNet(this->net_);
+  this->addToTimeStep(step, pl);
 
   // Create cancel net
   CancelNet cn(std::move(cancel_action_ids), mgr_ptr->donePlace(), *this);
   cn.attachToNet(this->net_);
+  this->addToTimeStep(step, cn);
 
   // Set new tail place
-  this->tail_place_->onChange(nullptr);
-  this->tail_place_ = id_to_place_ptr(cn.getPlaceID());
-  this->tail_place_->onChange([this](auto, auto) {
-    if (this->on_tail_reached_ != nullptr) this->on_tail_reached_();
-  });
+  this->setTailPlace(step, id_to_place_ptr(cn.getPlaceID()));
 
   this->drive_to_node_managers_by_id_[node.sequenceId] = std::move(mgr_ptr);
 }
@@ -287,15 +449,17 @@ void NetManager::interpretEdgeThenNode(const vda5050pp::Edge &edge,
   interpretNode(node);
 }
 
-void NetManager::interpret() noexcept(false) {
+void NetManager::interpretWindow() noexcept(false) {
   vda5050pp::core::interface_agv::HandleAccessor ha(this->handle_);
   auto &state = ha.getState().getStateUnsafe();
   auto &state_mgr = ha.getState();
+  auto window = ha.getInterpretationWindow();
 
-  // If only one Node must be interpreted, it can be done on it's own.
-  // Otherwise if an uninterpreted Edge is before that Node, actions
-  // from that Edge have to be canceled -> interpret them together
-  if (state.graph_base_seq_id >= state.graph_next_interpreted_seq_id_) {
+  while (state.graph_base_seq_id >= state.graph_next_interpreted_seq_id_ &&
+         (window == 0 || this->numStepsAhead() < window)) {
+    // If only one Node must be interpreted, it can be done on it's own.
+    // Otherwise if an uninterpreted Edge is before that Node, actions
+    // from that Edge have to be canceled -> interpret them together
     if (vda5050pp::core::state::StateManager::isNode(state.graph_next_interpreted_seq_id_)) {
       auto interpret_seq = state.graph_next_interpreted_seq_id_++;
       this->interpretNode(state_mgr.getNodeBySeq(interpret_seq));
@@ -304,79 +468,172 @@ void NetManager::interpret() noexcept(false) {
       auto nid = state.graph_next_interpreted_seq_id_++;
       this->interpretEdgeThenNode(state_mgr.getEdgeBySeq(eid), state_mgr.getNodeBySeq(nid));
     }
+  }
+}
 
-    this->interpret();
-  } else {
-    if (!this->continuous_navigation_managers_.empty()) {
-      this->continuous_navigation_managers_.front()->commitAppendings();
-      this->notifyHorizonChanged();
+std::size_t NetManager::numStepsAhead() const noexcept(true) {
+  std::size_t steps = 0;
+  for (auto it = this->time_steps_.rbegin(); it != this->time_steps_.rend() && !it->left; ++it) {
+    steps++;
+  }
+  return steps;
+}
+
+bool NetManager::hasUninterpreted() const noexcept(true) {
+  auto &state =
+      vda5050pp::core::interface_agv::HandleAccessor(this->handle_).getState().getStateUnsafe();
+  return state.graph_base_seq_id >= state.graph_next_interpreted_seq_id_;
+}
+
+void NetManager::scheduleInterpretation() noexcept(true) {
+  if (!this->hasUninterpreted() || this->interpretation_pending_.exchange(true)) {
+    return;
+  }
+
+  vda5050pp::core::interface_agv::HandleAccessor ha(this->handle_);
+  try {
+    auto task = inlineTask([this] {
+      this->interpretation_pending_ = false;
+      try {
+        this->interpret();
+      } catch (const std::exception &e) {
+        vda5050pp::core::interface_agv::HandleAccessor(this->handle_)
+            .getLogger()
+            .logError(vda5050pp::core::common::format("Could not interpret the order: {}",
+                                                      e.what()));
+      }
+    });
+    ha.getTaskQueue().push(this, vda5050pp::core::common::TaskLane::k_housekeeping,
+                           std::move(task));
+  } catch (const std::exception &e) {
+    this->interpretation_pending_ = false;
+    ha.getLogger().logError(
+        vda5050pp::core::common::format("Could not schedule the interpretation: {}", e.what()));
+  }
+}
+
+void NetManager::skipUninterpreted() noexcept(true) {
+  if (!this->hasUninterpreted()) {
+    return;
+  }
+
+  vda5050pp::core::interface_agv::HandleAccessor ha(this->handle_);
+  auto &state = ha.getState().getStateUnsafe();
+  auto &state_mgr = ha.getState();
+
+  auto fail_actions = [&state_mgr](const std::vector<vda5050pp::Action> &actions) {
+    for (const auto &action : actions) {
+      state_mgr.trySetActionStatus(action.actionId, vda5050pp::ActionStatus::FAILED);
     }
-    if (!state_mgr.getPausedState()) {
-      // Finally tick to re-/start if not paused
-      this->tick();
+  };
+  for (auto seq = state.graph_next_interpreted_seq_id_; seq <= state.graph_base_seq_id; seq++) {
+    if (vda5050pp::core::state::StateManager::isNode(seq)) {
+      if (auto node = state_mgr.tryGetNodeBySeq(seq); node.has_value()) {
+        fail_actions(node->actions);
+      }
+    } else if (auto edge = state_mgr.tryGetEdgeBySeq(seq); edge.has_value()) {
+      fail_actions(edge->actions);
     }
   }
+  state.graph_next_interpreted_seq_id_ = state.graph_base_seq_id + 1;
+  ha.getMessages().requestStateUpdate(vda5050pp::core::messages::UpdateUrgency::k_high);
+}
+
+void NetManager::interpret() noexcept(false) {
+  vda5050pp::core::interface_agv::HandleAccessor ha(this->handle_);
+  auto &state_mgr = ha.getState();
+
+  this->interpretWindow();
+
+  if (!this->continuous_navigation_managers_.empty()) {
+    this->continuous_navigation_managers_.front()->commitAppendings();
+    this->notifyHorizonChanged();
+  }
+  if (!state_mgr.getPausedState()) {
+    // Finally tick to re-/start if not paused
+    this->tick();
+  }
 }
 
 void NetManager::clear() noexcept(true) {
+  for (auto &step : this->time_steps_) {
+    if (step.tail_place != nullptr) {
+      step.tail_place->onChange(nullptr);
+    }
+  }
+  this->time_steps_.clear();
+  this->pending_transitions_.clear();
   this->action_managers_by_id_.clear();
   this->drive_to_node_managers_by_id_.clear();
-  this->fail_places_.clear();
-  this->finish_places_.clear();
+  this->pending_action_managers_.clear();
+  this->active_action_managers_.clear();
+  this->pending_drive_to_node_managers_.clear();
+  this->active_drive_to_node_managers_.clear();
   this->on_all_exited_ = nullptr;
   this->on_driving_changed_ = nullptr;
   this->on_tail_reached_ = nullptr;
   this->un_exited_ids_.clear();
   this->net_ = Net();
-  this->next_seq_ = 1;
-  this->tail_place_ = this->net_.addPlace({LogicTaskNetTypes::k_done, 0}, 1);
+  this->net_.setTrace(&this->trace_);
+  this->addInitialTimeStep();
   this->continuous_navigation_managers_.clear();
 }
 
-void NetManager::tick() noexcept(true) { this->net_.deepTickCover(); }
+void NetManager::tick() noexcept(true) {
+  std::vector<LogicTaskNetID> pending;
+  // firing may attach new partial nets, these are handled in the next round
+  while (!this->pending_transitions_.empty()) {
+    std::swap(pending, this->pending_transitions_);
+    for (const auto &id : pending) {
+      auto transition = this->net_.findTransition(id);
+      if (transition == nullptr || !transition->isAutoFire()) {
+        continue;
+      }
+      while (this->trace_.deepFire(this->net_, *transition)) {
+      }
+    }
+    pending.clear();
+  }
+  this->collectGarbage();
+}
 
-void NetManager::pauseAction(const std::string &action_id) noexcept(false) {
+ActionManager *NetManager::findActionManager(const std::string &action_id) const
+    noexcept(true) {
   auto pair = this->action_managers_by_id_.find(action_id);
+  return pair == end(this->action_managers_by_id_) ? nullptr : pair->second.get();
+}
 
-  if (pair == end(this->action_managers_by_id_)) {
-    throw std::invalid_argument("No ActionManager for action_id: " + action_id);
-  }
+std::size_t NetManager::numContinuousNavigationManagers() const noexcept(true) {
+  return this->continuous_navigation_managers_.size();
+}
 
-  pair->second->pause();
+void NetManager::pauseAction(const std::string &action_id) noexcept(false) {
+  expectActionManager(this->findActionManager(action_id), action_id).pause();
 }
 
 void NetManager::resumeAction(const std::string &action_id) noexcept(false) {
-  auto pair = this->action_managers_by_id_.find(action_id);
-
-  if (pair == end(this->action_managers_by_id_)) {
-    throw std::invalid_argument("No ActionManager for action_id: " + action_id);
-  }
-
-  pair->second->resume();
+  expectActionManager(this->findActionManager(action_id), action_id).resume();
 }
 
 void NetManager::stopAction(const std::string &action_id) noexcept(false) {
-  auto pair = this->action_managers_by_id_.find(action_id);
-
-  if (pair == end(this->action_managers_by_id_)) {
-    throw std::invalid_argument("No ActionManager for action_id: " + action_id);
-  }
-
-  pair->second->stop();
+  expectActionManager(this->findActionManager(action_id), action_id).stop();
 }
 
 bool NetManager::isActionActive(const std::string &action_id) noexcept(false) {
-  auto pair = this->action_managers_by_id_.find(action_id);
+  return expectActionManager(this->findActionManager(action_id), action_id).isActive();
+}
 
-  if (pair == end(this->action_managers_by_id_)) {
-    throw std::invalid_argument("No ActionManager for action_id: " + action_id);
+bool NetManager::stopActionIfActive(const std::string &action_id) noexcept(true) {
+  auto mgr = this->findActionManager(action_id);
+  if (mgr == nullptr || !mgr->isActive()) {
+    return false;
   }
-
-  return pair->second->isActive();
+  mgr->stop();
+  return true;
 }
 
 void NetManager::pauseAllRunningActions() noexcept(true) {
-  for (auto &[_, mgr] : this->action_managers_by_id_) {
+  for (auto &mgr : snapshot(this->active_action_managers_)) {
     if (mgr->isRunning()) {
       mgr->pause();
     }
@@ -384,7 +641,7 @@ void NetManager::pauseAllRunningActions() noexcept(true) {
 }
 
 void NetManager::resumeAllPausedActions() noexcept(true) {
-  for (auto &[_, mgr] : this->action_managers_by_id_) {
+  for (auto &mgr : snapshot(this->active_action_managers_)) {
     if (mgr->isPaused()) {
       mgr->resume();
     }
@@ -392,12 +649,12 @@ void NetManager::resumeAllPausedActions() noexcept(true) {
 }
 
 void NetManager::stopAllActive() noexcept(true) {
-  for (auto &[_, mgr] : this->action_managers_by_id_) {
+  for (auto &mgr : snapshot(this->active_action_managers_)) {
     if (mgr->isActive()) {
       mgr->stop();
     }
   }
-  for (auto &[_, mgr] : this->drive_to_node_managers_by_id_) {
+  for (auto &mgr : snapshot(this->active_drive_to_node_managers_)) {
     if (mgr->isActive()) {
       mgr->stop();
     }
@@ -416,12 +673,13 @@ void NetManager::cancelAll() noexcept(true) {
 
 void NetManager::cancelAllPending() noexcept(true) {
   // Cancel all tasks in the future
-  for (auto &[_, mgr] : this->action_managers_by_id_) {
+  this->skipUninterpreted();
+  for (auto &mgr : snapshot(this->pending_action_managers_)) {
     if (!mgr->isDone() && !mgr->isActive()) {
       mgr->cancel();
     }
   }
-  for (auto &[_, mgr] : this->drive_to_node_managers_by_id_) {
+  for (auto &mgr : snapshot(this->pending_drive_to_node_managers_)) {
     if (!mgr->isDone() && !mgr->isActive()) {
       mgr->cancel();
     }
@@ -433,7 +691,7 @@ void NetManager::cancelAllPending() noexcept(true) {
 
 std::vector<std::shared_ptr<ActionManager>> NetManager::interceptAllActive() noexcept(true) {
   std::vector<std::shared_ptr<ActionManager>> ret;
-  for (auto &[_, mgr] : this->action_managers_by_id_) {
+  for (auto &mgr : snapshot(this->active_action_managers_)) {
     if (mgr->isActive()) {
       if (mgr->intercept()) {
         ret.push_back(mgr);
@@ -444,7 +702,7 @@ std::vector<std::shared_ptr<ActionManager>> NetManager::interceptAllActive() noe
 }
 
 std::shared_ptr<TaskManager> NetManager::interceptDriving() noexcept(true) {
-  for (auto &[_, mgr] : this->drive_to_node_managers_by_id_) {
+  for (auto &mgr : snapshot(this->active_drive_to_node_managers_)) {
     if (mgr->isActive()) {
       if (mgr->intercept()) {
         return mgr;
@@ -462,7 +720,7 @@ std::shared_ptr<TaskManager> NetManager::interceptDriving() noexcept(true) {
 }
 
 void NetManager::stopHard() noexcept(true) {
-  for (auto &[_, mgr] : this->action_managers_by_id_) {
+  for (auto &mgr : snapshot(this->active_action_managers_)) {
     if (mgr->isActive() &&
         mgr->getHandler()->getAction().blockingType == vda5050pp::BlockingType::HARD) {
       mgr->stop();
@@ -471,7 +729,7 @@ void NetManager::stopHard() noexcept(true) {
 }
 
 void NetManager::stopSoft() noexcept(true) {
-  for (auto &[_, mgr] : this->action_managers_by_id_) {
+  for (auto &mgr : snapshot(this->active_action_managers_)) {
     if (mgr->isActive() &&
         mgr->getHandler()->getAction().blockingType == vda5050pp::BlockingType::SOFT) {
       mgr->stop();
@@ -480,7 +738,7 @@ void NetManager::stopSoft() noexcept(true) {
 }
 
 void NetManager::stopNone() noexcept(true) {
-  for (auto &[_, mgr] : this->action_managers_by_id_) {
+  for (auto &mgr : snapshot(this->active_action_managers_)) {
     if (mgr->isActive() &&
         mgr->getHandler()->getAction().blockingType == vda5050pp::BlockingType::NONE) {
       mgr->stop();
@@ -490,6 +748,7 @@ void NetManager::stopNone() noexcept(true) {
 
 void NetManager::interceptWithAction(const vda5050pp::Action &action) noexcept(true) {
   auto mgr = std::make_shared<ActionManager>(this->handle_, action, this->next_seq_++);
+  this->index(mgr, this->pending_action_managers_, this->active_action_managers_);
 
   auto mgr_begin_id = [](const std::shared_ptr<ActionManager> &mgr) -> LogicTaskNetID {
     return mgr->interceptingBeginPlace();
@@ -523,6 +782,12 @@ void NetManager::interceptWithAction(const vda5050pp::Action &action) noexcept(t
                  intercepted->interceptingEndPlace());
       sn.attachToNet(this->net_);
 
+      auto &step = this->time_steps_.back();
+      this->addToTimeStep(step, *mgr);
+      this->addToTimeStep(step, dn);
+      this->addToTimeStep(step, sn);
+      step.action_managers.emplace_back(action.actionId, mgr);
+
       if (action.blockingType != vda5050pp::BlockingType::NONE) {
         this->pauseDriving();
         mgr->onExited([this](auto) { this->resumeDriving(); });
@@ -534,11 +799,17 @@ void NetManager::interceptWithAction(const vda5050pp::Action &action) noexcept(t
       SyncNet sn({mgr->donePlace(), this->tail_place_->getID()},
                  {LogicTaskNetTypes::k_combinator_sync, this->next_seq_++});
       sn.attachToNet(this->net_);
-      this->tail_place_ = this->net_.findPlace(sn.getPlaceID());
+
+      auto &step = this->time_steps_.emplace_back();
+      this->addToTimeStep(step, *mgr);
+      this->addToTimeStep(step, dn);
+      this->addToTimeStep(step, sn);
+      step.action_managers.emplace_back(action.actionId, mgr);
+      this->setTailPlace(step, this->net_.findPlace(sn.getPlaceID()));
     }
 
     this->action_managers_by_id_[action.actionId] = mgr;
-    this->net_.findTransition(dn.getTransition())->deepFire();
+    this->trace_.deepFire(this->net_, *this->net_.findTransition(dn.getTransition()));
     return;
   }
 
@@ -580,6 +851,8 @@ void NetManager::interceptWithAction(const vda5050pp::Action &action) noexcept(t
     }
     sn.attachToNet(this->net_);
     pn.attachToNet(this->net_);
+    this->addToTimeStep(this->time_steps_.back(), sn);
+    this->addToTimeStep(this->time_steps_.back(), pn);
     // stop all running actions
     this->stopHard();
     this->stopSoft();
@@ -600,6 +873,8 @@ void NetManager::interceptWithAction(const vda5050pp::Action &action) noexcept(t
     }
     sn.attachToNet(this->net_);
     pn.attachToNet(this->net_);
+    this->addToTimeStep(this->time_steps_.back(), sn);
+    this->addToTimeStep(this->time_steps_.back(), pn);
     // Block currently running hard actions
     if (current_blocking_type == vda5050pp::BlockingType::HARD) {
       this->stopHard();
@@ -619,6 +894,8 @@ void NetManager::interceptWithAction(const vda5050pp::Action &action) noexcept(t
     mgr->attachToNet(this->net_);
     sn.attachToNet(this->net_);
     pn.attachToNet(this->net_);
+    this->addToTimeStep(this->time_steps_.back(), sn);
+    this->addToTimeStep(this->time_steps_.back(), pn);
     // Stop all currently running HARD actions
     if (current_blocking_type == vda5050pp::BlockingType::HARD) {
       this->stopHard();
@@ -633,11 +910,15 @@ void NetManager::interceptWithAction(const vda5050pp::Action &action) noexcept(t
     }
   }
 
+  // The intercepting action ends before the current time step can be left
+  auto &step = this->time_steps_.back();
+  this->addToTimeStep(step, *mgr);
+  step.action_managers.emplace_back(action.actionId, mgr);
   this->action_managers_by_id_[action.actionId] = mgr;
 }
 
 void NetManager::pauseDriving() noexcept(true) {
-  for (auto &[_, mgr] : this->drive_to_node_managers_by_id_) {
+  for (auto &mgr : snapshot(this->active_drive_to_node_managers_)) {
     if (mgr->isActive()) {
       mgr->pause();
     }
@@ -650,7 +931,7 @@ void NetManager::pauseDriving() noexcept(true) {
 }
 
 void NetManager::resumeDriving() noexcept(true) {
-  for (auto &[_, mgr] : this->drive_to_node_managers_by_id_) {
+  for (auto &mgr : snapshot(this->active_drive_to_node_managers_)) {
     if (mgr->isActive()) {
       mgr->resume();
     }
@@ -682,11 +963,15 @@ void NetManager::onAllExited(std::function<void(void)> fn) noexcept(true) {
   this->on_all_exited_ = fn;
 }
 
-bool NetManager::isAnythingActive() const noexcept(true) { return !this->un_exited_ids_.empty(); }
+bool NetManager::isAnythingActive() const noexcept(true) {
+  // the uninterpreted base counts as pending tasks
+  return !this->un_exited_ids_.empty() || this->hasUninterpreted();
+}
 
-uint32_t NetManager::nextSeq() noexcept(true) { return this->next_seq_++; }
+SeqNrT NetManager::nextSeq() noexcept(true) { return this->next_seq_++; }
 
-void NetManager::registerNewTaskManager(TaskManager &mgr,
+void NetManager::registerNewTaskManager(ContinuousNavigationManager &owner,
+                                        ContinuousNavigationSingleStepTask &mgr,
                                         std::vector<std::string> &&cancel_ids) noexcept(true) {
   // Attach to net
   mgr.attachToNet(this->net_);
@@ -695,6 +980,13 @@ void NetManager::registerNewTaskManager(TaskManager &mgr,
   sn.attachToNet(this->net_);
   cn.attachToNet(this->net_);
 
+  // The manager is owned by the ContinuousNavigationManager, until the time step is collected
+  auto &step = this->time_steps_.emplace_back();
+  step.continuous_navigation_steps.emplace_back(&owner, mgr.getNodeSequence());
+  this->addToTimeStep(step, mgr);
+  this->addToTimeStep(step, sn);
+  this->addToTimeStep(step, cn);
+
   // Exit logic
   this->un_exited_ids_.insert(mgr.exitedPlace());
   mgr.onExited([this](auto id) {
@@ -702,37 +994,44 @@ void NetManager::registerNewTaskManager(TaskManager &mgr,
     vda5050pp::core::interface_agv::HandleAccessor ha(this->handle_);
     ha.getLogger().logDebug(
         vda5050pp::core::common::format("Mgr exited: #UnExited={}", this->un_exited_ids_.size()));
-    if (this->un_exited_ids_.empty() && this->on_all_exited_ != nullptr) {
+    if (!this->isAnythingActive() && this->on_all_exited_ != nullptr) {
       this->on_all_exited_();
     }
   });
 
   // Places
-  this->fail_places_.push_back(this->net_.findPlace(mgr.failedPlace()));
-  this->finish_places_.push_back(this->net_.findPlace(mgr.finishedPlace()));
-  this->tail_place_->onChange(nullptr);
-  this->tail_place_ = this->net_.findPlace(cn.getPlaceID());
-  this->tail_place_->onChange([this](auto, auto) {
-    if (this->on_tail_reached_ != nullptr) this->on_tail_reached_();
-  });
+  step.fail_places.push_back(mgr.failedPlacePtr());
+  step.finish_places.push_back(mgr.finishedPlacePtr());
+  this->setTailPlace(step, this->net_.findPlace(cn.getPlaceID()));
 }
 
 const std::shared_ptr<Net::PlaceT> &NetManager::getTailPlace() const noexcept(true) {
   return this->tail_place_;
 }
 
-const std::vector<std::shared_ptr<Net::PlaceT>> &NetManager::getFinishPlaces() const
-    noexcept(true) {
-  return this->finish_places_;
+std::vector<std::shared_ptr<Net::PlaceT>> NetManager::getFinishPlaces() const noexcept(false) {
+  std::vector<std::shared_ptr<Net::PlaceT>> places;
+  for (const auto &step : this->time_steps_) {
+    places.insert(end(places), begin(step.finish_places), end(step.finish_places));
+  }
+  return places;
 }
 
-const std::vector<std::shared_ptr<Net::PlaceT>> &NetManager::getFailPlaces() const noexcept(true) {
-  return this->fail_places_;
+std::vector<std::shared_ptr<Net::PlaceT>> NetManager::getFailPlaces() const noexcept(false) {
+  std::vector<std::shared_ptr<Net::PlaceT>> places;
+  for (const auto &step : this->time_steps_) {
+    places.insert(end(places), begin(step.fail_places), end(step.fail_places));
+  }
+  return places;
 }
 
+const Net &NetManager::getNet() const noexcept(true) { return this->net_; }
+
 void NetManager::notifyHorizonChanged() noexcept(true) {
   vda5050pp::core::interface_agv::HandleAccessor ha(this->handle_);
   if (ha.isContinuousNavigation() && !this->continuous_navigation_managers_.empty()) {
     this->continuous_navigation_managers_.front()->horizonChanged();
   }
-}
\ No newline at end of file
+}
+
+NetTrace &NetManager::getNetTrace() noexcept(true) { return this->trace_; }
@@ -0,0 +1,61 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+
+#include "vda5050++/core/logic/net_template.h"
+
+using namespace vda5050pp::core::logic;
+
+void NetTemplate::instantiate(
+    Net &composed_net, SeqNrT seq,
+    const std::function<void(const Net::PlaceT &, Net::TokenCounterT)> &on_change) const
+    noexcept(false) {
+  for (std::size_t i = 0; i < this->num_places_; i++) {
+    auto place = composed_net.addPlace({this->places_[i].type, seq}, this->places_[i].tokens);
+    if (on_change != nullptr) {
+      place->onChange(on_change);
+    }
+  }
+
+  // One sketch for all transitions, so the arc vectors are only allocated once
+  Net::TransitionSketch sketch;
+  sketch.ingoing.reserve(TransitionTemplate::k_max_arcs);
+  sketch.outgoing.reserve(TransitionTemplate::k_max_arcs);
+
+  for (std::size_t i = 0; i < this->num_transitions_; i++) {
+    const auto &transition = this->transitions_[i];
+    sketch.id = {transition.type, seq};
+    sketch.ingoing.clear();
+    sketch.outgoing.clear();
+    for (uint8_t arc = 0; arc < transition.num_ingoing; arc++) {
+      sketch.ingoing.push_back({{transition.ingoing[arc], seq}, 1});
+    }
+    for (uint8_t arc = 0; arc < transition.num_outgoing; arc++) {
+      sketch.outgoing.push_back({{transition.outgoing[arc], seq}, 1});
+    }
+
+    composed_net.addTransition(sketch);
+    if (transition.auto_fire) {
+      composed_net.findTransition(sketch.id)->autoFire();
+    }
+  }
+}
+
+void NetTemplate::getIDs(SeqNrT seq, std::vector<LogicTaskNetID> &places,
+                         std::vector<LogicTaskNetID> &transitions) const noexcept(false) {
+  for (std::size_t i = 0; i < this->num_places_; i++) {
+    places.push_back({this->places_[i].type, seq});
+  }
+  for (std::size_t i = 0; i < this->num_transitions_; i++) {
+    transitions.push_back({this->transitions_[i].type, seq});
+  }
+}
+
+std::size_t NetTemplate::numPlaces() const noexcept(true) { return this->num_places_; }
+
+std::size_t NetTemplate::numTransitions() const noexcept(true) {
+  return this->num_transitions_;
+}
@@ -0,0 +1,276 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+
+#include "vda5050++/core/logic/net_trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <stdexcept>
+#include <thread>
+#include <unordered_set>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace vda5050pp::core::logic;
+
+static int64_t currentThread() noexcept(true) {
+  // gettid is a syscall, so it is only done once per thread
+#ifdef __linux__
+  thread_local int64_t tid = ::syscall(SYS_gettid);
+#else
+  thread_local int64_t tid =
+      static_cast<int64_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+#endif
+  return tid;
+}
+
+static int64_t nowNs() noexcept(true) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+static LogicTaskNetID fromKey(uint64_t key) noexcept(true) {
+  return {static_cast<LogicTaskNetTypes>(key & 0xff), static_cast<SeqNrT>(key >> 8)};
+}
+
+NetTrace::Ring::Ring(std::size_t capacity)
+    : slots(std::make_unique<Slot[]>(capacity)), capacity(capacity) {}
+
+void NetTrace::record(const Event &event) noexcept(true) {
+  auto ring = this->ring_.load(std::memory_order_acquire);
+  if (ring == nullptr) {
+    return;
+  }
+
+  auto index = ring->next.fetch_add(1, std::memory_order_relaxed);
+  auto &slot = ring->slots[index % ring->capacity];
+  slot.stamp.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.time_ns.store(event.time_ns, std::memory_order_relaxed);
+  slot.thread.store(event.thread, std::memory_order_relaxed);
+  slot.key.store(event.id.key(), std::memory_order_relaxed);
+  slot.data.store(static_cast<uint32_t>(event.type) | static_cast<uint32_t>(event.tokens) << 8 |
+                      static_cast<uint32_t>(event.prev_tokens) << 16,
+                  std::memory_order_relaxed);
+  slot.stamp.store(index + 1, std::memory_order_release);
+}
+
+void NetTrace::enable(std::size_t capacity) noexcept(false) {
+  if (capacity == 0) {
+    throw std::invalid_argument("NetTrace capacity must not be 0");
+  }
+  std::scoped_lock lock(this->rings_mutex_);
+  auto &ring = this->rings_.emplace_back(std::make_unique<Ring>(capacity));
+  this->ring_.store(ring.get(), std::memory_order_release);
+  this->epoch_.fetch_add(1, std::memory_order_relaxed);
+  this->enabled_.store(true, std::memory_order_relaxed);
+}
+
+void NetTrace::disable() noexcept(true) {
+  this->enabled_.store(false, std::memory_order_relaxed);
+  this->epoch_.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool NetTrace::isEnabled() const noexcept(true) {
+  return this->enabled_.load(std::memory_order_relaxed);
+}
+
+uint64_t NetTrace::getEpoch() const noexcept(true) {
+  return this->epoch_.load(std::memory_order_relaxed);
+}
+
+void NetTrace::recordPlace(const Net::PlaceT &place, Net::TokenCounterT prev) noexcept(true) {
+  if (this->isEnabled()) {
+    this->record({nowNs(), currentThread(), place.getID(), EventType::k_place, place.getTokens(),
+                  prev});
+  }
+}
+
+void NetTrace::recordTransition(const LogicTaskNetID &id) noexcept(true) {
+  if (this->isEnabled()) {
+    this->record({nowNs(), currentThread(), id, EventType::k_transition, 0, 0});
+  }
+}
+
+bool NetTrace::fire(Net::TransitionT &transition) noexcept(true) {
+  bool fired = transition.fire();
+  if (fired) {
+    this->recordTransition(transition.getID());
+  }
+  return fired;
+}
+
+bool NetTrace::deepFire(const Net &net, Net::TransitionT &transition) noexcept(true) {
+  if (!this->isEnabled()) {
+    return transition.deepFire();
+  }
+
+  // The cascade can only be fired here, if all consumers of the outgoing places are known
+  const auto &arcs = net.getArcs();
+  auto epoch = this->getEpoch();
+  auto outgoing = arcs.outgoing.find(transition.getID().key());
+  auto indexed = [&arcs, epoch](const LogicTaskNetID &place) {
+    auto it = arcs.consumers.find(place.key());
+    return it != arcs.consumers.end() && it->second.epoch == epoch;
+  };
+  if (outgoing == arcs.outgoing.end() ||
+      !std::all_of(outgoing->second.begin(), outgoing->second.end(), indexed)) {
+    bool fired = transition.deepFire();
+    if (fired) {
+      this->recordTransition(transition.getID());
+    }
+    return fired;
+  }
+
+  // Copied, the hooks of the fired places may change the net
+  auto places = outgoing->second;
+  if (!this->fire(transition)) {
+    return false;
+  }
+  for (const auto &place : places) {
+    auto consumers = arcs.consumers.find(place.key());
+    if (consumers == arcs.consumers.end()) {
+      continue;
+    }
+    auto transitions = consumers->second.transitions;
+    for (const auto &weak : transitions) {
+      // transitions removed from the net are not fired anymore
+      if (auto consumer = weak.lock(); consumer != nullptr && consumer->isAutoFire() &&
+                                       arcs.outgoing.count(consumer->getID().key()) > 0) {
+        this->deepFire(net, *consumer);
+      }
+    }
+  }
+  return true;
+}
+
+NetTrace::PlaceHook NetTrace::traced(PlaceHook fn) noexcept(false) {
+  if (!this->isEnabled()) {
+    return fn;
+  }
+  return [this, fn = std::move(fn)](const Net::PlaceT &place, Net::TokenCounterT prev) {
+    this->recordPlace(place, prev);
+    fn(place, prev);
+  };
+}
+
+NetTrace::PlaceHook NetTrace::hook() noexcept(false) {
+  if (!this->isEnabled()) {
+    return nullptr;
+  }
+  return [this](const Net::PlaceT &place, Net::TokenCounterT prev) {
+    this->recordPlace(place, prev);
+  };
+}
+
+std::vector<NetTrace::Event> NetTrace::getEvents() const noexcept(false) {
+  std::vector<Event> events;
+  auto ring = this->ring_.load(std::memory_order_acquire);
+  if (ring == nullptr) {
+    return events;
+  }
+
+  auto next = ring->next.load(std::memory_order_acquire);
+  auto size = std::min<uint64_t>(next, ring->capacity);
+  events.reserve(size);
+  for (auto i = next - size; i < next; i++) {
+    const auto &slot = ring->slots[i % ring->capacity];
+    auto stamp = slot.stamp.load(std::memory_order_acquire);
+    auto time_ns = slot.time_ns.load(std::memory_order_relaxed);
+    auto thread = slot.thread.load(std::memory_order_relaxed);
+    auto key = slot.key.load(std::memory_order_relaxed);
+    auto data = slot.data.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (stamp != i + 1 || slot.stamp.load(std::memory_order_relaxed) != stamp) {
+      continue;  // still written or already overwritten
+    }
+    events.push_back({time_ns, thread, fromKey(key), static_cast<EventType>(data & 0xff),
+                      static_cast<Net::TokenCounterT>(data >> 8 & 0xff),
+                      static_cast<Net::TokenCounterT>(data >> 16 & 0xff)});
+  }
+  return events;
+}
+
+uint64_t NetTrace::getDropped() const noexcept(true) {
+  auto ring = this->ring_.load(std::memory_order_acquire);
+  if (ring == nullptr) {
+    return 0;
+  }
+  auto next = ring->next.load(std::memory_order_relaxed);
+  return next > ring->capacity ? next - ring->capacity : 0;
+}
+
+void NetTrace::writeChromeTrace(std::ostream &os) const noexcept(false) {
+  auto events = this->getEvents();
+#ifdef __linux__
+  auto pid = static_cast<int64_t>(::getpid());
+#else
+  int64_t pid = 0;
+#endif
+  // The trace starts at the first event
+  auto begin_ns = events.empty() ? 0 : events.front().time_ns;
+  auto fill = os.fill();
+
+  // the keys of the places with an open slice
+  std::unordered_set<uint64_t> open;
+
+  os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool first = true;
+  for (const auto &event : events) {
+    const char *phase = nullptr;
+    const char *category = nullptr;
+    if (event.type == EventType::k_transition) {
+      phase = "i";
+      category = "transition";
+    } else if (event.prev_tokens == 0 && event.tokens > 0) {
+      phase = "b";
+      category = "place";
+    } else if (event.prev_tokens > 0 && event.tokens == 0) {
+      phase = "e";
+      category = "place";
+    } else {
+      phase = "n";
+      category = "place";
+    }
+
+    if (event.type == EventType::k_place) {
+      if (phase[0] == 'b') {
+        open.insert(event.id.key());
+      } else if (open.count(event.id.key()) == 0) {
+        continue;  // the begin of the slice was overwritten
+      } else if (phase[0] == 'e') {
+        open.erase(event.id.key());
+      }
+    }
+
+    os << (first ? "\n" : ",\n");
+    first = false;
+    // ts is in us, written with a fixed ns fraction (a double would lose it for long traces)
+    auto ns = event.time_ns - begin_ns;
+    os << "{\"name\":\"" << event.id << "\",\"cat\":\"" << category << "\",\"ph\":\"" << phase
+       << "\",\"ts\":" << ns / 1000 << '.' << std::setw(3) << std::setfill('0') << ns % 1000
+       << ",\"pid\":" << pid << ",\"tid\":" << event.thread;
+    if (event.type == EventType::k_transition) {
+      os << ",\"s\":\"t\"";
+    } else {
+      os << ",\"id\":\"0x" << std::hex << event.id.key() << std::dec << "\"";
+    }
+    os << ",\"args\":{\"seq\":" << event.id.seq;
+    if (event.type == EventType::k_place) {
+      os << ",\"tokens\":" << static_cast<int>(event.tokens)
+         << ",\"prev_tokens\":" << static_cast<int>(event.prev_tokens);
+    }
+    os << "}}";
+  }
+  os << "\n]}\n";
+  os.fill(fill);
+}
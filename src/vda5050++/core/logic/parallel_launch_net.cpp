@@ -8,12 +8,13 @@
 #include "vda5050++/core/logic/parallel_launch_net.h"
 
 #include <algorithm>
+#include <utility>
 
 using namespace vda5050pp::core::logic;
 
 ParallelLaunchNet::ParallelLaunchNet(LogicTaskNetID launch_point_id,
                                      std::vector<LogicTaskNetID> &&launch_ids)
-    : launch_point_id_(launch_point_id), launch_ids_(launch_ids) {}
+    : launch_point_id_(launch_point_id), launch_ids_(std::move(launch_ids)) {}
 
 LogicTaskNetID ParallelLaunchNet::getLaunchPointId() const noexcept(true) {
   return this->launch_point_id_;
@@ -32,13 +33,23 @@ void ParallelLaunchNet::attachToNet(Net &composed_net) noexcept(false) {
     return {id, 1};
   };
 
-  LogicTaskNetID id = {LogicTaskNetTypes::k_combinator_parallel, this->launch_point_id_.seq};
+  LogicTaskNetID id = this->getTransitionID();
 
   Net::TransitionSketch sketch{id, {to_unit_weight_pair(this->launch_point_id_)}, {}};
+  sketch.outgoing.reserve(this->launch_ids_.size());
 
   std::transform(cbegin(this->launch_ids_), cend(this->launch_ids_),
                  std::back_inserter(sketch.outgoing), to_unit_weight_pair);
 
   composed_net.addTransition(sketch);
   composed_net.findTransition(id)->autoFire();
-}
\ No newline at end of file
+}
+
+LogicTaskNetID ParallelLaunchNet::getTransitionID() const noexcept(true) {
+  return {LogicTaskNetTypes::k_combinator_parallel, this->launch_point_id_.seq};
+}
+
+void ParallelLaunchNet::getOwnIDs(std::vector<LogicTaskNetID> &,
+                                  std::vector<LogicTaskNetID> &transitions) const noexcept(false) {
+  transitions.push_back(this->getTransitionID());
+}
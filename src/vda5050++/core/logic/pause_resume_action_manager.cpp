@@ -11,6 +11,7 @@
 #include "vda5050++/core/interface_agv/handle_accessor.h"
 
 using namespace vda5050pp::core::logic;
+using vda5050pp::core::common::inlineTask;
 
 PauseResumeActionManager::PauseResumeActionManager(vda5050pp::interface_agv::Handle &handle,
                                                    const vda5050pp::Action &action)
@@ -25,7 +26,7 @@ PauseResumeActionManager::PauseResumeActionManager(vda5050pp::interface_agv::Han
 void PauseResumeActionManager::initialize() noexcept(true) {
   vda5050pp::core::interface_agv::HandleAccessor ha(this->handle_);
   auto &q = ha.getTaskQueue();
-  q.push([this] {
+  q.push(this, vda5050pp::core::common::TaskLane::k_stop, inlineTask([this] {
     try {
       if (this->pause_resume_handler_->is_pause_) {
         this->pause_resume_handler_->doPause();
@@ -43,7 +44,7 @@ void PauseResumeActionManager::initialize() noexcept(true) {
       ha.getState().addError(error);
       ha.getLogic().abortOrder();
     }
-  });
+  }));
 }
 
 void PauseResumeActionManager::started() noexcept(true) {
@@ -8,6 +8,7 @@
 #include "vda5050++/core/logic/sync_net.h"
 
 #include <algorithm>
+#include <utility>
 
 using namespace vda5050pp::core::logic;
 
@@ -16,7 +17,7 @@ void SyncNet::initTransitionID() {
 }
 
 SyncNet::SyncNet(std::vector<LogicTaskNetID> &&sync_ids, LogicTaskNetID self_id)
-    : sync_ids_(sync_ids), place_id_(self_id) {
+    : sync_ids_(std::move(sync_ids)), place_id_(self_id) {
   initTransitionID();
 }
 
@@ -39,13 +40,23 @@ void SyncNet::attachToNet(Net &composed_net) noexcept(false) {
 
   if (composed_net.findPlace(this->place_id_) == nullptr) {
     composed_net.addPlace(this->place_id_, 0);
+    this->owns_place_ = true;
   }
 
   Net::TransitionSketch sketch{this->transition_id_, {}, {to_unit_weight_pair(this->place_id_)}};
+  sketch.ingoing.reserve(this->sync_ids_.size());
 
   std::transform(cbegin(this->sync_ids_), cend(this->sync_ids_), std::back_inserter(sketch.ingoing),
                  to_unit_weight_pair);
 
   composed_net.addTransition(sketch);
   composed_net.findTransition(this->transition_id_)->autoFire();
-}
\ No newline at end of file
+}
+
+void SyncNet::getOwnIDs(std::vector<LogicTaskNetID> &places,
+                        std::vector<LogicTaskNetID> &transitions) const noexcept(false) {
+  if (this->owns_place_) {
+    places.push_back(this->place_id_);
+  }
+  transitions.push_back(this->transition_id_);
+}
@@ -8,138 +8,163 @@
 #include "vda5050++/core/logic/task_manager.h"
 
 #include "vda5050++/core/interface_agv/handle_accessor.h"
+#include "vda5050++/core/logic/net_template.h"
 
 using namespace vda5050pp::core::logic;
 
+// The partial net of each task, compiled once and instantiated for the seq of each manager
+static constexpr PlaceTemplate k_task_places[] = {
+    {LogicTaskNetTypes::k_ready, 0},
+    {LogicTaskNetTypes::k_enabled, 1},
+    {LogicTaskNetTypes::k_disabled, 0},
+    {LogicTaskNetTypes::k_entered, 0},
+    {LogicTaskNetTypes::k_exited, 0},
+    {LogicTaskNetTypes::k_initializing, 0},
+    {LogicTaskNetTypes::k_running, 0},
+    {LogicTaskNetTypes::k_paused, 0},
+    {LogicTaskNetTypes::k_finished, 0},
+    {LogicTaskNetTypes::k_failed, 0},
+    {LogicTaskNetTypes::k_done, 0},
+    {LogicTaskNetTypes::k_pre_done, 0},
+    {LogicTaskNetTypes::k_any_failed, 0},
+    {LogicTaskNetTypes::k_intercepted, 0},
+    {LogicTaskNetTypes::k_intercepted_parallel, 0},
+    {LogicTaskNetTypes::k_intercepted_sequential, 0},
+    {LogicTaskNetTypes::k_intercept_sync, 0},
+    {LogicTaskNetTypes::k_un_intercepted, 1},
+    {LogicTaskNetTypes::k_intercepting_begin, 0},
+    {LogicTaskNetTypes::k_intercepting_end, 0},
+};
+// {ID, ingoing, #ingoing, outgoing, #outgoing, auto fire}
+static constexpr TransitionTemplate k_task_transitions[] = {
+    // from ready to initializing, auto firing is enabled last by attachToNet
+    {LogicTaskNetTypes::k_start,
+     {LogicTaskNetTypes::k_ready, LogicTaskNetTypes::k_enabled},
+     2,
+     {LogicTaskNetTypes::k_initializing, LogicTaskNetTypes::k_entered},
+     2,
+     false},
+    {LogicTaskNetTypes::k_started,
+     {LogicTaskNetTypes::k_initializing},
+     1,
+     {LogicTaskNetTypes::k_running},
+     1,
+     false},
+    {LogicTaskNetTypes::k_pause,
+     {LogicTaskNetTypes::k_running},
+     1,
+     {LogicTaskNetTypes::k_paused},
+     1,
+     false},
+    {LogicTaskNetTypes::k_resume,
+     {LogicTaskNetTypes::k_paused},
+     1,
+     {LogicTaskNetTypes::k_running},
+     1,
+     false},
+    // fail transitions
+    {LogicTaskNetTypes::k_initializing_fail,
+     {LogicTaskNetTypes::k_initializing},
+     1,
+     {LogicTaskNetTypes::k_any_failed},
+     1,
+     false},
+    {LogicTaskNetTypes::k_running_fail,
+     {LogicTaskNetTypes::k_running},
+     1,
+     {LogicTaskNetTypes::k_any_failed},
+     1,
+     false},
+    {LogicTaskNetTypes::k_paused_fail,
+     {LogicTaskNetTypes::k_paused},
+     1,
+     {LogicTaskNetTypes::k_any_failed},
+     1,
+     false},
+    // done transitions
+    {LogicTaskNetTypes::k_fail,
+     {LogicTaskNetTypes::k_any_failed},
+     1,
+     {LogicTaskNetTypes::k_pre_done, LogicTaskNetTypes::k_failed, LogicTaskNetTypes::k_exited},
+     3,
+     true},
+    {LogicTaskNetTypes::k_finish,
+     {LogicTaskNetTypes::k_running},
+     1,
+     {LogicTaskNetTypes::k_pre_done, LogicTaskNetTypes::k_finished, LogicTaskNetTypes::k_exited},
+     3,
+     false},
+    // disable and skip transitions
+    {LogicTaskNetTypes::k_disable,
+     {LogicTaskNetTypes::k_enabled},
+     1,
+     {LogicTaskNetTypes::k_disabled},
+     1,
+     false},
+    {LogicTaskNetTypes::k_skip,
+     {LogicTaskNetTypes::k_disabled, LogicTaskNetTypes::k_ready},
+     2,
+     {LogicTaskNetTypes::k_any_failed},
+     1,
+     true},
+    // normal flow
+    {LogicTaskNetTypes::k_pre_to_done,
+     {LogicTaskNetTypes::k_pre_done, LogicTaskNetTypes::k_un_intercepted},
+     2,
+     {LogicTaskNetTypes::k_done},
+     1,
+     true},
+    // intercept
+    {LogicTaskNetTypes::k_intercept,
+     {LogicTaskNetTypes::k_un_intercepted},
+     1,
+     {LogicTaskNetTypes::k_intercepted},
+     1,
+     false},
+    // sequential flow
+    {LogicTaskNetTypes::k_intercept_sequential,
+     {LogicTaskNetTypes::k_intercepted},
+     1,
+     {LogicTaskNetTypes::k_intercepted_sequential},
+     1,
+     false},
+    {LogicTaskNetTypes::k_sequential_to_intercepting,
+     {LogicTaskNetTypes::k_pre_done, LogicTaskNetTypes::k_intercepted_sequential},
+     2,
+     {LogicTaskNetTypes::k_intercepting_begin, LogicTaskNetTypes::k_intercept_sync},
+     2,
+     true},
+    // parallel flow
+    {LogicTaskNetTypes::k_intercept_parallel,
+     {LogicTaskNetTypes::k_intercepted},
+     1,
+     {LogicTaskNetTypes::k_intercepted_parallel, LogicTaskNetTypes::k_intercepting_begin},
+     2,
+     false},
+    {LogicTaskNetTypes::k_parallel_to_intercepting,
+     {LogicTaskNetTypes::k_intercepted_parallel, LogicTaskNetTypes::k_pre_done},
+     2,
+     {LogicTaskNetTypes::k_intercept_sync},
+     1,
+     true},
+    // intercepted done flow
+    {LogicTaskNetTypes::k_intercepting_to_done,
+     {LogicTaskNetTypes::k_intercepting_end, LogicTaskNetTypes::k_intercept_sync},
+     2,
+     {LogicTaskNetTypes::k_done},
+     1,
+     true},
+};
+static constexpr NetTemplate k_task_net(k_task_places, k_task_transitions);
+
 TaskManager::TaskManager(vda5050pp::interface_agv::Handle &handle, SeqNrT seq)
-    : handle_(handle), seq_(seq) {}
+    : handle_(handle),
+      seq_(seq),
+      trace_(vda5050pp::core::interface_agv::HandleAccessor(handle).getLogic().getNetTrace()) {}
 
 void TaskManager::attachToNet(Net &composed_net) noexcept(false) {
-  Net transaction_net;
-
-  // Create all places for the partial net
-  transaction_net.addPlace({LogicTaskNetTypes::k_ready, this->seq_}, 0);
-  transaction_net.addPlace({LogicTaskNetTypes::k_enabled, this->seq_}, 1);
-  transaction_net.addPlace({LogicTaskNetTypes::k_disabled, this->seq_}, 0);
-  transaction_net.addPlace({LogicTaskNetTypes::k_entered, this->seq_}, 0);
-  transaction_net.addPlace({LogicTaskNetTypes::k_exited, this->seq_}, 0);
-  transaction_net.addPlace({LogicTaskNetTypes::k_initializing, this->seq_}, 0);
-  transaction_net.addPlace({LogicTaskNetTypes::k_running, this->seq_}, 0);
-  transaction_net.addPlace({LogicTaskNetTypes::k_paused, this->seq_}, 0);
-  transaction_net.addPlace({LogicTaskNetTypes::k_finished, this->seq_}, 0);
-  transaction_net.addPlace({LogicTaskNetTypes::k_failed, this->seq_}, 0);
-  transaction_net.addPlace({LogicTaskNetTypes::k_done, this->seq_}, 0);
-  transaction_net.addPlace({LogicTaskNetTypes::k_pre_done, this->seq_}, 0);
-  transaction_net.addPlace({LogicTaskNetTypes::k_any_failed, this->seq_}, 0);
-  transaction_net.addPlace({LogicTaskNetTypes::k_intercepted, this->seq_}, 0);
-  transaction_net.addPlace({LogicTaskNetTypes::k_intercepted_parallel, this->seq_}, 0);
-  transaction_net.addPlace({LogicTaskNetTypes::k_intercepted_sequential, this->seq_}, 0);
-  transaction_net.addPlace({LogicTaskNetTypes::k_intercept_sync, this->seq_}, 0);
-  transaction_net.addPlace({LogicTaskNetTypes::k_un_intercepted, this->seq_}, 1);
-  transaction_net.addPlace({LogicTaskNetTypes::k_intercepting_begin, this->seq_}, 0);
-  transaction_net.addPlace({LogicTaskNetTypes::k_intercepting_end, this->seq_}, 0);
-
-  // Create all transitions from ready to finished over paused
-  transaction_net.addTransition(
-      {{LogicTaskNetTypes::k_start, this->seq_},               // ID
-       {{{LogicTaskNetTypes::k_ready, this->seq_}, 1},         // from ready
-        {{LogicTaskNetTypes::k_enabled, this->seq_}, 1}},      // from enabled
-       {{{LogicTaskNetTypes::k_initializing, this->seq_}, 1},  // to initializing
-        {{LogicTaskNetTypes::k_entered, this->seq_}, 1}}});    // to entered
-  transaction_net.addTransition(
-      {{LogicTaskNetTypes::k_started, this->seq_},                          // ID
-       {{{LogicTaskNetTypes::k_initializing, this->seq_}, 1}},              // from initializing
-       {{{LogicTaskNetTypes::k_running, this->seq_}, 1}}});                 // to running
-  transaction_net.addTransition({{LogicTaskNetTypes::k_pause, this->seq_},  // ID
-                                 {{{LogicTaskNetTypes::k_running, this->seq_}, 1}},  // from running
-                                 {{{LogicTaskNetTypes::k_paused, this->seq_}, 1}}});  // to pausing
-  transaction_net.addTransition({{LogicTaskNetTypes::k_resume, this->seq_},           // ID
-                                 {{{LogicTaskNetTypes::k_paused, this->seq_}, 1}},    // from paused
-                                 {{{LogicTaskNetTypes::k_running, this->seq_}, 1}}});  // to running
-
-  // Create all fail transitions
-  transaction_net.addTransition(
-      {{LogicTaskNetTypes::k_initializing_fail, this->seq_},    // ID
-       {{{LogicTaskNetTypes::k_initializing, this->seq_}, 1}},  // from initializing
-       {{{LogicTaskNetTypes::k_any_failed, this->seq_}, 1}}});  // to any_failed
-  transaction_net.addTransition(
-      {{LogicTaskNetTypes::k_running_fail, this->seq_},         // ID
-       {{{LogicTaskNetTypes::k_running, this->seq_}, 1}},       // from running
-       {{{LogicTaskNetTypes::k_any_failed, this->seq_}, 1}}});  // to any_failed
-  transaction_net.addTransition(
-      {{LogicTaskNetTypes::k_paused_fail, this->seq_},          // ID
-       {{{LogicTaskNetTypes::k_paused, this->seq_}, 1}},        // from paused
-       {{{LogicTaskNetTypes::k_any_failed, this->seq_}, 1}}});  // to any_failed
-
-  // done transitions
-  transaction_net.addTransition(
-      {{LogicTaskNetTypes::k_fail, this->seq_},               // ID
-       {{{LogicTaskNetTypes::k_any_failed, this->seq_}, 1}},  // from any_failed
-       {{{LogicTaskNetTypes::k_pre_done, this->seq_}, 1},     // to pre_done
-        {{LogicTaskNetTypes::k_failed, this->seq_}, 1},       // to failed
-        {{LogicTaskNetTypes::k_exited, this->seq_}, 1}}});    // to exited
-  transaction_net.addTransition(
-      {{LogicTaskNetTypes::k_finish, this->seq_},           // ID
-       {{{LogicTaskNetTypes::k_running, this->seq_}, 1}},   // from running:
-       {{{LogicTaskNetTypes::k_pre_done, this->seq_}, 1},   // to pre_done
-        {{LogicTaskNetTypes::k_finished, this->seq_}, 1},   // to finished
-        {{LogicTaskNetTypes::k_exited, this->seq_}, 1}}});  // to exiteded
-
-  // disable and skip transitions
-  transaction_net.addTransition(
-      {{LogicTaskNetTypes::k_disable, this->seq_},            // ID
-       {{{LogicTaskNetTypes::k_enabled, this->seq_}, 1}},     // from enabled
-       {{{LogicTaskNetTypes::k_disabled, this->seq_}, 1}}});  // to disabled
-  transaction_net.addTransition(
-      {{LogicTaskNetTypes::k_skip, this->seq_},                 // ID
-       {{{LogicTaskNetTypes::k_disabled, this->seq_}, 1},       // from ready
-        {{LogicTaskNetTypes::k_ready, this->seq_}, 1}},         // from enabled
-       {{{LogicTaskNetTypes::k_any_failed, this->seq_}, 1}}});  // to disabled
-
-  // normal flow
-  transaction_net.addTransition(
-      {{LogicTaskNetTypes::k_pre_to_done, this->seq_},            // ID
-       {{{LogicTaskNetTypes::k_pre_done, this->seq_}, 1},         // from pre_done
-        {{LogicTaskNetTypes::k_un_intercepted, this->seq_}, 1}},  // from un_intercepted
-       {{{LogicTaskNetTypes::k_done, this->seq_}, 1}}});          // to done
-  // intercept
-  transaction_net.addTransition(
-      {{LogicTaskNetTypes::k_intercept, this->seq_},              // ID
-       {{{LogicTaskNetTypes::k_un_intercepted, this->seq_}, 1}},  // from un_intercepted
-       {{{LogicTaskNetTypes::k_intercepted, this->seq_}, 1}}});   // to intercepted
-  // sequential flow
-  transaction_net.addTransition(
-      {{LogicTaskNetTypes::k_intercept_sequential, this->seq_},  // ID
-       {{{LogicTaskNetTypes::k_intercepted, this->seq_}, 1}},    // from un_intercepted
-       {{{LogicTaskNetTypes::k_intercepted_sequential, this->seq_},
-         1}}});  // to intercepted_sequential
-  transaction_net.addTransition(
-      {{LogicTaskNetTypes::k_sequential_to_intercepting, this->seq_},  // ID
-       {{{LogicTaskNetTypes::k_pre_done, this->seq_}, 1},              // from pre_done
-        {{LogicTaskNetTypes::k_intercepted_sequential, this->seq_},
-         1}},                                                        // from intercepted_sequential
-       {{{LogicTaskNetTypes::k_intercepting_begin, this->seq_}, 1},  // to intercepting_begin
-        {{LogicTaskNetTypes::k_intercept_sync, this->seq_}, 1}}});   // to intercept_sync
-  // parallel flow
-  transaction_net.addTransition(
-      {{LogicTaskNetTypes::k_intercept_parallel, this->seq_},           // ID
-       {{{LogicTaskNetTypes::k_intercepted, this->seq_}, 1}},           // from un_intercepted
-       {{{LogicTaskNetTypes::k_intercepted_parallel, this->seq_}, 1},   // to intercepted_parallel
-        {{LogicTaskNetTypes::k_intercepting_begin, this->seq_}, 1}}});  // to intercepting_begin
-  transaction_net.addTransition(
-      {{LogicTaskNetTypes::k_parallel_to_intercepting, this->seq_},    // ID
-       {{{LogicTaskNetTypes::k_intercepted_parallel, this->seq_}, 1},  // from intercepted_parallel
-        {{LogicTaskNetTypes::k_pre_done, this->seq_}, 1}},             // from pre_done
-       {{{LogicTaskNetTypes::k_intercept_sync, this->seq_}, 1}}});     // to intercept_sync
-  // intercepted done flow
-  transaction_net.addTransition(
-      {{LogicTaskNetTypes::k_intercepting_to_done, this->seq_},    // ID
-       {{{LogicTaskNetTypes::k_intercepting_end, this->seq_}, 1},  // from intercepting_end
-        {{LogicTaskNetTypes::k_intercept_sync, this->seq_}, 1}},   // from intercept_sync
-       {{{LogicTaskNetTypes::k_done, this->seq_}, 1}}});           // to done
-
-  // Merge transaction net to the composed global net
-  composed_net.merge(std::move(transaction_net), {});
+  this->net_ = &composed_net;
+  k_task_net.instantiate(composed_net, this->seq_, this->trace_.hook());
 
   auto if_reached_then = [this](auto fn) {
     return [this, fn](auto &place, auto prev) {
@@ -152,15 +177,15 @@ void TaskManager::attachToNet(Net &composed_net) noexcept(false) {
 
   // Place hooks
   composed_net.findPlace({LogicTaskNetTypes::k_initializing, this->seq_})
-      ->onChange(if_reached_then([this] { this->taskInitialize(); }));
+      ->onChange(this->trace_.traced(if_reached_then([this] { this->taskInitialize(); })));
   composed_net.findPlace({LogicTaskNetTypes::k_running, this->seq_})
-      ->onChange(if_reached_then([this] { this->taskRunning(); }));
+      ->onChange(this->trace_.traced(if_reached_then([this] { this->taskRunning(); })));
   composed_net.findPlace({LogicTaskNetTypes::k_paused, this->seq_})
-      ->onChange(if_reached_then([this] { this->taskPaused(); }));
+      ->onChange(this->trace_.traced(if_reached_then([this] { this->taskPaused(); })));
   composed_net.findPlace({LogicTaskNetTypes::k_finished, this->seq_})
-      ->onChange(if_reached_then([this] { this->taskFinished(); }));
+      ->onChange(this->trace_.traced(if_reached_then([this] { this->taskFinished(); })));
   composed_net.findPlace({LogicTaskNetTypes::k_failed, this->seq_})
-      ->onChange(if_reached_then([this] { this->taskFailed(); }));
+      ->onChange(this->trace_.traced(if_reached_then([this] { this->taskFailed(); })));
 
   // Store some transitions for manual firing
   this->transition_initializing_fail_ =
@@ -194,20 +219,32 @@ void TaskManager::attachToNet(Net &composed_net) noexcept(false) {
   this->place_entered_ = composed_net.findPlace({LogicTaskNetTypes::k_entered, this->seq_});
   this->place_exited_ = composed_net.findPlace({LogicTaskNetTypes::k_exited, this->seq_});
 
-  // auto firing
-  this->transition_fail_->autoFire();
-  composed_net.findTransition({LogicTaskNetTypes::k_skip, this->seq_})->autoFire();
-  composed_net.findTransition({LogicTaskNetTypes::k_intercepting_to_done, this->seq_})->autoFire();
-  composed_net.findTransition({LogicTaskNetTypes::k_parallel_to_intercepting, this->seq_})
-      ->autoFire();
-  composed_net.findTransition({LogicTaskNetTypes::k_sequential_to_intercepting, this->seq_})
-      ->autoFire();
-  composed_net.findTransition({LogicTaskNetTypes::k_pre_to_done, this->seq_})->autoFire();
+  this->place_entered_->onChange(this->trace_.traced([this](auto &place, auto prev) {
+    if (place.getTokens() == 1 && prev == 0 && this->on_active_changed_ != nullptr) {
+      this->on_active_changed_(true);
+    }
+  }));
+  this->place_exited_->onChange(this->trace_.traced([this](auto &place, auto prev) {
+    if (place.getTokens() == 1 && prev == 0) {
+      this->logPlaceReached(place);
+      if (this->on_active_changed_ != nullptr) {
+        this->on_active_changed_(false);
+      }
+      if (this->on_exited_ != nullptr) {
+        this->on_exited_(place.getID());
+      }
+    }
+  }));
 
   // This enables this branch of the net, for safety enable it last
   composed_net.findTransition({LogicTaskNetTypes::k_start, this->seq_})->autoFire();
 }
 
+void TaskManager::getOwnIDs(std::vector<LogicTaskNetID> &places,
+                            std::vector<LogicTaskNetID> &transitions) const noexcept(false) {
+  k_task_net.getIDs(this->seq_, places, transitions);
+}
+
 LogicTaskNetID TaskManager::readyPlace() const noexcept(true) {
   return {LogicTaskNetTypes::k_ready, this->seq_};
 }
@@ -225,6 +262,16 @@ LogicTaskNetID TaskManager::exitedPlace() const noexcept(true) {
   return {LogicTaskNetTypes::k_exited, this->seq_};
 }
 
+const std::shared_ptr<Net::PlaceT> &TaskManager::failedPlacePtr() const noexcept(true) {
+  return this->place_failed_;
+}
+const std::shared_ptr<Net::PlaceT> &TaskManager::finishedPlacePtr() const noexcept(true) {
+  return this->place_finished_;
+}
+const std::shared_ptr<Net::PlaceT> &TaskManager::exitedPlacePtr() const noexcept(true) {
+  return this->place_exited_;
+}
+
 LogicTaskNetID TaskManager::interceptingBeginPlace() const noexcept(true) {
   return {LogicTaskNetTypes::k_intercepting_begin, this->seq_};
 }
@@ -234,34 +281,36 @@ LogicTaskNetID TaskManager::interceptingEndPlace() const noexcept(true) {
 }
 
 void TaskManager::onExited(std::function<void(LogicTaskNetID exit_id)> fn) noexcept(true) {
-  this->place_exited_->onChange([this, fn](const auto &place, auto before) {
-    if (place.getTokens() == 1 && before == 0) {
-      this->logPlaceReached(place);
-      if (fn != nullptr) {
-        fn(place.getID());
-      }
-    }
-  });
+  this->on_exited_ = std::move(fn);
+}
+
+void TaskManager::onActiveChanged(std::function<void(bool active)> fn) noexcept(true) {
+  this->on_active_changed_ = std::move(fn);
+}
+
+bool TaskManager::fireTraced(Net::TransitionT &transition, bool deep) noexcept(true) {
+  return deep ? this->trace_.deepFire(*this->net_, transition) : this->trace_.fire(transition);
 }
 
 bool TaskManager::started() noexcept(true) {
-  return this->logTransition("started()", this->transition_started_->deepFire());
+  return this->logTransition("started()", this->fireTraced(*this->transition_started_));
 }
 bool TaskManager::finished() noexcept(true) {
-  return this->logTransition("finished()", this->transition_finish_->deepFire());
+  return this->logTransition("finished()", this->fireTraced(*this->transition_finish_));
 }
 bool TaskManager::failed() noexcept(true) {
-  return this->logTransition("failed()", this->transition_paused_fail_->deepFire() ||
-                                             this->transition_initializing_fail_->deepFire() ||
-                                             this->transition_running_fail_->deepFire());
+  return this->logTransition("failed()",
+                             this->fireTraced(*this->transition_paused_fail_) ||
+                                 this->fireTraced(*this->transition_initializing_fail_) ||
+                                 this->fireTraced(*this->transition_running_fail_));
 }
 
 bool TaskManager::paused() noexcept(true) {
-  return this->logTransition("pause()", this->transition_pause_->deepFire());
+  return this->logTransition("pause()", this->fireTraced(*this->transition_pause_));
 }
 
 bool TaskManager::resumed() noexcept(true) {
-  return this->logTransition("resume()", this->transition_resume_->deepFire());
+  return this->logTransition("resume()", this->fireTraced(*this->transition_resume_));
 }
 
 bool TaskManager::isRunning() noexcept(true) { return this->place_running_->getTokens() == 1; }
@@ -276,20 +325,20 @@ bool TaskManager::isInitializing() noexcept(true) {
   return this->place_initializing_->getTokens() == 1;
 }
 bool TaskManager::cancel() noexcept(true) {
-  return this->logTransition("disable()", this->transition_disable_->deepFire());
+  return this->logTransition("disable()", this->fireTraced(*this->transition_disable_));
 }
 
 bool TaskManager::intercept() noexcept(true) {
-  return this->logTransition("intercept()", this->transition_intercept_->fire());
+  return this->logTransition("intercept()", this->fireTraced(*this->transition_intercept_, false));
 }
 
 bool TaskManager::interceptParallel() noexcept(true) {
   return this->logTransition("interceptParallel()",
-                             this->transition_intercept_parallel_->deepFire());
+                             this->fireTraced(*this->transition_intercept_parallel_));
 }
 bool TaskManager::interceptSequential() noexcept(true) {
   return this->logTransition("interceptSequential()",
-                             this->transition_intercept_sequential_->deepFire());
+                             this->fireTraced(*this->transition_intercept_sequential_));
 }
 
 SeqNrT TaskManager::getSeq() const noexcept(true) { return this->seq_; }
\ No newline at end of file
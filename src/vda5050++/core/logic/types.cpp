@@ -0,0 +1,58 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+
+#include "vda5050++/core/logic/types.h"
+
+#include "vda5050++/core/logic/net_trace.h"
+
+using namespace vda5050pp::core::logic;
+
+void Net::setTrace(NetTrace *trace) noexcept(true) { this->trace_ = trace; }
+
+const Net::Arcs &Net::getArcs() const noexcept(true) { return this->arcs_; }
+
+std::shared_ptr<Net::PlaceT> Net::addPlace(const LogicTaskNetID &id,
+                                           TokenCounterT tokens) noexcept(false) {
+  auto place = this->BaseT::addPlace(id, tokens);
+  if (this->trace_ != nullptr && this->trace_->isEnabled()) {
+    this->arcs_.consumers[id.key()] = {this->trace_->getEpoch(), {}};
+  }
+  return place;
+}
+
+void Net::addTransition(const TransitionSketch &sketch) noexcept(false) {
+  this->BaseT::addTransition(sketch);
+  if (this->trace_ == nullptr || !this->trace_->isEnabled()) {
+    return;
+  }
+
+  auto transition = this->findTransition(sketch.id);
+  for (const auto &arc : sketch.ingoing) {
+    if (auto it = this->arcs_.consumers.find(arc.first.key()); it != this->arcs_.consumers.end()) {
+      it->second.transitions.push_back(transition);
+    }
+  }
+  auto &outgoing = this->arcs_.outgoing[sketch.id.key()];
+  outgoing.clear();
+  for (const auto &arc : sketch.outgoing) {
+    outgoing.push_back(arc.first);
+  }
+}
+
+void Net::removePlace(const LogicTaskNetID &id) noexcept(true) {
+  this->BaseT::removePlace(id);
+  if (!this->arcs_.consumers.empty()) {
+    this->arcs_.consumers.erase(id.key());
+  }
+}
+
+void Net::removeTransition(const LogicTaskNetID &id) noexcept(true) {
+  this->BaseT::removeTransition(id);
+  if (!this->arcs_.outgoing.empty()) {
+    this->arcs_.outgoing.erase(id.key());
+  }
+}
@@ -55,7 +55,7 @@ vda5050pp::Header Messages::mkHeader(uint32_t seq) const noexcept(true) {
 
   vda5050pp::Header header;
   header.headerId = seq;
-  header.timestamp = std::chrono::system_clock::now();
+  header.timestamp = this->handle_.now();
   header.version = vda5050pp::core::version::current;
   header.manufacturer = ha.getAGVDescription().manufacturer;
   header.serialNumber = ha.getAGVDescription().serial_number;
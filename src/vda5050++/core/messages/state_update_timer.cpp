@@ -20,18 +20,14 @@ using namespace vda5050pp::core::messages;
 
 void StateUpdateTimer::timerRoutine() {
   vda5050pp::core::interface_agv::HandleAccessor ha(this->handle_);
+  ha.getThreadRegistry().enter(vda5050pp::core::common::ThreadingConfig::k_state_update_role);
 
   TimePointT wakeup_time_point;
 
   ha.getLogger().logDebug("StateUpdateTimer: starting...\n");
 
   while (this->active_) {
-    wakeup_time_point = this->last_sent_ + ha.getStateUpdatePeriod();
-
-    // If there was any request for an earlier update, use it.
-    if (this->next_scheduled_update_.has_value()) {
-      wakeup_time_point = std::min(wakeup_time_point, *this->next_scheduled_update_);
-    }
+    wakeup_time_point = this->nextWakeupTimePoint();
 
 #ifdef HAVE_CTIME_LOCALTIME_R
     auto c_time = std::chrono::system_clock::to_time_t(wakeup_time_point);
@@ -47,7 +43,7 @@ void StateUpdateTimer::timerRoutine() {
       // Timer was not interrupted, so there is no new update time point
       ha.getMessages().sendState();
 
-      this->last_sent_ = std::chrono::system_clock::now();
+      this->last_sent_ = this->handle_.now();
       this->next_scheduled_update_.reset();
     } else {
       // Timer was interrupted, so there is a new update time point,
@@ -56,41 +52,99 @@ void StateUpdateTimer::timerRoutine() {
   }
 
   ha.getLogger().logDebug("StateUpdateTimer: exiting...\n");
+  ha.getThreadRegistry().leave();
+}
+
+StateUpdateTimer::TimePointT StateUpdateTimer::nextWakeupTimePoint() const noexcept(true) {
+  vda5050pp::core::interface_agv::HandleAccessor ha(this->handle_);
+
+  auto wakeup_time_point = this->last_sent_ + ha.getStateUpdatePeriod();
+
+  // If there was any request for an earlier update, use it.
+  if (this->next_scheduled_update_.has_value()) {
+    wakeup_time_point = std::min(wakeup_time_point, *this->next_scheduled_update_);
+  }
+
+  return wakeup_time_point;
+}
+
+void StateUpdateTimer::scheduleOnExecutor() noexcept(true) {
+  if (this->executor_timer_.has_value()) {
+    this->executor_->cancel(*this->executor_timer_);
+  }
+
+  auto task = [this] {
+    {
+      std::scoped_lock lock(this->executor_mutex_);
+      this->executor_timer_.reset();
+    }
+    vda5050pp::core::interface_agv::HandleAccessor(this->handle_).getMessages().sendState();
+
+    std::scoped_lock lock(this->executor_mutex_);
+    this->last_sent_ = this->executor_->now();
+    this->next_scheduled_update_.reset();
+    this->scheduleOnExecutor();
+  };
+  this->executor_timer_ =
+      this->executor_->schedule(&this->handle_, this->nextWakeupTimePoint(), std::move(task));
 }
 
 StateUpdateTimer::StateUpdateTimer(vda5050pp::interface_agv::Handle &handle)
-    : active_(true), handle_(handle) {
-  this->last_sent_ = std::chrono::system_clock::now();
+    : active_(true),
+      handle_(handle),
+      executor_(vda5050pp::core::interface_agv::HandleAccessor(handle).getSharedExecutor()) {
+  this->last_sent_ = this->handle_.now();
+  if (this->executor_ != nullptr) {
+    std::scoped_lock lock(this->executor_mutex_);
+    this->scheduleOnExecutor();
+    return;
+  }
   auto this_timerRoutine = std::bind(std::mem_fn(&StateUpdateTimer::timerRoutine), this);
   this->thread_ = std::make_unique<std::thread>(this_timerRoutine);
 }
 
 StateUpdateTimer::~StateUpdateTimer() {
   this->active_ = false;
+  if (this->executor_ != nullptr) {
+    // The Handle detached from the executor before, so the timer is not running
+    if (this->executor_timer_.has_value()) {
+      this->executor_->cancel(*this->executor_timer_);
+    }
+    return;
+  }
   this->timer_.disable();
   this->thread_->join();
   this->thread_.reset();
 }
 
 void StateUpdateTimer::requestUpdate(UpdateUrgency urgency) noexcept(true) {
-  auto update_time_point = std::chrono::system_clock::now() + durationFromUpdateUrgency(urgency);
-
-  if (this->next_scheduled_update_.has_value()) {
-    update_time_point = std::min(update_time_point, *this->next_scheduled_update_);
-  }
-
   if (urgency == UpdateUrgency::k_immediate) {
     // Immediate requires blocking until the state is actually sent
     // -> Send it synchronously
     auto &msgs = vda5050pp::core::interface_agv::HandleAccessor(this->handle_).getMessages();
     msgs.sendState();
-    this->last_sent_ = std::chrono::system_clock::now();
-    this->next_scheduled_update_.reset();
-    this->timer_.interruptAll();  // cancel current sleep
+  }
 
+  std::unique_lock lock(this->executor_mutex_, std::defer_lock);
+  if (this->executor_ != nullptr) {
+    lock.lock();
+  }
+
+  if (urgency == UpdateUrgency::k_immediate) {
+    this->last_sent_ = this->handle_.now();
+    this->next_scheduled_update_.reset();
   } else {
-    // Set new update timepoint and interrupt
+    // Set new update timepoint
+    auto update_time_point = this->handle_.now() + durationFromUpdateUrgency(urgency);
+    if (this->next_scheduled_update_.has_value()) {
+      update_time_point = std::min(update_time_point, *this->next_scheduled_update_);
+    }
     this->next_scheduled_update_ = update_time_point;
-    this->timer_.interruptAll();
+  }
+
+  if (this->executor_ != nullptr) {
+    this->scheduleOnExecutor();
+  } else {
+    this->timer_.interruptAll();  // cancel current sleep
   }
 }
\ No newline at end of file
@@ -88,17 +88,38 @@ vda5050pp::Action StateManager::getActionById(const std::string &id) const noexc
   return it->second;
 }
 
+std::optional<vda5050pp::Action> StateManager::tryGetActionById(const std::string &id) const
+    noexcept(true) {
+  auto lock = this->state_.acquireShared();
+
+  auto it = this->state_.action_by_id.find(id);
+
+  if (it == end(this->state_.action_by_id)) {
+    return std::nullopt;
+  }
+
+  return it->second;
+}
+
 void StateManager::setActionStatus(const std::string &id,
                                    vda5050pp::ActionStatus status) noexcept(false) {
+  if (!this->trySetActionStatus(id, status)) {
+    throw std::invalid_argument("No action associated with id: " + id);
+  }
+}
+
+bool StateManager::trySetActionStatus(const std::string &id,
+                                      vda5050pp::ActionStatus status) noexcept(true) {
   auto lock = this->state_.acquire();
 
   auto it = this->state_.action_state_by_id.find(id);
 
   if (it == end(this->state_.action_state_by_id)) {
-    throw std::invalid_argument("No action associated with id: " + id);
+    return false;
   }
 
   it->second.actionStatus = status;
+  return true;
 }
 
 void StateManager::setActionResult(const std::string &id,
@@ -520,6 +541,7 @@ bool StateManager::isNode(uint32_t seq) noexcept(true) { return seq % 2 == 0; }
 bool StateManager::isEdge(uint32_t seq) noexcept(true) { return seq % 2 != 0; }
 
 vda5050pp::Node StateManager::getNodeBySeq(uint32_t seq) const noexcept(false) {
+  auto lock = this->state_.acquireShared();
   auto pair = this->state_.node_by_seq.find(seq);
 
   if (pair == end(this->state_.node_by_seq)) {
@@ -529,6 +551,17 @@ vda5050pp::Node StateManager::getNodeBySeq(uint32_t seq) const noexcept(false) {
   return pair->second;
 }
 
+std::optional<vda5050pp::Node> StateManager::tryGetNodeBySeq(uint32_t seq) const noexcept(true) {
+  auto lock = this->state_.acquireShared();
+  auto pair = this->state_.node_by_seq.find(seq);
+
+  if (pair == end(this->state_.node_by_seq)) {
+    return std::nullopt;
+  }
+
+  return pair->second;
+}
+
 vda5050pp::Edge StateManager::getEdgeBySeq(uint32_t seq) const noexcept(false) {
   auto lock = this->state_.acquireShared();
   auto pair = this->state_.edge_by_seq.find(seq);
@@ -540,6 +573,17 @@ vda5050pp::Edge StateManager::getEdgeBySeq(uint32_t seq) const noexcept(false) {
   return pair->second;
 }
 
+std::optional<vda5050pp::Edge> StateManager::tryGetEdgeBySeq(uint32_t seq) const noexcept(true) {
+  auto lock = this->state_.acquireShared();
+  auto pair = this->state_.edge_by_seq.find(seq);
+
+  if (pair == end(this->state_.edge_by_seq)) {
+    return std::nullopt;
+  }
+
+  return pair->second;
+}
+
 uint32_t StateManager::getGraphBaseSeqId() const noexcept(true) {
   return this->state_.graph_base_seq_id;
 }
@@ -8,67 +8,36 @@
 #include "vda5050++/core/validation/action_declared_validator.h"
 
 #include <algorithm>
-#include <limits>
 #include <optional>
-#include <sstream>
 #include <string>
-#include <variant>
 
 #include "vda5050++/model/Action.h"
 
 static const std::string k_description = "Check if the Action was declared in the AGV description";
 
-const auto k_ser_float64_min = vda5050pp::interface_agv::agv_description::SerializedValue(
-    std::numeric_limits<double>::lowest());
-
-const auto k_ser_float64_max =
-    vda5050pp::interface_agv::agv_description::SerializedValue(std::numeric_limits<double>::max());
-
-///
-/// \brief The set of all control actions
-///
-const std::set<vda5050pp::interface_agv::agv_description::ActionDeclaration>
-    k_control_action_declarations = {
-        {"startPause", {}, {}, {vda5050pp::BlockingType::HARD}, true, false, false},
-        {"stopPause", {}, {}, {vda5050pp::BlockingType::HARD}, true, false, false},
-        {"stateRequest", {}, {}, {vda5050pp::BlockingType::NONE}, true, false, false},
-        {"logReport",
-         {{"reason", std::nullopt, std::nullopt, std::nullopt}},
-         {},
-         {vda5050pp::BlockingType::NONE},
-         true,
-         false,
-         false},
-        {"cancelOrder", {}, {}, {vda5050pp::BlockingType::HARD}, true, false, false},
-        {"initPosition",
-         {{"x", k_ser_float64_min, k_ser_float64_max, std::nullopt},
-          {"y", k_ser_float64_min, k_ser_float64_max, std::nullopt},
-          {"theta", k_ser_float64_min, k_ser_float64_max, std::nullopt},
-          {"mapId", std::nullopt, std::nullopt, std::nullopt},
-          {"lastNodeId", std::nullopt, std::nullopt, std::nullopt}},
-         {},
-         {vda5050pp::BlockingType::HARD},
-         true,
-         false,
-         false},
-};
-
 vda5050pp::core::validation::ActionDeclaredValidator::ActionDeclaredValidator(
     vda5050pp::interface_agv::Handle &handle, bool ctxt_edge, bool ctxt_instant, bool ctxt_node)
+    : ActionDeclaredValidator(
+          std::make_shared<const ActionValidationPlan>(
+              vda5050pp::core::interface_agv::HandleAccessor(handle).getAGVDescription()),
+          ctxt_edge, ctxt_instant, ctxt_node) {}
+
+vda5050pp::core::validation::ActionDeclaredValidator::ActionDeclaredValidator(
+    std::shared_ptr<const ActionValidationPlan> plan, bool ctxt_edge, bool ctxt_instant,
+    bool ctxt_node)
     : Validator(k_description),
-      handle_accessor_(handle),
+      plan_(std::move(plan)),
       ctxt_edge_(ctxt_edge),
       ctxt_instant_(ctxt_instant),
       ctxt_node_(ctxt_node) {}
 
 static std::list<vda5050pp::Error> paramErrors(
     const vda5050pp::Action &action,
-    const vda5050pp::interface_agv::agv_description::ParameterRange &decl,
+    const vda5050pp::core::validation::ParameterPlan &decl,
     const vda5050pp::ActionParameter &param) {
   if (decl.value_set.has_value()) {
     // Check value set constraints
-    auto it = decl.value_set->find(param.value);
-    if (it == decl.value_set->cend()) {
+    if (decl.value_set->count(param.value) == 0) {
       return {{"ActionParameter Value",
                {{
                    {"actionId", action.actionId},
@@ -83,10 +52,7 @@ static std::list<vda5050pp::Error> paramErrors(
     // Check ordinal constraints
     try {
       if (decl.ordinal_max.has_value()) {
-        auto sparam = decl.ordinal_max.value();
-        sparam.value = param.value;
-
-        if (sparam > decl.ordinal_max.value()) {
+        if (decl.ordinal_max->exceededBy(param.value)) {
           return {{"ActionParameterValue out of bounds",
                    {{
                        {"actionId", action.actionId},
@@ -99,10 +65,7 @@ static std::list<vda5050pp::Error> paramErrors(
         }
       }
       if (decl.ordinal_min.has_value()) {
-        auto sparam = decl.ordinal_min.value();
-        sparam.value = param.value;
-
-        if (sparam < decl.ordinal_min.value()) {
+        if (decl.ordinal_min->undercutBy(param.value)) {
           return {{"ActionParameterValue out of bounds",
                    {{
                        {"actionId", action.actionId},
@@ -131,26 +94,18 @@ static std::list<vda5050pp::Error> paramErrors(
 
 std::list<vda5050pp::Error> vda5050pp::core::validation::ActionDeclaredValidator::operator()(
     const vda5050pp::Action &action) const {
-  const auto &supported_actions = this->handle_accessor_.getAGVDescription().supported_actions;
-
   // Only validate if supported_actions are given
-  if (supported_actions.has_value()) {
+  if (this->plan_->isEnabled()) {
     // Does the type exist?
-    auto match_type = [&](auto &decl) -> bool { return decl.action_type == action.actionType; };
-    auto it = std::find_if(cbegin(*supported_actions), cend(*supported_actions), match_type);
-
-    if (it == cend(*supported_actions)) {
-      it = std::find_if(cbegin(k_control_action_declarations), cend(k_control_action_declarations),
-                        match_type);
-      if (it == cend(k_control_action_declarations)) {
-        return {{"Unknown Action",
-                 {{
-                     {"actionId", action.actionId},
-                     {"actionType", action.actionType},
-                 }},
-                 {"Action Type not supported"},
-                 ErrorLevel::WARNING}};
-      }
+    const auto *it = this->plan_->find(action.actionType);
+    if (it == nullptr) {
+      return {{"Unknown Action",
+               {{
+                   {"actionId", action.actionId},
+                   {"actionType", action.actionType},
+               }},
+               {"Action Type not supported"},
+               ErrorLevel::WARNING}};
     }
 
     // Does the context match ?
@@ -183,8 +138,7 @@ std::list<vda5050pp::Error> vda5050pp::core::validation::ActionDeclaredValidator
     }
 
     // Blocking type?
-    auto match_blocking = [&](auto &b_type) { return b_type == action.blockingType; };
-    if (!std::any_of(cbegin(it->blocking_types), cend(it->blocking_types), match_blocking)) {
+    if (!it->allows(action.blockingType)) {
       return {{"Action BlockingType",
                {{
                    {"actionId", action.actionId},
@@ -197,39 +151,37 @@ std::list<vda5050pp::Error> vda5050pp::core::validation::ActionDeclaredValidator
     std::list<vda5050pp::Error> errors;
 
     // Parameters?
-    auto param_decls_left = it->parameter;
-    for (const auto &param :
-         action.actionParameters.value_or(std::vector<vda5050pp::ActionParameter>())) {
-      auto decl = it->parameter.find({param.key, std::nullopt, std::nullopt, std::nullopt});
-      auto decl_opt =
-          it->optional_parameter.find({param.key, std::nullopt, std::nullopt, std::nullopt});
-
-      if (decl != it->parameter.cend()) {
-        param_decls_left.extract(*decl);
-
-        errors.splice(errors.begin(), paramErrors(action, *decl, param));
-
-      } else if (decl_opt != it->optional_parameter.cend()) {
-        errors.splice(errors.begin(), paramErrors(action, *decl_opt, param));
-      } else {
-        errors.push_back({"ActionParameter",
-                          {{
-                              {"actionId", action.actionId},
-                              {"actionType", action.actionType},
-                              {"actionParameter.key", param.key},
-                          }},
-                          {"Action Parameter not supported"},
-                          ErrorLevel::WARNING});
+    if (action.actionParameters.has_value()) {
+      for (const auto &param : *action.actionParameters) {
+        auto decl = it->parameters.find(param.key);
+
+        if (decl != it->parameters.cend()) {
+          errors.splice(errors.begin(), paramErrors(action, decl->second, param));
+        } else {
+          errors.push_back({"ActionParameter",
+                            {{
+                                {"actionId", action.actionId},
+                                {"actionType", action.actionType},
+                                {"actionParameter.key", param.key},
+                            }},
+                            {"Action Parameter not supported"},
+                            ErrorLevel::WARNING});
+        }
       }
     }
 
-    if (!param_decls_left.empty()) {
-      std::string val;
-
-      for (auto &param : param_decls_left) {
-        val += param.key + " ";
+    // Mandatory parameters left?
+    std::string val;
+    for (const auto &key : it->mandatory_keys) {
+      auto match_key = [&key](auto &param) { return param.key == key; };
+      if (!action.actionParameters.has_value() ||
+          std::none_of(cbegin(*action.actionParameters), cend(*action.actionParameters),
+                       match_key)) {
+        val += key + " ";
       }
+    }
 
+    if (!val.empty()) {
       errors.push_back({"ActionParameter missing",
                         {{
                             {"actionId", action.actionId},
@@ -0,0 +1,174 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+
+#include "vda5050++/core/validation/action_validation_plan.h"
+
+#include <limits>
+#include <set>
+
+using namespace vda5050pp::core::validation;
+using vda5050pp::interface_agv::agv_description::ActionDeclaration;
+using vda5050pp::interface_agv::agv_description::BadSerializedValueCast;
+using vda5050pp::interface_agv::agv_description::ParameterRange;
+using vda5050pp::interface_agv::agv_description::SerializedValue;
+using vda5050pp::interface_agv::agv_description::Type;
+
+static const auto k_ser_float64_min = SerializedValue(std::numeric_limits<double>::lowest());
+
+static const auto k_ser_float64_max = SerializedValue(std::numeric_limits<double>::max());
+
+///
+/// \brief The set of all control actions
+///
+static const std::set<ActionDeclaration> k_control_action_declarations = {
+    {"startPause", {}, {}, {vda5050pp::BlockingType::HARD}, true, false, false},
+    {"stopPause", {}, {}, {vda5050pp::BlockingType::HARD}, true, false, false},
+    {"stateRequest", {}, {}, {vda5050pp::BlockingType::NONE}, true, false, false},
+    {"logReport",
+     {{"reason", std::nullopt, std::nullopt, std::nullopt}},
+     {},
+     {vda5050pp::BlockingType::NONE},
+     true,
+     false,
+     false},
+    {"cancelOrder", {}, {}, {vda5050pp::BlockingType::HARD}, true, false, false},
+    {"initPosition",
+     {{"x", k_ser_float64_min, k_ser_float64_max, std::nullopt},
+      {"y", k_ser_float64_min, k_ser_float64_max, std::nullopt},
+      {"theta", k_ser_float64_min, k_ser_float64_max, std::nullopt},
+      {"mapId", std::nullopt, std::nullopt, std::nullopt},
+      {"lastNodeId", std::nullopt, std::nullopt, std::nullopt}},
+     {},
+     {vda5050pp::BlockingType::HARD},
+     true,
+     false,
+     false},
+};
+
+OrdinalBound::OrdinalBound(const SerializedValue &bound) noexcept(false) : bound_(bound) {
+  // Parse like the SerializedValue casts do, a failure is reported by each comparison
+  try {
+    if (bound.type == Type::INTEGER) {
+      this->integer_ = std::stoi(bound.value);
+      this->parsed_ = true;
+    } else if (bound.type == Type::FLOAT) {
+      this->float_ = std::stod(bound.value);
+      this->parsed_ = true;
+    }
+  } catch (const std::exception &) {
+    this->parsed_ = false;
+  }
+}
+
+bool OrdinalBound::undercutBy(const std::string &value) const noexcept(false) {
+  switch (this->bound_.type) {
+    case Type::INTEGER:
+      if (!this->parsed_) throw BadSerializedValueCast();
+      return std::stoi(value) < this->integer_;
+    case Type::FLOAT:
+      if (!this->parsed_) throw BadSerializedValueCast();
+      return std::stod(value) < this->float_;
+    case Type::BOOLEAN: {
+      // Booleans are rare, they are compared like SerializedValues
+      auto serialized = this->bound_;
+      serialized.value = value;
+      return serialized < this->bound_;
+    }
+    default:
+      return value < this->bound_.value;
+  }
+}
+
+bool OrdinalBound::exceededBy(const std::string &value) const noexcept(false) {
+  switch (this->bound_.type) {
+    case Type::INTEGER:
+      if (!this->parsed_) throw BadSerializedValueCast();
+      return this->integer_ < std::stoi(value);
+    case Type::FLOAT:
+      if (!this->parsed_) throw BadSerializedValueCast();
+      return this->float_ < std::stod(value);
+    case Type::BOOLEAN: {
+      // Booleans are rare, they are compared like SerializedValues
+      auto serialized = this->bound_;
+      serialized.value = value;
+      return serialized > this->bound_;
+    }
+    default:
+      return this->bound_.value < value;
+  }
+}
+
+static uint8_t blockingTypeBit(vda5050pp::BlockingType blocking_type) noexcept(true) {
+  return static_cast<uint8_t>(1u << static_cast<unsigned>(blocking_type));
+}
+
+bool ActionPlan::allows(vda5050pp::BlockingType blocking_type) const noexcept(true) {
+  return (this->blocking_types & blockingTypeBit(blocking_type)) != 0;
+}
+
+static ParameterPlan compileParameter(const ParameterRange &range, bool mandatory) {
+  ParameterPlan plan{mandatory, std::nullopt, std::nullopt, std::nullopt};
+  if (range.value_set.has_value()) {
+    plan.value_set.emplace(cbegin(*range.value_set), cend(*range.value_set));
+  }
+  if (range.ordinal_min.has_value()) {
+    plan.ordinal_min.emplace(*range.ordinal_min);
+  }
+  if (range.ordinal_max.has_value()) {
+    plan.ordinal_max.emplace(*range.ordinal_max);
+  }
+  return plan;
+}
+
+static ActionPlan compileAction(const ActionDeclaration &decl) {
+  ActionPlan plan{decl.instant, decl.node, decl.edge, 0, {}, {}};
+  for (auto blocking_type : decl.blocking_types) {
+    plan.blocking_types |= blockingTypeBit(blocking_type);
+  }
+
+  plan.parameters.reserve(decl.parameter.size() + decl.optional_parameter.size());
+  plan.mandatory_keys.reserve(decl.parameter.size());
+  for (const auto &range : decl.parameter) {
+    plan.parameters.emplace(range.key, compileParameter(range, true));
+    plan.mandatory_keys.push_back(range.key);
+  }
+  // A mandatory declaration takes precedence over an optional one with the same key
+  for (const auto &range : decl.optional_parameter) {
+    if (plan.parameters.count(range.key) == 0) {
+      plan.parameters.emplace(range.key, compileParameter(range, false));
+    }
+  }
+  return plan;
+}
+
+ActionValidationPlan::ActionValidationPlan(
+    const vda5050pp::interface_agv::agv_description::AGVDescription &description) noexcept(false)
+    : enabled_(description.supported_actions.has_value()) {
+  if (!this->enabled_) {
+    return;
+  }
+
+  // The declared actions take precedence over the control actions
+  this->actions_.reserve(description.supported_actions->size() +
+                         k_control_action_declarations.size());
+  for (const auto &decl : *description.supported_actions) {
+    this->actions_.emplace(decl.action_type, compileAction(decl));
+  }
+  for (const auto &decl : k_control_action_declarations) {
+    if (this->actions_.count(decl.action_type) == 0) {
+      this->actions_.emplace(decl.action_type, compileAction(decl));
+    }
+  }
+}
+
+bool ActionValidationPlan::isEnabled() const noexcept(true) { return this->enabled_; }
+
+const ActionPlan *ActionValidationPlan::find(const std::string &action_type) const
+    noexcept(true) {
+  auto it = this->actions_.find(action_type);
+  return it == end(this->actions_) ? nullptr : &it->second;
+}
@@ -24,12 +24,15 @@ using namespace vda5050pp::core::validation;
 ValidationProvider::ValidationProvider(vda5050pp::interface_agv::Handle &handle) : handle_(handle) {
   this->header_validators_.push_back(std::make_unique<HeaderTargetValidator>(handle));
   this->header_validators_.push_back(std::make_unique<HeaderVersionValidator>());
+  // The AGVDescription is compiled once for all action contexts
+  auto action_plan = std::make_shared<const ActionValidationPlan>(
+      vda5050pp::core::interface_agv::HandleAccessor(handle).getAGVDescription());
   this->action_edge_validator_ =
-      std::make_unique<ActionDeclaredValidator>(handle, true, false, false);
+      std::make_unique<ActionDeclaredValidator>(action_plan, true, false, false);
   this->action_instant_validator_ =
-      std::make_unique<ActionDeclaredValidator>(handle, false, true, false);
+      std::make_unique<ActionDeclaredValidator>(action_plan, false, true, false);
   this->action_node_validator_ =
-      std::make_unique<ActionDeclaredValidator>(handle, false, false, true);
+      std::make_unique<ActionDeclaredValidator>(action_plan, false, false, true);
   this->order_validators_.push_back(std::make_unique<OrderIdValidator>(handle));
   this->order_validators_.push_back(std::make_unique<OrderAppendValidator>(handle));
   this->order_validators_.push_back(std::make_unique<OrderGraphConsistencyValidator>(handle));
@@ -20,7 +20,13 @@ void ActionHandler::setHandleReference(vda5050pp::interface_agv::Handle &handle)
 }
 void ActionHandler::setManagerReference(vda5050pp::core::logic::ActionManager &manager) noexcept(
     true) {
-  this->action_manager_ = &manager;
+  std::unique_lock lock(this->action_manager_->mutex);
+  this->action_manager_->manager = &manager;
+}
+
+void ActionHandler::unsetManagerReference() noexcept(true) {
+  std::unique_lock lock(this->action_manager_->mutex);
+  this->action_manager_->manager = nullptr;
 }
 
 void ActionHandler::addError(const std::string &description, vda5050pp::ErrorLevel level) {
@@ -68,27 +74,37 @@ void ActionHandler::addInfo(const std::string &description, vda5050pp::InfoLevel
 }
 
 void ActionHandler::failed() {
-  if (this->action_manager_ != nullptr && !this->action_manager_->failed()) {
+  std::unique_lock lock(this->action_manager_->mutex);
+  auto manager = this->action_manager_->manager;
+  if (manager != nullptr && !manager->failed()) {
     throw std::logic_error("The Action is not in a failable state");
   }
 }
 void ActionHandler::finished() {
-  if (this->action_manager_ != nullptr && !this->action_manager_->finished()) {
+  std::unique_lock lock(this->action_manager_->mutex);
+  auto manager = this->action_manager_->manager;
+  if (manager != nullptr && !manager->finished()) {
     throw std::logic_error("The Action is not in a finishable state");
   }
 }
 void ActionHandler::started() {
-  if (this->action_manager_ != nullptr && !this->action_manager_->started()) {
+  std::unique_lock lock(this->action_manager_->mutex);
+  auto manager = this->action_manager_->manager;
+  if (manager != nullptr && !manager->started()) {
     throw std::logic_error("The Action is not in a startable state");
   }
 }
 void ActionHandler::paused() {
-  if (this->action_manager_ != nullptr && !this->action_manager_->paused()) {
+  std::unique_lock lock(this->action_manager_->mutex);
+  auto manager = this->action_manager_->manager;
+  if (manager != nullptr && !manager->paused()) {
     throw std::logic_error("The Action is not in a pausable state");
   }
 }
 void ActionHandler::resumed() {
-  if (this->action_manager_ != nullptr && !this->action_manager_->resumed()) {
+  std::unique_lock lock(this->action_manager_->mutex);
+  auto manager = this->action_manager_->manager;
+  if (manager != nullptr && !manager->resumed()) {
     throw std::logic_error("The Action is not in a resumable state");
   }
 }
@@ -8,6 +8,7 @@
 #include "vda5050++/interface_agv/continuous_navigation_handler.h"
 
 #include <algorithm>
+#include <stdexcept>
 
 #include "vda5050++/core/interface_agv/const_handle_accessor.h"
 #include "vda5050++/core/interface_agv/handle_accessor.h"
@@ -20,7 +21,13 @@ void vda5050pp::interface_agv::ContinuousNavigationHandler::setHandle(
 
 void vda5050pp::interface_agv::ContinuousNavigationHandler::setManager(
     vda5050pp::core::logic::ContinuousNavigationManager &mgr) noexcept(true) {
-  this->manager_ = &mgr;
+  std::unique_lock lock(this->manager_->mutex);
+  this->manager_->manager = &mgr;
+}
+
+void vda5050pp::interface_agv::ContinuousNavigationHandler::unsetManager() noexcept(true) {
+  std::unique_lock lock(this->manager_->mutex);
+  this->manager_->manager = nullptr;
 }
 
 void vda5050pp::interface_agv::ContinuousNavigationHandler::setInitialBase(
@@ -285,19 +292,35 @@ void vda5050pp::interface_agv::ContinuousNavigationHandler::addInfo(
 }
 
 void vda5050pp::interface_agv::ContinuousNavigationHandler::failed() {
-  this->manager_->handlerFailed();
+  std::unique_lock lock(this->manager_->mutex);
+  if (this->manager_->manager == nullptr) {
+    throw std::logic_error("ContinuousNavigation is not in a failable state");
+  }
+  this->manager_->manager->handlerFailed();
 }
 
 void vda5050pp::interface_agv::ContinuousNavigationHandler::started() {
-  this->manager_->handlerStarted();
+  std::unique_lock lock(this->manager_->mutex);
+  if (this->manager_->manager == nullptr) {
+    throw std::logic_error("ContinuousNavigation is not in a startable state");
+  }
+  this->manager_->manager->handlerStarted();
 }
 
 void vda5050pp::interface_agv::ContinuousNavigationHandler::paused() {
-  this->manager_->handlerPaused();
+  std::unique_lock lock(this->manager_->mutex);
+  if (this->manager_->manager == nullptr) {
+    throw std::logic_error("ContinuousNavigation is not in a pausable state");
+  }
+  this->manager_->manager->handlerPaused();
 }
 
 void vda5050pp::interface_agv::ContinuousNavigationHandler::resumed() {
-  this->manager_->handlerResumed();
+  std::unique_lock lock(this->manager_->mutex);
+  if (this->manager_->manager == nullptr) {
+    throw std::logic_error("ContinuousNavigation is not in a resumable state");
+  }
+  this->manager_->manager->handlerResumed();
 }
 
 void vda5050pp::interface_agv::ContinuousNavigationHandler::setNodeReached(
@@ -309,7 +332,13 @@ void vda5050pp::interface_agv::ContinuousNavigationHandler::setNodeReached(
     uint32_t node_seq) noexcept(false) {
   vda5050pp::core::interface_agv::HandleAccessor ha(*this->handle_);
 
-  this->manager_->handlerReachedNode(node_seq);
+  {
+    std::unique_lock lock(this->manager_->mutex);
+    if (this->manager_->manager == nullptr) {
+      throw std::logic_error("ContinuousNavigation cannot reach the given node");
+    }
+    this->manager_->manager->handlerReachedNode(node_seq);
+  }
 
   auto seq_leq = [node_seq](const auto &elem) { return elem.sequenceId <= node_seq; };
 
@@ -15,24 +15,146 @@ Handle::~Handle() {
   if (!this->shutdown_) {
     this->shutdown();
   }
+
+  // join the spinners, before the members they use are destroyed
+  this->spinners_.clear();
+
+  // stop timers referring to this Handle
+  if (this->executor_ != nullptr) {
+    this->executor_->detach(this);
+  }
+  if (this->odometry_handler_ != nullptr) {
+    this->odometry_handler_->disableAutomaticVisualizationMessages();
+  }
 }
 
 void Handle::setStateUpdatePeriod(const std::chrono::system_clock::duration &period) {
   this->state_update_period_ = period;
 }
 
-void Handle::setLogger(std::shared_ptr<vda5050pp::interface_agv::Logger> logger) const {
-  Logger::setCurrentLogger(logger);
+void Handle::setInterpretationWindow(std::size_t steps) noexcept(true) {
+  this->interpretation_window_ = steps;
 }
 
-void Handle::spin() noexcept(true) {
-  using namespace std::chrono_literals;
+void Handle::setLogger(std::shared_ptr<vda5050pp::interface_agv::Logger> logger) {
+  this->logger_ = logger != nullptr ? logger : Logger::getNullLogger();
+  this->connector_->setLogger(this->logger_);
+}
+
+// If the connector has to be polled, the queue is only waited on for this period
+static constexpr auto k_poll_period = std::chrono::milliseconds(10);
+
+bool Handle::pollConnector() noexcept(true) {
+  if (this->connector_passive_ == nullptr || this->connector_notifies_) {
+    return false;
+  }
+  this->connector_passive_->spinOnce();
+  return true;
+}
+
+std::optional<vda5050pp::core::common::Task> Handle::waitForTask(
+    const std::function<bool()> &cancelled) noexcept(true) {
+  if (this->pollConnector()) {
+    return this->task_queue_.try_pop_for(k_poll_period);
+  }
+  // Pushed tasks (including connector wakeups) and setShutdown() wake up the queue
+  return this->task_queue_.pop(cancelled);
+}
+
+void Handle::setShutdown() noexcept(true) {
+  this->shutdown_ = true;
+  this->task_queue_.wakeAll();
+  if (this->wakeup_fd_enabled_) {
+    this->wakeup_fd_.notify();
+  }
+}
+
+void Handle::connectorWakeup() noexcept(true) {
+  if (!this->connector_spin_pending_.exchange(true)) {
+    // incoming messages may request a stop
+    this->task_queue_.push(vda5050pp::core::common::TaskLane::k_stop,
+                           vda5050pp::core::common::inlineTask([this] {
+                             this->connector_spin_pending_ = false;
+                             this->connector_passive_->spinOnce();
+                           }));
+  }
+}
+
+int Handle::getWakeupFd() noexcept(true) {
+  if (!this->wakeup_fd_enabled_.exchange(true) && !this->task_queue_.empty()) {
+    this->wakeup_fd_.notify();
+  }
+  return this->wakeup_fd_.fd();
+}
+
+vda5050pp::core::common::WorkStealingExecutor::Statistics Handle::getTaskStatistics() const
+    noexcept(true) {
+  return this->task_queue_.getStatistics();
+}
+
+void Handle::setThreadingConfig(const vda5050pp::core::common::ThreadingConfig &config) noexcept(
+    false) {
+  using vda5050pp::core::common::ThreadingConfig;
+  this->thread_registry_.setPlacement(ThreadingConfig::k_spinner_role, config.spinner);
+  this->thread_registry_.setPlacement(ThreadingConfig::k_state_update_role, config.state_update);
+  this->thread_registry_.setPlacement(ThreadingConfig::k_visualization_role, config.visualization);
+}
+
+std::vector<vda5050pp::core::common::ThreadInfo> Handle::getThreadReport() const noexcept(false) {
+  return this->thread_registry_.report();
+}
+
+void Handle::enableNetTrace(std::size_t capacity) noexcept(false) {
+  this->logic_.getNetTrace().enable(capacity);
+}
+
+void Handle::disableNetTrace() noexcept(true) { this->logic_.getNetTrace().disable(); }
+
+void Handle::writeNetTrace(std::ostream &os) const noexcept(false) {
+  this->logic_.getNetTrace().writeChromeTrace(os);
+}
+
+std::chrono::system_clock::time_point Handle::now() const noexcept(true) {
+  if (this->executor_ != nullptr) {
+    return this->executor_->now();
+  }
+  return std::chrono::system_clock::now();
+}
+
+void Handle::attachExecutor() noexcept(false) {
+  this->executor_->attach(this, [this] { return this->spinExecutor(); });
+  if (this->connector_passive_ != nullptr && !this->connector_notifies_) {
+    this->scheduleExecutorPoll();
+  }
+}
+
+void Handle::scheduleExecutorPoll() noexcept(false) {
+  // Poll with the same period as spinning threads (the timer is cancelled on detach)
+  this->executor_->scheduleAfter(this, k_poll_period, [this] {
+    this->executor_->notify(this);
+    this->scheduleExecutorPoll();
+  });
+}
+
+bool Handle::spinExecutor() noexcept(true) {
+  bool had_task = false;
+
+  this->pollConnector();
   while (!this->shutdown_) {
-    if (this->connector_passive_ != nullptr) {
-      this->connector_passive_->spinOnce();
+    auto maybe_fn = this->task_queue_.try_pop();
+    if (!maybe_fn.has_value()) {
+      break;
     }
+    maybe_fn->operator()();
+    had_task = true;
+  }
+
+  return had_task;
+}
 
-    auto maybe_fn = this->task_queue_.try_pop_for(10ms);
+void Handle::spin() noexcept(true) {
+  while (!this->shutdown_) {
+    auto maybe_fn = this->waitForTask([this] { return this->shutdown_.load(); });
     if (maybe_fn.has_value()) {
       maybe_fn->operator()();
     }
@@ -58,15 +180,19 @@ void Handle::spinParallel(uint16_t num_threads) noexcept(true) {
 
 Handle::SpinStatus Handle::spinOnce() noexcept(true) {
   if (!this->shutdown_) {
-    if (this->connector_passive_ != nullptr) {
-      this->connector_passive_->spinOnce();
-    }
+    this->wakeup_fd_.drain();
+    this->pollConnector();
 
     auto maybe_fn = this->task_queue_.try_pop();
     if (maybe_fn.has_value()) {
       maybe_fn->operator()();
     }
 
+    // keep the wakeup fd readable, while there are tasks left
+    if (this->wakeup_fd_enabled_ && !this->task_queue_.empty()) {
+      this->wakeup_fd_.notify();
+    }
+
     return Handle::SpinStatus::k_ok;
   } else {
     return Handle::SpinStatus::k_shutdown;
@@ -76,10 +202,10 @@ Handle::SpinStatus Handle::spinOnce() noexcept(true) {
 Handle::SpinStatus Handle::spinAll() noexcept(true) {
   bool had_task = true;
 
+  this->wakeup_fd_.drain();
+
   while (!this->shutdown_ && had_task) {
-    if (this->connector_passive_ != nullptr) {
-      this->connector_passive_->spinOnce();
-    }
+    this->pollConnector();
 
     auto maybe_fn = this->task_queue_.try_pop();
     if (maybe_fn.has_value()) {
@@ -94,11 +220,8 @@ Handle::SpinStatus Handle::spinAll() noexcept(true) {
 }
 
 void Handle::shutdown() noexcept(true) {
-  auto logger = Logger::getCurrentLogger();
-  if (logger != nullptr) {
-    logger->logInfo("Shutting down the library. Order will be aborted and the MC will be informed"
-                    " about the disconnect\n");
-  }
+  this->logger_->logInfo("Shutting down the library. Order will be aborted and the MC will be "
+                         "informed about the disconnect\n");
 
   vda5050pp::Info sd_info;
   sd_info.infoDescription = "libVDA5050++ was requested to shut down.";
@@ -108,9 +231,9 @@ void Handle::shutdown() noexcept(true) {
   this->messages_.requestStateUpdate(vda5050pp::core::messages::UpdateUrgency::k_immediate);
 
   if (this->state_manager_.isIdle()) {
-    this->shutdown_ = true;
+    this->setShutdown();
   } else {
-    this->logic_.abortOrder([this] { this->shutdown_ = true; });
+    this->logic_.abortOrder([this] { this->setShutdown(); });
   }
 }
 
@@ -125,17 +248,18 @@ void Handle::setOdometryHandler(
 // Spinner /////////////////////////////////////////////////////////////////////
 
 void Handle::Spinner::spin() {
-  using namespace std::chrono_literals;
+  this->handle_.thread_registry_.enter(vda5050pp::core::common::ThreadingConfig::k_spinner_role,
+                                       true);
+  this->handle_.task_queue_.attachWorker();
   while (!this->stop_ && !this->handle_.shutdown_) {
-    if (this->handle_.connector_passive_ != nullptr) {
-      this->handle_.connector_passive_->spinOnce();
-    }
-
-    auto maybe_fn = this->handle_.task_queue_.try_pop_for(10ms);
+    auto maybe_fn = this->handle_.waitForTask(
+        [this] { return this->stop_ || this->handle_.shutdown_; });
     if (maybe_fn.has_value()) {
       maybe_fn->operator()();
     }
   }
+  this->handle_.task_queue_.detachWorker();
+  this->handle_.thread_registry_.leave();
 }
 
 Handle::Spinner::Spinner(Handle &handle)
@@ -143,5 +267,6 @@ Handle::Spinner::Spinner(Handle &handle)
 
 Handle::Spinner::~Spinner() {
   this->stop_ = true;
+  this->handle_.task_queue_.wakeAll();
   this->thread_.join();
 }
\ No newline at end of file
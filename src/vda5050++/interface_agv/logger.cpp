@@ -11,7 +11,7 @@ using namespace vda5050pp::interface_agv;
 
 std::shared_ptr<Logger> Logger::current_logger_;
 
-std::shared_ptr<Logger> Logger::getCurrentLogger() {
+std::shared_ptr<Logger> Logger::getNullLogger() {
   // fallback null logger
   class NullLogger : public vda5050pp::interface_agv::Logger {
   public:
@@ -27,11 +27,21 @@ std::shared_ptr<Logger> Logger::getCurrentLogger() {
     }
   };
 
-  if (current_logger_ == nullptr) {
-    current_logger_ = std::make_shared<NullLogger>();
+  static const auto null_logger = std::make_shared<NullLogger>();
+
+  return null_logger;
+}
+
+std::shared_ptr<Logger> Logger::getCurrentLogger() {
+  auto logger = std::atomic_load(&current_logger_);
+
+  if (logger == nullptr) {
+    return getNullLogger();
   }
 
-  return current_logger_;
+  return logger;
 }
 
-void Logger::setCurrentLogger(std::shared_ptr<Logger> instance) { current_logger_ = instance; }
\ No newline at end of file
+void Logger::setCurrentLogger(std::shared_ptr<Logger> instance) {
+  std::atomic_store(&current_logger_, std::move(instance));
+}
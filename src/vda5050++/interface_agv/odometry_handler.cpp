@@ -44,7 +44,18 @@ void OdometryHandler::enableAutomaticVisualizationMessages(
 
   this->disableAutomaticVisualizationMessages();
 
+  vda5050pp::core::interface_agv::HandleAccessor ha(*this->handle_ptr_);
+  if (auto executor = ha.getSharedExecutor(); executor != nullptr) {
+    std::scoped_lock lock(this->visualization_mutex_);
+    this->visualization_executor_ = executor;
+    this->scheduleVisualization(executor->now() + period, period, this->visualization_generation_);
+    return;
+  }
+
   auto vis_task = [this, period] {
+    auto &thread_registry =
+        vda5050pp::core::interface_agv::HandleAccessor(*this->handle_ptr_).getThreadRegistry();
+    thread_registry.enter(vda5050pp::core::common::ThreadingConfig::k_visualization_role);
     auto running = true;
     auto wakeup_time = std::chrono::system_clock::now() + period;
     auto wakeup_time_2 = wakeup_time + period;
@@ -65,15 +76,42 @@ void OdometryHandler::enableAutomaticVisualizationMessages(
           break;
       }
     }
+    thread_registry.leave();
   };
 
   this->visualization_timer_.enable();
   this->visualization_thread_ = std::make_unique<std::thread>(vis_task);
 }
+
+void OdometryHandler::scheduleVisualization(std::chrono::system_clock::time_point at,
+                                            std::chrono::system_clock::duration period,
+                                            uint64_t generation) noexcept(true) {
+  auto task = [this, at, period, generation] {
+    vda5050pp::interface_agv::status::sendVisualization(*this->handle_ptr_);
+
+    std::scoped_lock lock(this->visualization_mutex_);
+    if (generation == this->visualization_generation_) {
+      this->scheduleVisualization(at + period, period, generation);
+    }
+  };
+  this->visualization_timer_id_ =
+      this->visualization_executor_->schedule(this->handle_ptr_, at, std::move(task));
+}
+
 void OdometryHandler::disableAutomaticVisualizationMessages() noexcept(true) {
+  {
+    std::scoped_lock lock(this->visualization_mutex_);
+    if (this->visualization_timer_id_.has_value()) {
+      this->visualization_executor_->cancel(*this->visualization_timer_id_);
+      this->visualization_timer_id_.reset();
+    }
+    this->visualization_executor_.reset();
+    this->visualization_generation_++;
+  }
   this->visualization_timer_.disable();
   if (this->visualization_thread_ != nullptr) {
     this->visualization_thread_->join();
+    this->visualization_thread_.reset();
   }
 }
 
@@ -23,7 +23,13 @@ void StepBasedNavigationHandler::setData(vda5050pp::Node &&goal_node,
 
 void StepBasedNavigationHandler::setManager(
     vda5050pp::core::logic::DriveToNodeManager &manager) noexcept(true) {
-  this->manager_ = &manager;
+  std::unique_lock lock(this->manager_->mutex);
+  this->manager_->manager = &manager;
+}
+
+void StepBasedNavigationHandler::unsetManager() noexcept(true) {
+  std::unique_lock lock(this->manager_->mutex);
+  this->manager_->manager = nullptr;
 }
 
 void StepBasedNavigationHandler::setHandle(vda5050pp::interface_agv::Handle &handle) noexcept(
@@ -77,28 +83,38 @@ void StepBasedNavigationHandler::addInfo(
 }
 
 void StepBasedNavigationHandler::failed() {
-  if (this->manager_ != nullptr && !this->manager_->failed()) {
+  std::unique_lock lock(this->manager_->mutex);
+  auto manager = this->manager_->manager;
+  if (manager != nullptr && !manager->failed()) {
     throw std::logic_error("The AGV is not in a failable state");
   }
 }
 void StepBasedNavigationHandler::finished() {
-  if (this->manager_ != nullptr && !this->manager_->finished()) {
+  std::unique_lock lock(this->manager_->mutex);
+  auto manager = this->manager_->manager;
+  if (manager != nullptr && !manager->finished()) {
     throw std::logic_error("The AGV is not in a finishable state");
   }
 }
 void StepBasedNavigationHandler::paused() {
-  if (this->manager_ != nullptr && !this->manager_->paused()) {
+  std::unique_lock lock(this->manager_->mutex);
+  auto manager = this->manager_->manager;
+  if (manager != nullptr && !manager->paused()) {
     throw std::logic_error("The AGV is not in a pausable state");
   }
 }
 void StepBasedNavigationHandler::resumed() {
-  if (this->manager_ != nullptr && !this->manager_->resumed()) {
+  std::unique_lock lock(this->manager_->mutex);
+  auto manager = this->manager_->manager;
+  if (manager != nullptr && !manager->resumed()) {
     throw std::logic_error("The AGV is not in a resumable state");
   }
 }
 
 void StepBasedNavigationHandler::started() {
-  if (this->manager_ != nullptr && !this->manager_->started()) {
+  std::unique_lock lock(this->manager_->mutex);
+  auto manager = this->manager_->manager;
+  if (manager != nullptr && !manager->started()) {
     throw std::logic_error("The AGV is not in a startable state");
   }
 }
@@ -61,13 +61,17 @@ test::TestActionHandler::TestActionHandler() noexcept(true)
 
 test::TestActionHandler::~TestActionHandler() {
   try {
-    test::test_action_handler_by_id.extract(this->getAction().actionId);
+    // another handler with the same action id might have replaced this one
+    auto it = test::test_action_handler_by_id.find(this->getAction().actionId);
+    if (it != test::test_action_handler_by_id.end() && &it->second.get() == this) {
+      test::test_action_handler_by_id.erase(it);
+    }
   } catch (const std::exception &) {
   }
 }
 
 void test::TestActionHandler::start(const vda5050pp::Action &action) {
-  test::test_action_handler_by_id.emplace(action.actionId, std::ref(*this));
+  test::test_action_handler_by_id.insert_or_assign(action.actionId, std::ref(*this));
   this->times_start_called_++;
   if (TestActionHandler::auto_start_) {
     this->started();
@@ -15,8 +15,10 @@
 #include <chrono>
 #include <functional>
 #include <list>
+#include <memory>
 #include <optional>
 #include <thread>
+#include <vector>
 
 TEST_CASE("core::common::BlockingQueue synchronized push and pop", "[core::common::BlockingQueue") {
   GIVEN("An empty BlockingQueue") {
@@ -92,4 +94,44 @@ TEST_CASE("core::common::BlockingQueue copy and move", "[core::common::BlockingQ
       THEN("it contains the same elements") { REQUIRE(containsSame(queue_moved, queue_copy)); }
     }
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("core::common::BlockingQueue move-only elements", "[core::common::BlockingQueue]") {
+  using namespace std::chrono_literals;
+
+  GIVEN("A BlockingQueue of move-only elements") {
+    vda5050pp::core::common::BlockingQueue<std::unique_ptr<int>> queue;
+    for (int i = 0; i < 3; i++) {
+      queue.push(std::make_unique<int>(i));
+    }
+
+    WHEN("An element is popped") {
+      auto elem = queue.pop();
+
+      THEN("It was moved out") {
+        REQUIRE(elem != nullptr);
+        REQUIRE(*elem == 0);
+        REQUIRE(queue.size() == 2);
+      }
+    }
+
+    WHEN("All elements are popped") {
+      std::vector<std::unique_ptr<int>> popped;
+      while (auto elem = queue.try_pop()) {
+        popped.push_back(std::move(*elem));
+      }
+
+      THEN("They were popped in order") {
+        REQUIRE(popped.size() == 3);
+        for (int i = 0; i < 3; i++) {
+          REQUIRE(*popped[i] == i);
+        }
+      }
+
+      THEN("Popping from the empty queue times out") {
+        REQUIRE_FALSE(queue.try_pop_for(1ms).has_value());
+        REQUIRE_FALSE(queue.try_pop_until(std::chrono::steady_clock::now() + 1ms).has_value());
+      }
+    }
+  }
+}
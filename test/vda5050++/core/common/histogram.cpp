@@ -0,0 +1,75 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains tests for the Histogram class
+//
+
+#include "vda5050++/core/common/histogram.h"
+
+#include <catch2/catch.hpp>
+#include <chrono>
+
+TEST_CASE("core::common::Histogram records values into buckets", "[core::common::Histogram]") {
+  GIVEN("A histogram with the bounds 1, 2 and 4") {
+    vda5050pp::core::common::Histogram<int> histogram({1, 2, 4});
+
+    THEN("It has four empty buckets") {
+      REQUIRE(histogram.counts().size() == 4);
+      REQUIRE(histogram.count() == 0);
+      REQUIRE_FALSE(histogram.min().has_value());
+      REQUIRE_FALSE(histogram.quantileBound(0.5).has_value());
+    }
+
+    WHEN("Some values are recorded") {
+      for (int value : {0, 1, 2, 3, 4, 5, 100}) {
+        histogram.record(value);
+      }
+
+      THEN("The values are counted in the correct (upper inclusive) buckets") {
+        REQUIRE(histogram.counts() == std::vector<uint64_t>{2, 1, 2, 2});
+        REQUIRE(histogram.count() == 7);
+        REQUIRE(histogram.sum() == 115);
+        REQUIRE(*histogram.min() == 0);
+        REQUIRE(*histogram.max() == 100);
+      }
+
+      THEN("The quantile bounds are correct") {
+        REQUIRE(*histogram.quantileBound(0.2) == 1);
+        REQUIRE(*histogram.quantileBound(0.5) == 4);
+        REQUIRE(*histogram.quantileBound(1.0) == 100);
+      }
+
+      WHEN("The histogram is reset") {
+        histogram.reset();
+
+        THEN("It is empty but keeps its bounds") {
+          REQUIRE(histogram.count() == 0);
+          REQUIRE(histogram.counts() == std::vector<uint64_t>{0, 0, 0, 0});
+          REQUIRE(histogram.bounds() == std::vector<int>{1, 2, 4});
+        }
+      }
+    }
+  }
+
+  GIVEN("A latency histogram with the default bounds") {
+    using namespace std::chrono_literals;
+    vda5050pp::core::common::LatencyHistogram histogram(
+        vda5050pp::core::common::defaultLatencyBounds());
+
+    WHEN("Latencies are recorded") {
+      histogram.record(50us);
+      histogram.record(3ms);
+      histogram.record(1h);
+
+      THEN("They land in the first, an intermediate and the overflow bucket") {
+        REQUIRE(histogram.counts().front() == 1);
+        REQUIRE(histogram.counts().back() == 1);
+        REQUIRE(*histogram.quantileBound(0.6) >= 3ms);
+        REQUIRE(*histogram.quantileBound(0.6) < 7ms);
+      }
+    }
+  }
+}
@@ -0,0 +1,135 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains tests for the SimulationExecutor class
+//
+
+#include "vda5050++/core/common/simulation_executor.h"
+
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("core::common::SimulationExecutor timers", "[core::common::SimulationExecutor]") {
+  GIVEN("A SimulationExecutor starting at the epoch") {
+    vda5050pp::core::common::SimulationExecutor executor;
+    using TimePoint = vda5050pp::core::common::SimulationExecutor::TimePoint;
+    std::vector<std::pair<int, TimePoint>> fired;
+
+    auto record = [&executor, &fired](int n) {
+      return [&executor, &fired, n] { fired.emplace_back(n, executor.now()); };
+    };
+
+    THEN("Time does not pass by itself") {
+      REQUIRE(executor.now() == TimePoint{});
+      REQUIRE_FALSE(executor.nextTimer().has_value());
+    }
+
+    WHEN("Timers are scheduled out of order and the executor advances") {
+      executor.scheduleAfter(nullptr, 2s, record(2));
+      executor.scheduleAfter(nullptr, 1s, record(1));
+      executor.scheduleAfter(nullptr, 1s, record(11));
+      executor.scheduleAfter(nullptr, 10s, record(10));
+      executor.advanceBy(5s);
+
+      THEN("Due timers fired in time order, then in schedule order") {
+        REQUIRE(fired.size() == 3);
+        REQUIRE(fired[0] == std::make_pair(1, TimePoint(1s)));
+        REQUIRE(fired[1] == std::make_pair(11, TimePoint(1s)));
+        REQUIRE(fired[2] == std::make_pair(2, TimePoint(2s)));
+        REQUIRE(executor.now() == TimePoint(5s));
+        REQUIRE(executor.nextTimer() == TimePoint(10s));
+        REQUIRE(executor.getStatistics().timers_fired == 3);
+      }
+    }
+
+    WHEN("A timer is cancelled") {
+      auto id = executor.scheduleAfter(nullptr, 1s, record(1));
+      REQUIRE(executor.cancel(id));
+      executor.advanceBy(2s);
+
+      THEN("It did not fire") {
+        REQUIRE(fired.empty());
+        REQUIRE_FALSE(executor.cancel(id));
+      }
+    }
+
+    WHEN("A timer reschedules itself") {
+      std::function<void()> periodic = [&] {
+        fired.emplace_back(0, executor.now());
+        executor.scheduleAfter(nullptr, 100ms, [&periodic] { periodic(); });
+      };
+      executor.scheduleAfter(nullptr, 100ms, [&periodic] { periodic(); });
+      executor.advanceBy(1s);
+
+      THEN("It fired once per period") {
+        REQUIRE(fired.size() == 10);
+        REQUIRE(fired.back().second == TimePoint(1s));
+      }
+    }
+  }
+}
+
+TEST_CASE("core::common::SimulationExecutor participants", "[core::common::SimulationExecutor]") {
+  GIVEN("A SimulationExecutor with two participants") {
+    vda5050pp::core::common::SimulationExecutor executor;
+    std::vector<int> ran;
+    int work_a = 0;
+    int work_b = 0;
+    // Each participant runs all of its work, work of b creates work for a
+    executor.attach(&work_a, [&] {
+      auto had_work = work_a > 0;
+      for (; work_a > 0; work_a--) {
+        ran.push_back(0);
+      }
+      return had_work;
+    });
+    executor.attach(&work_b, [&] {
+      auto had_work = work_b > 0;
+      for (; work_b > 0; work_b--) {
+        ran.push_back(1);
+        work_a++;
+        executor.notify(&work_a);
+      }
+      return had_work;
+    });
+
+    THEN("Both ran once after attaching") {
+      executor.runReady();
+      REQUIRE(ran.empty());
+      REQUIRE(executor.getStatistics().participant_runs == 2);
+      REQUIRE(executor.getStatistics().idle_runs == 2);
+    }
+
+    WHEN("A timer creates work and notifies") {
+      executor.runReady();
+      executor.scheduleAfter(nullptr, 1s, [&] {
+        work_b = 2;
+        executor.notify(&work_b);
+      });
+      executor.advanceBy(2s);
+
+      THEN("Only the notified participants ran") {
+        REQUIRE(ran == std::vector<int>{1, 1, 0, 0});
+        REQUIRE(executor.getStatistics().participant_runs == 4);
+      }
+    }
+
+    WHEN("A participant is detached") {
+      executor.detach(&work_b);
+      work_b = 1;
+      executor.notify(&work_b);
+      executor.runReady();
+
+      THEN("It does not run anymore") {
+        REQUIRE(ran.empty());
+        REQUIRE(executor.getStatistics().participant_runs == 1);
+      }
+    }
+  }
+}
@@ -0,0 +1,62 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains tests for the Task class
+//
+
+#include "vda5050++/core/common/task.h"
+
+#include <array>
+#include <catch2/catch.hpp>
+#include <memory>
+
+TEST_CASE("core::common::Task storage", "[core::common::Task]") {
+  GIVEN("A small callable") {
+    int calls = 0;
+    auto small = [&calls] { calls++; };
+
+    THEN("It is stored inline") {
+      REQUIRE(vda5050pp::core::common::Task::fitsInline<decltype(small)>());
+      vda5050pp::core::common::Task task(small);
+      auto moved = std::move(task);
+      moved();
+      REQUIRE(calls == 1);
+      REQUIRE_FALSE(task);
+      REQUIRE(moved);
+    }
+  }
+
+  GIVEN("A large callable") {
+    auto counter = std::make_shared<int>(0);
+    std::array<char, 128> payload{};
+    auto large = [counter, payload] { (*counter) += 1 + payload[0]; };
+
+    THEN("It is stored on the heap and destroyed exactly once") {
+      REQUIRE_FALSE(vda5050pp::core::common::Task::fitsInline<decltype(large)>());
+      {
+        vda5050pp::core::common::Task task(std::move(large));
+        vda5050pp::core::common::Task moved;
+        moved = std::move(task);
+        moved();
+        REQUIRE(*counter == 1);
+        REQUIRE(counter.use_count() == 2);
+      }
+      REQUIRE(counter.use_count() == 1);
+    }
+  }
+
+  GIVEN("A move-only callable") {
+    auto value = std::make_unique<int>(42);
+    int result = 0;
+    vda5050pp::core::common::Task task([value = std::move(value), &result] { result = *value; });
+
+    THEN("It can be called after moving the task") {
+      auto moved = std::move(task);
+      moved();
+      REQUIRE(result == 42);
+    }
+  }
+}
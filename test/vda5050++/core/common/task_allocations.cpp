@@ -0,0 +1,105 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains tests for allocations of the task dispatch path. It replaces the global
+// operator new and is therefore built as an own executable (vda5050++_allocation_test)
+//
+
+#include <catch2/catch.hpp>
+#include <cstdlib>
+#include <new>
+
+#include "vda5050++/core/common/task.h"
+#include "vda5050++/core/common/work_stealing_executor.h"
+
+// Allocations of the current thread are only counted inside of an AllocationCounter scope
+static thread_local bool counting = false;
+static thread_local std::size_t allocations = 0;
+
+void *operator new(std::size_t size) {
+  if (counting) {
+    allocations++;
+  }
+  if (void *ptr = std::malloc(size == 0 ? 1 : size); ptr != nullptr) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace {
+
+class AllocationCounter {
+public:
+  AllocationCounter() {
+    allocations = 0;
+    counting = true;
+  }
+  ~AllocationCounter() { counting = false; }
+
+  std::size_t count() const { return allocations; }
+};
+
+}  // namespace
+
+TEST_CASE("core::common::Task inline storage does not allocate", "[core::common::Task]") {
+  GIVEN("A small callable") {
+    int calls = 0;
+    auto small = [&calls] { calls++; };
+
+    THEN("Creating moving and calling the task does not allocate") {
+      std::size_t allocated = 0;
+      {
+        AllocationCounter counter;
+        auto task = vda5050pp::core::common::inlineTask(small);
+        auto moved = std::move(task);
+        moved();
+        allocated = counter.count();
+      }
+      REQUIRE(allocated == 0);
+      REQUIRE(calls == 1);
+    }
+  }
+}
+
+TEST_CASE("core::common::Task dispatch does not allocate", "[core::common::Task]") {
+  GIVEN("A warmed up WorkStealingExecutor") {
+    vda5050pp::core::common::WorkStealingExecutor executor;
+    int calls = 0;
+    int key = 0;
+
+    auto dispatch = [&executor, &calls, &key] {
+      // Like the task managers: capture this and push with an ordering key
+      executor.push(&key, vda5050pp::core::common::inlineTask([&calls] { calls++; }));
+      executor.push(vda5050pp::core::common::inlineTask([&calls] { calls++; }));
+      while (auto task = executor.try_pop()) {
+        (*task)();
+      }
+    };
+    for (int i = 0; i < 16; i++) {
+      dispatch();
+    }
+
+    WHEN("Tasks are pushed and executed") {
+      std::size_t allocated = 0;
+      {
+        AllocationCounter counter;
+        for (int i = 0; i < 1000; i++) {
+          dispatch();
+        }
+        allocated = counter.count();
+      }
+
+      THEN("No allocation happened") {
+        REQUIRE(calls == 2 * 1016);
+        REQUIRE(allocated == 0);
+      }
+    }
+  }
+}
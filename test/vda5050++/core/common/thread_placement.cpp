@@ -0,0 +1,192 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains tests for the ThreadRegistry
+//
+
+#include "vda5050++/core/common/thread_placement.h"
+
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "test/test_action_handler.h"
+#include "test/test_connector.h"
+#include "test/test_continuous_navigation_handler.h"
+#include "test/test_pause_resume_handler.h"
+#include "vda5050++/core/common/thread_pool_executor.h"
+#include "vda5050++/interface_agv/handle.h"
+
+using vda5050pp::core::common::SchedulingPolicy;
+using vda5050pp::core::common::ThreadInfo;
+using vda5050pp::core::common::ThreadPlacement;
+using vda5050pp::core::common::ThreadRegistry;
+
+namespace {
+
+// Runs fn on a registered thread, such that the placement does not leak into the test runner
+std::vector<ThreadInfo> reportFromThread(ThreadRegistry &registry, const std::string &role,
+                                         const std::function<void()> &fn = {}) {
+  std::vector<ThreadInfo> report;
+  std::thread thread([&] {
+    registry.enter(role, true);
+    if (fn) {
+      fn();
+    }
+    report = registry.report();
+    registry.leave();
+  });
+  thread.join();
+  return report;
+}
+
+}  // namespace
+
+TEST_CASE("core::common::ThreadRegistry", "[core::common::ThreadRegistry]") {
+  GIVEN("A ThreadRegistry with a placement") {
+    ThreadRegistry registry;
+    std::vector<std::string> errors;
+    registry.setErrorHandler([&errors](const std::string &error) { errors.push_back(error); });
+    registry.setPlacement(
+        "worker", ThreadPlacement{"a-very-long-thread-name", {0}, SchedulingPolicy::k_inherit, 0});
+
+    WHEN("A thread enters") {
+      auto report = reportFromThread(registry, "worker");
+
+      THEN("It is named, numbered and pinned") {
+        REQUIRE(report.size() == 1);
+        REQUIRE(report[0].role == "worker");
+        REQUIRE(report[0].index == 0);
+        REQUIRE(report[0].error.empty());
+        REQUIRE(errors.empty());
+#ifdef __linux__
+        REQUIRE(report[0].tid > 0);
+        REQUIRE(report[0].name == "a-very-long-t-0");
+        REQUIRE(report[0].cpus == std::vector<uint16_t>{0});
+#endif
+      }
+
+      THEN("It is not reported after leaving") { REQUIRE(registry.report().empty()); }
+    }
+
+    WHEN("A second thread enters the role") {
+      std::vector<ThreadInfo> report;
+      reportFromThread(registry, "worker",
+                       [&] { report = reportFromThread(registry, "worker"); });
+
+      THEN("It gets the next number") {
+        REQUIRE(report.size() == 2);
+        REQUIRE(report[0].index + report[1].index == 1);
+      }
+    }
+
+    WHEN("The placement of a running thread is changed") {
+      auto report = reportFromThread(registry, "worker", [&registry] {
+        registry.setPlacement("worker",
+                              ThreadPlacement{"renamed", {}, SchedulingPolicy::k_other, 5});
+      });
+
+      THEN("It is applied to the running thread") {
+        REQUIRE(report.size() == 1);
+        REQUIRE(report[0].policy == SchedulingPolicy::k_other);
+#ifdef __linux__
+        REQUIRE(report[0].name == "renamed-0");
+        REQUIRE(report[0].priority == 5);
+#endif
+      }
+    }
+
+    WHEN("A thread asks for a real-time priority") {
+      registry.setPlacement("rt", ThreadPlacement{"", {}, SchedulingPolicy::k_fifo, 10});
+      auto report = reportFromThread(registry, "rt");
+
+      THEN("It is either placed or the error is reported") {
+        REQUIRE(report.size() == 1);
+        if (report[0].error.empty()) {
+          REQUIRE(report[0].policy == SchedulingPolicy::k_fifo);
+          REQUIRE(report[0].priority == 10);
+        } else {
+          REQUIRE(report[0].policy == SchedulingPolicy::k_other);
+          REQUIRE(errors.size() == 1);
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("core::common::ThreadPoolExecutor thread report", "[core::common::ThreadRegistry]") {
+  GIVEN("A ThreadPoolExecutor with 2 threads") {
+    vda5050pp::core::common::ThreadPoolExecutor executor(
+        2, ThreadPlacement{"pool", {}, SchedulingPolicy::k_inherit, 0});
+
+    WHEN("Its threads started") {
+      while (executor.getThreadReport().size() < 2) {
+        std::this_thread::yield();
+      }
+
+      THEN("Both threads are reported with their names") {
+        auto report = executor.getThreadReport();
+        REQUIRE(report.size() == 2);
+#ifdef __linux__
+        REQUIRE(report[0].name.rfind("pool-", 0) == 0);
+        REQUIRE(report[1].name.rfind("pool-", 0) == 0);
+        REQUIRE(report[0].name != report[1].name);
+#endif
+      }
+    }
+  }
+}
+
+TEST_CASE("interface_agv::Handle thread report", "[core::common::ThreadRegistry]") {
+  GIVEN("A Handle spinning with 2 threads") {
+    vda5050pp::interface_agv::Handlers<test::TestContinuousNavigationHandler,
+                                       test::TestActionHandler, test::TestPauseResumeHandler>
+        handlers;
+    vda5050pp::interface_agv::Handle handle({}, std::make_shared<test::TestConnector>(),
+                                            handlers);
+    handle.spinParallel(2);
+
+    WHEN("The spinners started") {
+      while (handle.getThreadReport().size() < 3) {
+        std::this_thread::yield();
+      }
+
+      THEN("The state update timer and both spinners are reported") {
+        auto report = handle.getThreadReport();
+        REQUIRE(report.size() == 3);
+        std::vector<std::string> names;
+        for (const auto &info : report) {
+          names.push_back(info.role + ":" + std::to_string(info.index));
+        }
+        std::sort(names.begin(), names.end());
+        REQUIRE(names == std::vector<std::string>{"spinner:0", "spinner:1", "state_update:0"});
+      }
+    }
+
+    WHEN("The spinners are renamed") {
+      vda5050pp::core::common::ThreadingConfig config;
+      config.spinner.name = "nav-spin";
+      handle.setThreadingConfig(config);
+      while (handle.getThreadReport().size() < 3) {
+        std::this_thread::yield();
+      }
+
+      THEN("Their names are numbered") {
+#ifdef __linux__
+        for (const auto &info : handle.getThreadReport()) {
+          if (info.role == vda5050pp::core::common::ThreadingConfig::k_spinner_role) {
+            REQUIRE(info.name == "nav-spin-" + std::to_string(info.index));
+          } else {
+            REQUIRE(info.name == "vda5050-state");
+          }
+        }
+#endif
+      }
+    }
+  }
+}
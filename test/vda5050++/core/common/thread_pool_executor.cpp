@@ -0,0 +1,123 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains tests for the ThreadPoolExecutor class
+//
+
+#include "vda5050++/core/common/thread_pool_executor.h"
+
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("core::common::ThreadPoolExecutor timers", "[core::common::ThreadPoolExecutor]") {
+  GIVEN("A ThreadPoolExecutor with 2 threads") {
+    vda5050pp::core::common::ThreadPoolExecutor executor(2);
+    int key = 0;
+    std::mutex mutex;
+    std::vector<int> fired;
+    auto record = [&mutex, &fired](int n) {
+      return [&mutex, &fired, n] {
+        std::scoped_lock lock(mutex);
+        fired.push_back(n);
+      };
+    };
+
+    WHEN("Timers are scheduled out of order") {
+      auto begin = std::chrono::steady_clock::now();
+      executor.scheduleAfter(&key, 40ms, record(2));
+      executor.scheduleAfter(&key, 20ms, record(1));
+      auto cancelled = executor.scheduleAfter(&key, 30ms, record(3));
+      REQUIRE(executor.cancel(cancelled));
+      while (executor.nextTimer().has_value()) {
+        std::this_thread::sleep_for(1ms);
+      }
+      std::this_thread::sleep_for(10ms);
+
+      THEN("They fired in time order, not before they were due") {
+        REQUIRE(std::chrono::steady_clock::now() - begin >= 40ms);
+        std::scoped_lock lock(mutex);
+        REQUIRE(fired == std::vector<int>{1, 2});
+        REQUIRE(executor.getStatistics().timers_fired == 2);
+      }
+    }
+
+    WHEN("The key is detached") {
+      executor.scheduleAfter(&key, 10ms, record(1));
+      executor.detach(&key);
+      std::this_thread::sleep_for(30ms);
+
+      THEN("Its timers were cancelled") {
+        std::scoped_lock lock(mutex);
+        REQUIRE(fired.empty());
+        REQUIRE_FALSE(executor.nextTimer().has_value());
+      }
+    }
+  }
+}
+
+TEST_CASE("core::common::ThreadPoolExecutor participants", "[core::common::ThreadPoolExecutor]") {
+  GIVEN("A ThreadPoolExecutor with 2 threads and an attached participant") {
+    vda5050pp::core::common::ThreadPoolExecutor executor(2);
+    int key = 0;
+    std::atomic_int work = 0;
+    std::atomic_int done = 0;
+    std::atomic_bool block = false;
+    std::atomic_bool entered = false;
+    std::atomic<std::thread::id> ran_on;
+    executor.attach(&key, [&] {
+      ran_on = std::this_thread::get_id();
+      entered = true;
+      while (block) {
+        std::this_thread::yield();
+      }
+      auto had_work = false;
+      for (; work > 0; work--) {
+        done++;
+        had_work = true;
+      }
+      return had_work;
+    });
+
+    WHEN("The participant is notified") {
+      work = 3;
+      executor.notify(&key);
+      while (done < 3) {
+        std::this_thread::yield();
+      }
+
+      THEN("A thread of the pool ran it") {
+        REQUIRE(done == 3);
+        REQUIRE(ran_on.load() != std::this_thread::get_id());
+        REQUIRE(executor.getStatistics().participant_runs >= 1);
+      }
+    }
+
+    WHEN("The participant is detached while it runs") {
+      block = true;
+      entered = false;
+      executor.notify(&key);
+      while (!entered) {
+        std::this_thread::yield();
+      }
+      std::thread unblock([&block] {
+        std::this_thread::sleep_for(50ms);
+        block = false;
+      });
+      auto begin = std::chrono::steady_clock::now();
+      executor.detach(&key);
+      auto waited = std::chrono::steady_clock::now() - begin;
+      unblock.join();
+
+      THEN("Detaching waited for the run to return") { REQUIRE(waited >= 20ms); }
+    }
+  }
+}
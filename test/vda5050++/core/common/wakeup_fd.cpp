@@ -0,0 +1,53 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains tests for the WakeupFd class
+//
+
+#include "vda5050++/core/common/wakeup_fd.h"
+
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <thread>
+
+TEST_CASE("core::common::WakeupFd notify and drain", "[core::common::WakeupFd]") {
+  using namespace std::chrono_literals;
+
+  GIVEN("A new WakeupFd") {
+    vda5050pp::core::common::WakeupFd wakeup_fd;
+
+    THEN("The fd is valid and not readable") {
+      REQUIRE(wakeup_fd.fd() >= 0);
+      REQUIRE_FALSE(wakeup_fd.wait(0ms));
+      REQUIRE_FALSE(wakeup_fd.drain());
+    }
+
+    WHEN("It is notified multiple times") {
+      wakeup_fd.notify();
+      wakeup_fd.notify();
+
+      THEN("The fd is readable") { REQUIRE(wakeup_fd.wait(0ms)); }
+
+      THEN("A single drain resets it") {
+        REQUIRE(wakeup_fd.drain());
+        REQUIRE_FALSE(wakeup_fd.wait(0ms));
+        REQUIRE_FALSE(wakeup_fd.drain());
+      }
+    }
+
+    WHEN("Another thread notifies it") {
+      std::thread thread([&wakeup_fd] {
+        std::this_thread::sleep_for(5ms);
+        wakeup_fd.notify();
+      });
+
+      THEN("A waiting thread wakes up") {
+        REQUIRE(wakeup_fd.wait(1000ms));
+        thread.join();
+      }
+    }
+  }
+}
@@ -0,0 +1,245 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains tests for the WorkStealingExecutor class
+//
+
+#include "vda5050++/core/common/work_stealing_executor.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+static void runWorkers(vda5050pp::core::common::WorkStealingExecutor &executor, int n_threads,
+                       const std::function<bool()> &done) {
+  std::vector<std::thread> threads;
+  for (int i = 0; i < n_threads; i++) {
+    threads.emplace_back([&executor, &done] {
+      executor.attachWorker();
+      while (!done()) {
+        if (auto task = executor.try_pop_for(1ms); task.has_value()) {
+          (*task)();
+        }
+      }
+      executor.detachWorker();
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+}
+
+TEST_CASE("core::common::WorkStealingExecutor push and pop",
+          "[core::common::WorkStealingExecutor]") {
+  GIVEN("An empty WorkStealingExecutor without workers") {
+    vda5050pp::core::common::WorkStealingExecutor executor;
+
+    THEN("It is empty") {
+      REQUIRE(executor.empty());
+      REQUIRE_FALSE(executor.try_pop().has_value());
+      REQUIRE_FALSE(executor.try_pop_for(1ms).has_value());
+    }
+
+    WHEN("Tasks are pushed") {
+      std::vector<int> order;
+      executor.push([&order] { order.push_back(1); });
+      executor.push([&order] { order.push_back(2); });
+
+      THEN("They are popped in FIFO order") {
+        REQUIRE(executor.size() == 2);
+        while (auto task = executor.try_pop()) {
+          (*task)();
+        }
+        REQUIRE(order == std::vector<int>{1, 2});
+        REQUIRE(executor.empty());
+        REQUIRE(executor.getStatistics().pushed == 2);
+        REQUIRE(executor.getStatistics().popped_injected == 2);
+      }
+    }
+
+    WHEN("A task of a worker is left in its deque") {
+      std::atomic_bool executed = false;
+      std::thread worker([&] {
+        executor.attachWorker();
+        executor.push([&executed] { executed = true; });
+        executor.detachWorker();
+      });
+      worker.join();
+
+      THEN("It can still be popped by another thread") {
+        auto task = executor.try_pop();
+        REQUIRE(task.has_value());
+        (*task)();
+        REQUIRE(executed);
+      }
+    }
+
+    WHEN("A thread waits for a task and wakeAll() is called") {
+      std::atomic_bool returned = false;
+      std::thread waiter([&] {
+        executor.try_pop_for(10s);
+        returned = true;
+      });
+      std::this_thread::sleep_for(10ms);
+      executor.wakeAll();
+      waiter.join();
+
+      THEN("The thread returned early") { REQUIRE(returned); }
+    }
+
+    WHEN("A thread blocks in pop() until a task is pushed") {
+      std::atomic_bool popped = false;
+      std::thread waiter([&] { popped = executor.pop([] { return false; }).has_value(); });
+      std::this_thread::sleep_for(10ms);
+      executor.push([] {});
+      waiter.join();
+
+      THEN("It got the task") { REQUIRE(popped); }
+    }
+
+    WHEN("A thread is cancelled before it blocks in pop()") {
+      std::atomic_bool cancelled = true;
+      executor.wakeAll();
+      auto task = executor.pop([&cancelled] { return cancelled.load(); });
+
+      THEN("It returns without waiting") { REQUIRE_FALSE(task.has_value()); }
+    }
+  }
+}
+
+TEST_CASE("core::common::WorkStealingExecutor ordered tasks",
+          "[core::common::WorkStealingExecutor]") {
+  GIVEN("A WorkStealingExecutor with 4 workers") {
+    vda5050pp::core::common::WorkStealingExecutor executor;
+    constexpr int k_keys = 8;
+    constexpr int k_tasks_per_key = 500;
+
+    std::array<std::vector<int>, k_keys> executed;
+    std::array<std::atomic_int, k_keys> running{};
+    std::atomic_bool overlapped = false;
+    std::atomic_int done = 0;
+
+    WHEN("Tasks are pushed with ordering keys") {
+      for (int i = 0; i < k_tasks_per_key; i++) {
+        for (int k = 0; k < k_keys; k++) {
+          executor.push(&executed[k], [&, k, i] {
+            if (running[k]++ != 0) {
+              overlapped = true;
+            }
+            executed[k].push_back(i);
+            running[k]--;
+            done++;
+          });
+        }
+      }
+      runWorkers(executor, 4, [&done] { return done == k_keys * k_tasks_per_key; });
+
+      THEN("Tasks of the same key ran in FIFO order and never concurrently") {
+        REQUIRE_FALSE(overlapped);
+        for (const auto &e : executed) {
+          REQUIRE(e.size() == k_tasks_per_key);
+          REQUIRE(std::is_sorted(e.begin(), e.end()));
+        }
+        REQUIRE(executor.empty());
+      }
+    }
+  }
+}
+
+TEST_CASE("core::common::WorkStealingExecutor work stealing",
+          "[core::common::WorkStealingExecutor]") {
+  GIVEN("A WorkStealingExecutor with 4 workers") {
+    vda5050pp::core::common::WorkStealingExecutor executor;
+    std::atomic_int done = 0;
+    constexpr int k_tasks = 1000;
+
+    WHEN("A single task spawns all other tasks from a worker") {
+      executor.push([&] {
+        for (int i = 0; i < k_tasks; i++) {
+          executor.push([&done] {
+            std::this_thread::sleep_for(10us);
+            done++;
+          });
+        }
+      });
+      runWorkers(executor, 4, [&done] { return done == k_tasks; });
+
+      THEN("All tasks were executed and the other workers stole tasks") {
+        REQUIRE(done == k_tasks);
+        REQUIRE(executor.getStatistics().stolen > 0);
+      }
+    }
+  }
+}
+
+TEST_CASE("core::common::WorkStealingExecutor priority lanes",
+          "[core::common::WorkStealingExecutor]") {
+  using vda5050pp::core::common::TaskLane;
+
+  GIVEN("A WorkStealingExecutor with tasks in all lanes") {
+    vda5050pp::core::common::WorkStealingExecutor executor;
+    std::vector<TaskLane> executed;
+    auto push = [&executor, &executed](TaskLane lane, int n) {
+      for (int i = 0; i < n; i++) {
+        executor.push(lane, [&executed, lane] { executed.push_back(lane); });
+      }
+    };
+    auto run_all = [&executor] {
+      while (auto task = executor.try_pop()) {
+        (*task)();
+      }
+    };
+
+    WHEN("Each lane has a single task") {
+      push(TaskLane::k_housekeeping, 1);
+      push(TaskLane::k_action, 1);
+      int key = 0;
+      executor.push(&key, TaskLane::k_navigation, [&executed] {
+        executed.push_back(TaskLane::k_navigation);
+      });
+      push(TaskLane::k_stop, 1);
+      run_all();
+
+      THEN("They are executed by priority") {
+        REQUIRE(executed == std::vector<TaskLane>{TaskLane::k_stop, TaskLane::k_navigation,
+                                                  TaskLane::k_action,
+                                                  TaskLane::k_housekeeping});
+      }
+
+      THEN("The lane metrics were recorded") {
+        auto statistics = executor.getStatistics();
+        for (const auto &lane : statistics.lanes) {
+          REQUIRE(lane.pushed == 1);
+          REQUIRE(lane.started == 1);
+          REQUIRE(lane.depth == 0);
+          REQUIRE(lane.max_depth == 1);
+          REQUIRE(lane.wait_time.count() == 1);
+        }
+      }
+    }
+
+    WHEN("A high priority lane is always busy") {
+      executor.setStarvationLimit(4);
+      push(TaskLane::k_action, 1);
+      push(TaskLane::k_stop, 20);
+      run_all();
+
+      THEN("The low priority task is served after the starvation limit") {
+        REQUIRE(executed.size() == 21);
+        REQUIRE(executed[4] == TaskLane::k_action);
+        REQUIRE(executor.getStatistics().starvation_promotions == 1);
+        REQUIRE(executor.getStatistics().lanes[0].max_depth == 20);
+      }
+    }
+  }
+}
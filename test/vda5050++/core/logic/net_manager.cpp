@@ -7,14 +7,17 @@
 
 #include "vda5050++/core/logic/net_manager.h"
 
+#include <algorithm>
 #include <catch2/catch.hpp>
 #include <functional>
 #include <map>
+#include <stdexcept>
 #include <utility>
 
 #include "test/console_logger.h"
 #include "test/order_factory.hpp"
 #include "test/test_action_handler.h"
+#include "test/test_continuous_navigation_handler.h"
 #include "test/test_connector.h"
 #include "test/test_pause_resume_handler.h"
 #include "test/test_step_based_navigation_handler.h"
@@ -556,4 +559,307 @@ TEST_CASE("core::logic::NetManager - action interception edge cases", "[core][lo
       }
     }
   }
-}
\ No newline at end of file
+}
+TEST_CASE("core::logic::NetManager - garbage collection", "[core][logic]") {
+  GIVEN("A NetManager with an order of many HARD blocking actions") {
+    using Handlers =
+        vda5050pp::interface_agv::Handlers<test::TestStepBasedNavigationHandler,
+                                           test::TestActionHandler, test::TestPauseResumeHandler>;
+
+    vda5050pp::interface_agv::Handle handle({}, std::make_shared<test::TestConnector>(),
+                                            Handlers{});
+    auto &state = vda5050pp::core::interface_agv::HandleAccessor(handle).getState();
+
+    test::TestActionHandler::setAutoFailOnStop(true);
+    test::TestActionHandler::setAutoStart(true);
+    test::TestActionHandler::setAutoPause(false);
+    test::TestActionHandler::setAutoResume(false);
+
+    constexpr int k_actions = 50;
+    std::vector<vda5050pp::Action> actions;
+    for (int i = 0; i < k_actions; i++) {
+      actions.push_back(
+          {"Test", "A" + std::to_string(i), std::nullopt, vda5050pp::BlockingType::HARD, {}});
+    }
+    vda5050pp::Order order{
+        {}, "testOrder", 0, std::nullopt, {test::mkNode("N1", 0, true, actions)}, {}};
+    state.setOrder(order);
+
+    vda5050pp::core::logic::NetManager net_manager(handle);
+    net_manager.interpret();
+    handle.spinAll();
+    auto initial_places = net_manager.getNet().numPlaces();
+
+    WHEN("The actions finish one after another") {
+      // the whole order is interpreted up front, so only the passed time steps can be removed
+      bool shrinking = true;
+      auto places = initial_places;
+      for (int i = 0; i < k_actions; i++) {
+        test::test_action_handler_by_id.at("A" + std::to_string(i)).get().doFinished();
+        handle.spinAll();
+        net_manager.tick();
+        handle.spinAll();
+        // the step of the last action holds the tail place and is kept
+        if (i + 1 < k_actions) {
+          shrinking = shrinking && net_manager.getNet().numPlaces() < places;
+        }
+        places = net_manager.getNet().numPlaces();
+      }
+
+      THEN("The net only contains the last time step") {
+        testActionStatus(handle, {"A0", "A24", "A49"}, vda5050pp::ActionStatus::FINISHED);
+        REQUIRE(shrinking);
+        REQUIRE(net_manager.getNet().numPlaces() < initial_places / k_actions * 2);
+      }
+
+      THEN("The managers of collected time steps were released") {
+        REQUIRE(test::test_action_handler_by_id.count("A0") == 0);
+        REQUIRE(test::test_action_handler_by_id.count("A48") == 0);
+        REQUIRE(net_manager.getFinishPlaces().size() == 1);
+      }
+    }
+
+    WHEN("The user retains a handler until its time step was collected") {
+      auto handler = std::static_pointer_cast<test::TestActionHandler>(
+          net_manager.findActionManager("A0")->getHandler());
+      handler->doFinished();
+      handle.spinAll();
+      test::test_action_handler_by_id.at("A1").get().doFinished();
+      handle.spinAll();
+      net_manager.tick();
+      handle.spinAll();
+
+      THEN("Its manager was released and calling the handler is ignored") {
+        REQUIRE(net_manager.findActionManager("A0") == nullptr);
+        REQUIRE(handler.use_count() == 1);
+        REQUIRE_NOTHROW(handler->doFinished());
+        REQUIRE_NOTHROW(handler->doFailed());
+        testActionStatus(handle, "A0", vda5050pp::ActionStatus::FINISHED);
+      }
+    }
+  }
+}
+
+TEST_CASE("core::logic::NetManager - continuous navigation garbage collection", "[core][logic]") {
+  GIVEN("A NetManager with a continuous navigation order, interrupted by HARD actions") {
+    using Handlers =
+        vda5050pp::interface_agv::Handlers<test::TestContinuousNavigationHandler,
+                                           test::TestActionHandler, test::TestPauseResumeHandler>;
+
+    vda5050pp::interface_agv::Handle handle({}, std::make_shared<test::TestConnector>(),
+                                            Handlers{});
+    auto &state = vda5050pp::core::interface_agv::HandleAccessor(handle).getState();
+
+    test::test_action_handler_by_id.clear();
+    test::continuous_navigation_handler_by_seq.clear();
+    test::TestActionHandler::setAutoFailOnStop(true);
+    test::TestActionHandler::setAutoStart(true);
+    test::TestActionHandler::setAutoPause(false);
+    test::TestActionHandler::setAutoResume(false);
+    test::TestContinuousNavigationHandler::setAutoStart(true);
+    test::TestContinuousNavigationHandler::setAutoFailOnStop(false);
+
+    // each HARD action finalizes the continuous navigation manager of the preceding edge
+    constexpr uint32_t k_nodes = 8;
+    std::vector<vda5050pp::Node> nodes;
+    std::vector<vda5050pp::Edge> edges;
+    for (uint32_t i = 0; i < k_nodes; i++) {
+      auto id = std::to_string(i);
+      std::vector<vda5050pp::Action> actions;
+      if (i > 0) {
+        actions.push_back({"Test", "A" + id, std::nullopt, vda5050pp::BlockingType::HARD, {}});
+        edges.push_back(
+            test::mkEdge("E" + id, 2 * i - 1, true, "N" + std::to_string(i - 1), "N" + id, {}));
+      }
+      nodes.push_back(test::mkNode("N" + id, 2 * i, true, actions));
+    }
+    vda5050pp::Order order{{}, "testOrder", 0, std::nullopt, nodes, edges};
+    state.setOrder(order);
+
+    vda5050pp::core::logic::NetManager net_manager(handle);
+    net_manager.interpret();
+    handle.spinAll();
+    auto initial_managers = net_manager.numContinuousNavigationManagers();
+
+    WHEN("The AGV drives through the order") {
+      for (uint32_t i = 1; i < k_nodes; i++) {
+        test::continuous_navigation_handler_by_seq.at(2 * i).get().doNodeReached(2 * i);
+        handle.spinAll();
+        net_manager.tick();
+        handle.spinAll();
+        test::test_action_handler_by_id.at("A" + std::to_string(i)).get().doFinished();
+        handle.spinAll();
+        net_manager.tick();
+        handle.spinAll();
+      }
+
+      THEN("The finalized continuous navigation managers were released") {
+        testActionStatus(handle, {"A1", "A4", "A7"}, vda5050pp::ActionStatus::FINISHED);
+        REQUIRE(initial_managers == k_nodes - 1);
+        REQUIRE(net_manager.numContinuousNavigationManagers() <= 1);
+      }
+    }
+  }
+}
+
+TEST_CASE("core::logic::NetManager - interpretation window", "[core][logic]") {
+  GIVEN("A NetManager with a window of 4 time steps and an order of 10 nodes") {
+    using Handlers =
+        vda5050pp::interface_agv::Handlers<test::TestStepBasedNavigationHandler,
+                                           test::TestActionHandler, test::TestPauseResumeHandler>;
+
+    vda5050pp::interface_agv::Handle handle({}, std::make_shared<test::TestConnector>(),
+                                            Handlers{});
+    handle.setInterpretationWindow(4);
+    auto &state = vda5050pp::core::interface_agv::HandleAccessor(handle).getState();
+
+    test::test_action_handler_by_id.clear();
+    test::navigate_to_node_handler_by_seq.clear();
+    test::TestActionHandler::setAutoFailOnStop(true);
+    test::TestActionHandler::setAutoStart(true);
+    test::TestActionHandler::setAutoPause(false);
+    test::TestActionHandler::setAutoResume(false);
+    test::TestStepBasedNavigationHandler::setAutoStart(true);
+
+    // each node has a HARD action, so each node adds a driving and an action time step
+    constexpr uint32_t k_nodes = 10;
+    std::vector<vda5050pp::Node> nodes;
+    std::vector<vda5050pp::Edge> edges;
+    for (uint32_t i = 0; i < k_nodes; i++) {
+      auto id = std::to_string(i);
+      nodes.push_back(test::mkNode(
+          "N" + id, 2 * i, true,
+          {{"Test", "A" + id, std::nullopt, vda5050pp::BlockingType::HARD, {}}}));
+      if (i > 0) {
+        edges.push_back(
+            test::mkEdge("E" + id, 2 * i - 1, true, "N" + std::to_string(i - 1), "N" + id, {}));
+      }
+    }
+    vda5050pp::Order order{{}, "testOrder", 0, std::nullopt, nodes, edges};
+    state.setOrder(order);
+
+    vda5050pp::core::logic::NetManager net_manager(handle);
+    net_manager.interpret();
+    handle.spinAll();
+
+    THEN("Only the window was interpreted") {
+      REQUIRE(test::test_action_handler_by_id.count("A0") == 1);
+      REQUIRE(test::test_action_handler_by_id.count("A9") == 0);
+      REQUIRE(state.getStateUnsafe().graph_next_interpreted_seq_id_ < 2 * k_nodes - 1);
+      REQUIRE(net_manager.isAnythingActive());
+    }
+
+    WHEN("The vehicle drives through the order") {
+      std::size_t max_handlers = 0;
+      for (uint32_t i = 0; i < k_nodes; i++) {
+        max_handlers = std::max(max_handlers, test::test_action_handler_by_id.size());
+        test::test_action_handler_by_id.at("A" + std::to_string(i)).get().doFinished();
+        handle.spinAll();
+        if (i + 1 < k_nodes) {
+          test::navigate_to_node_handler_by_seq.at(2 * (i + 1)).get().doFinished();
+          handle.spinAll();
+        }
+      }
+
+      THEN("The window was extended lazily") {
+        testActionStatus(handle, {"A0", "A5", "A9"}, vda5050pp::ActionStatus::FINISHED);
+        REQUIRE(max_handlers <= 3);
+        REQUIRE(state.getStateUnsafe().graph_next_interpreted_seq_id_ == 2 * k_nodes - 1);
+        REQUIRE_FALSE(net_manager.isAnythingActive());
+      }
+    }
+
+    WHEN("The order is canceled") {
+      net_manager.cancelAll();
+      handle.spinAll();
+
+      THEN("The actions of the uninterpreted base failed") {
+        testActionStatus(handle, {"A0", "A5", "A9"}, vda5050pp::ActionStatus::FAILED);
+        REQUIRE(state.getStateUnsafe().graph_next_interpreted_seq_id_ == 2 * k_nodes - 1);
+        REQUIRE_FALSE(net_manager.isAnythingActive());
+      }
+    }
+  }
+}
+
+TEST_CASE("core::logic::NetManager - pause and cancel fan-out", "[core][logic]") {
+  GIVEN("A NetManager with an order of 3 nodes with a NONE blocking action each") {
+    using Handlers =
+        vda5050pp::interface_agv::Handlers<test::TestStepBasedNavigationHandler,
+                                           test::TestActionHandler, test::TestPauseResumeHandler>;
+
+    vda5050pp::interface_agv::Handle handle({}, std::make_shared<test::TestConnector>(),
+                                            Handlers{});
+    auto &state = vda5050pp::core::interface_agv::HandleAccessor(handle).getState();
+
+    test::test_action_handler_by_id.clear();
+    test::navigate_to_node_handler_by_seq.clear();
+    test::TestActionHandler::setAutoFailOnStop(true);
+    test::TestActionHandler::setAutoStart(true);
+    test::TestActionHandler::setAutoPause(true);
+    test::TestActionHandler::setAutoResume(true);
+    test::TestStepBasedNavigationHandler::setAutoStart(true);
+    test::TestStepBasedNavigationHandler::setAutoFailOnStop(true);
+
+    auto mk_action = [](const std::string &id) -> vda5050pp::Action {
+      return {"Test", id, std::nullopt, vda5050pp::BlockingType::NONE, {}};
+    };
+    vda5050pp::Order order{{},
+                           "testOrder",
+                           0,
+                           std::nullopt,
+                           {test::mkNode("N0", 0, true, {mk_action("A0")}),
+                            test::mkNode("N1", 2, true, {mk_action("A1")}),
+                            test::mkNode("N2", 4, true, {mk_action("A2")})},
+                           {test::mkEdge("E1", 1, true, "N0", "N1", {}),
+                            test::mkEdge("E2", 3, true, "N1", "N2", {})}};
+    state.setOrder(order);
+
+    vda5050pp::core::logic::NetManager net_manager(handle);
+    net_manager.interpret();
+    handle.spinAll();
+
+    WHEN("All running actions are paused") {
+      net_manager.pauseAllRunningActions();
+      handle.spinAll();
+
+      testActionStatus(handle, "A0", vda5050pp::ActionStatus::PAUSED);
+      testActionStatus(handle, {"A1", "A2"}, vda5050pp::ActionStatus::WAITING);
+
+      WHEN("All paused actions are resumed") {
+        net_manager.resumeAllPausedActions();
+        handle.spinAll();
+
+        testActionStatus(handle, "A0", vda5050pp::ActionStatus::RUNNING);
+        testActionStatus(handle, {"A1", "A2"}, vda5050pp::ActionStatus::WAITING);
+      }
+    }
+
+    WHEN("Actions are looked up without exceptions") {
+      THEN("Unknown ids are not found") {
+        REQUIRE(net_manager.findActionManager("X") == nullptr);
+        REQUIRE_FALSE(net_manager.stopActionIfActive("X"));
+        REQUIRE_THROWS_AS(net_manager.isActionActive("X"), std::invalid_argument);
+      }
+      THEN("Known ids are found") {
+        REQUIRE(net_manager.findActionManager("A1") != nullptr);
+      }
+      THEN("Only active actions are stopped") {
+        REQUIRE_FALSE(net_manager.stopActionIfActive("A1"));
+        REQUIRE(net_manager.stopActionIfActive("A0"));
+      }
+    }
+
+    WHEN("The order is canceled") {
+      net_manager.cancelAll();
+      handle.spinAll();
+
+      testActionStatus(handle, {"A0", "A1", "A2"}, vda5050pp::ActionStatus::FAILED);
+      THEN("Nothing is active anymore") {
+        REQUIRE_FALSE(net_manager.isAnythingActive());
+        REQUIRE(test::navigate_to_node_handler_by_seq.count(2) == 1);
+        REQUIRE(test::navigate_to_node_handler_by_seq.at(2).get().timesStopCalled() == 1);
+      }
+    }
+  }
+}
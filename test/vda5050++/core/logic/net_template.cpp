@@ -0,0 +1,93 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+
+#include "vda5050++/core/logic/net_template.h"
+
+#include <catch2/catch.hpp>
+
+#include "vda5050++/core/logic/types.h"
+
+using namespace vda5050pp::core::logic;
+
+static constexpr PlaceTemplate k_places[] = {
+    {LogicTaskNetTypes::k_ready, 1},
+    {LogicTaskNetTypes::k_running, 0},
+    {LogicTaskNetTypes::k_done, 0},
+};
+
+static constexpr TransitionTemplate k_transitions[] = {
+    {LogicTaskNetTypes::k_start,
+     {LogicTaskNetTypes::k_ready},
+     1,
+     {LogicTaskNetTypes::k_running},
+     1,
+     true},
+    {LogicTaskNetTypes::k_finish,
+     {LogicTaskNetTypes::k_running},
+     1,
+     {LogicTaskNetTypes::k_done},
+     1,
+     false},
+};
+
+static constexpr NetTemplate k_template(k_places, k_transitions);
+
+TEST_CASE("core::logic::NetTemplate - instantiate", "[core][logic]") {
+  GIVEN("A net and a template") {
+    Net net;
+
+    REQUIRE(k_template.numPlaces() == 3);
+    REQUIRE(k_template.numTransitions() == 2);
+
+    WHEN("The template is instantiated for two seqs") {
+      k_template.instantiate(net, 1);
+      k_template.instantiate(net, 2);
+
+      THEN("Both instances are in the net") {
+        REQUIRE(net.numPlaces() == 6);
+        REQUIRE(net.numTransitions() == 4);
+        for (SeqNrT seq : {1, 2}) {
+          REQUIRE(net.findPlace({LogicTaskNetTypes::k_ready, seq})->getTokens() == 1);
+          REQUIRE(net.findPlace({LogicTaskNetTypes::k_running, seq})->getTokens() == 0);
+          REQUIRE(net.findTransition({LogicTaskNetTypes::k_start, seq})->isAutoFire());
+          REQUIRE_FALSE(net.findTransition({LogicTaskNetTypes::k_finish, seq})->isAutoFire());
+        }
+      }
+
+      THEN("getIDs returns the IDs of an instance") {
+        std::vector<LogicTaskNetID> places;
+        std::vector<LogicTaskNetID> transitions;
+        k_template.getIDs(2, places, transitions);
+
+        REQUIRE(places.size() == 3);
+        REQUIRE(transitions.size() == 2);
+        for (const auto &id : places) {
+          REQUIRE(id.seq == 2);
+          REQUIRE(net.findPlace(id) != nullptr);
+        }
+        for (const auto &id : transitions) {
+          REQUIRE(id.seq == 2);
+          REQUIRE(net.findTransition(id) != nullptr);
+        }
+      }
+
+      THEN("The instances fire independently") {
+        REQUIRE(net.findTransition({LogicTaskNetTypes::k_start, 1})->fire());
+        REQUIRE(net.findTransition({LogicTaskNetTypes::k_finish, 1})->fire());
+        REQUIRE(net.findPlace({LogicTaskNetTypes::k_done, 1})->getTokens() == 1);
+        REQUIRE(net.findPlace({LogicTaskNetTypes::k_ready, 2})->getTokens() == 1);
+        REQUIRE(net.findPlace({LogicTaskNetTypes::k_done, 2})->getTokens() == 0);
+      }
+    }
+
+    WHEN("The template is instantiated twice for the same seq") {
+      k_template.instantiate(net, 1);
+
+      THEN("It throws") { REQUIRE_THROWS(k_template.instantiate(net, 1)); }
+    }
+  }
+}
@@ -0,0 +1,276 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+
+#include "vda5050++/core/logic/net_trace.h"
+
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "test/order_factory.hpp"
+#include "test/test_action_handler.h"
+#include "test/test_connector.h"
+#include "test/test_pause_resume_handler.h"
+#include "test/test_step_based_navigation_handler.h"
+#include "vda5050++/core/interface_agv/handle_accessor.h"
+#include "vda5050++/core/logic/net_manager.h"
+#include "vda5050++/interface_agv/handle.h"
+
+using namespace vda5050pp::core::logic;
+
+TEST_CASE("core::logic::NetTrace - ring buffer", "[core][logic]") {
+  GIVEN("A net with a place") {
+    NetTrace trace;
+    Net net;
+    auto place = net.addPlace({LogicTaskNetTypes::k_running, 1}, 0);
+    int calls = 0;
+    auto hook = [&calls](const Net::PlaceT &, Net::TokenCounterT) { calls++; };
+
+    WHEN("The place is hooked while the trace is disabled") {
+      place->onChange(trace.traced(hook));
+      trace.enable(4);
+      trace.disable();
+      place->setTokens(1);
+      trace.recordTransition({LogicTaskNetTypes::k_start, 1});
+
+      THEN("Nothing is recorded, but the hook is called") {
+        REQUIRE(calls == 1);
+        REQUIRE(trace.getEvents().empty());
+        REQUIRE(trace.hook() == nullptr);
+      }
+    }
+
+    WHEN("More events than the capacity are recorded") {
+      trace.enable(4);
+      place->onChange(trace.traced(hook));
+      for (Net::TokenCounterT tokens = 1; tokens <= 5; tokens++) {
+        place->setTokens(tokens);
+      }
+      trace.recordTransition({LogicTaskNetTypes::k_finish, 1});
+
+      THEN("The oldest events were dropped") {
+        auto events = trace.getEvents();
+        REQUIRE(calls == 5);
+        REQUIRE(events.size() == 4);
+        REQUIRE(trace.getDropped() == 2);
+        REQUIRE(events[0].type == NetTrace::EventType::k_place);
+        REQUIRE(events[0].tokens == 3);
+        REQUIRE(events[0].prev_tokens == 2);
+        REQUIRE(events[3].type == NetTrace::EventType::k_transition);
+        REQUIRE(events[3].id == LogicTaskNetID{LogicTaskNetTypes::k_finish, 1});
+        for (std::size_t i = 1; i < events.size(); i++) {
+          REQUIRE(events[i - 1].time_ns <= events[i].time_ns);
+        }
+      }
+
+      THEN("Disabling keeps the events") {
+        trace.disable();
+        place->setTokens(0);
+        REQUIRE(trace.getEvents().size() == 4);
+      }
+    }
+
+    WHEN("A place is filled and emptied") {
+      trace.enable(16);
+      place->onChange(trace.hook());
+      place->setTokens(1);
+      place->setTokens(0);
+
+      THEN("The Chrome trace contains an async slice") {
+        std::stringstream ss;
+        trace.writeChromeTrace(ss);
+        auto json = ss.str();
+        REQUIRE(json.find("\"traceEvents\":[") != std::string::npos);
+        REQUIRE(json.find("\"name\":\"running@1\",\"cat\":\"place\",\"ph\":\"b\"") !=
+                std::string::npos);
+        REQUIRE(json.find("\"name\":\"running@1\",\"cat\":\"place\",\"ph\":\"e\"") !=
+                std::string::npos);
+        REQUIRE(json.find("\"ts\":0.000") != std::string::npos);
+      }
+    }
+  }
+}
+
+TEST_CASE("core::logic::NetTrace - orphan slice ends", "[core][logic]") {
+  GIVEN("A place, whose filling event was overwritten") {
+    NetTrace trace;
+    Net net;
+    auto place = net.addPlace({LogicTaskNetTypes::k_running, 1}, 0);
+    trace.enable(2);
+    place->onChange(trace.hook());
+    place->setTokens(1);
+    trace.recordTransition({LogicTaskNetTypes::k_start, 1});
+    place->setTokens(2);
+    place->setTokens(0);
+
+    THEN("The Chrome trace neither ends nor extends the slice") {
+      std::stringstream ss;
+      trace.writeChromeTrace(ss);
+      REQUIRE(trace.getEvents().size() == 2);
+      REQUIRE(ss.str().find("\"cat\":\"place\"") == std::string::npos);
+    }
+  }
+}
+
+TEST_CASE("core::logic::NetTrace - automatic transitions", "[core][logic]") {
+  GIVEN("A net a -> t1 -> b -> t2 (automatic) -> c") {
+    NetTrace trace;
+    Net net;
+    net.setTrace(&trace);
+    LogicTaskNetID a{LogicTaskNetTypes::k_ready, 1};
+    LogicTaskNetID b{LogicTaskNetTypes::k_running, 1};
+    LogicTaskNetID c{LogicTaskNetTypes::k_done, 1};
+    LogicTaskNetID t1{LogicTaskNetTypes::k_start, 1};
+    LogicTaskNetID t2{LogicTaskNetTypes::k_finish, 1};
+    auto build = [&] {
+      net.addPlace(a, 1);
+      net.addPlace(b, 0);
+      net.addPlace(c, 0);
+      net.addTransition({t1, {{a, 1}}, {{b, 1}}});
+      net.addTransition({t2, {{b, 1}}, {{c, 1}}});
+      net.findTransition(t2)->autoFire();
+    };
+    auto transitions = [&trace] {
+      std::vector<LogicTaskNetID> ids;
+      for (const auto &event : trace.getEvents()) {
+        if (event.type == NetTrace::EventType::k_transition) {
+          ids.push_back(event.id);
+        }
+      }
+      return ids;
+    };
+
+    WHEN("The net was built while the trace was enabled") {
+      trace.enable(16);
+      build();
+      REQUIRE(trace.deepFire(net, *net.findTransition(t1)));
+
+      THEN("The cascade fired and both transitions were recorded") {
+        REQUIRE(net.findPlace(c)->getTokens() == 1);
+        REQUIRE(transitions() == std::vector<LogicTaskNetID>{t1, t2});
+      }
+    }
+
+    WHEN("The net was built before the trace was enabled") {
+      build();
+      trace.enable(16);
+      REQUIRE(trace.deepFire(net, *net.findTransition(t1)));
+
+      THEN("The cascade fired, but only the fired transition was recorded") {
+        REQUIRE(net.findPlace(c)->getTokens() == 1);
+        REQUIRE(transitions() == std::vector<LogicTaskNetID>{t1});
+      }
+    }
+
+    WHEN("The automatic transition was removed from the net") {
+      trace.enable(16);
+      build();
+      auto removed = net.findTransition(t2);
+      net.removeTransition(t2);
+      REQUIRE(trace.deepFire(net, *net.findTransition(t1)));
+
+      THEN("It is not fired") {
+        REQUIRE(net.findPlace(c)->getTokens() == 0);
+        REQUIRE(transitions() == std::vector<LogicTaskNetID>{t1});
+      }
+    }
+  }
+}
+
+TEST_CASE("core::logic::NetTrace - concurrent recording", "[core][logic]") {
+  GIVEN("An enabled trace and 4 recording threads") {
+    NetTrace trace;
+    trace.enable(64);
+    constexpr SeqNrT k_events = 10000;
+
+    WHEN("The events are read while they are recorded") {
+      std::vector<std::thread> threads;
+      for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&trace] {
+          for (SeqNrT seq = 0; seq < k_events; seq++) {
+            trace.recordTransition({LogicTaskNetTypes::k_start, seq});
+          }
+        });
+      }
+      bool consistent = true;
+      for (int i = 0; i < 100; i++) {
+        for (const auto &event : trace.getEvents()) {
+          consistent &= event.type == NetTrace::EventType::k_transition &&
+                        event.id.type == LogicTaskNetTypes::k_start && event.tokens == 0;
+        }
+      }
+      for (auto &thread : threads) {
+        thread.join();
+      }
+
+      THEN("Only completely written events were read") {
+        REQUIRE(consistent);
+        REQUIRE(trace.getEvents().size() == 64);
+        REQUIRE(trace.getDropped() == 4 * k_events - 64);
+      }
+    }
+  }
+}
+
+TEST_CASE("core::logic::NetTrace - order execution", "[core][logic]") {
+  GIVEN("A Handle with an enabled net trace") {
+    using Handlers =
+        vda5050pp::interface_agv::Handlers<test::TestStepBasedNavigationHandler,
+                                           test::TestActionHandler, test::TestPauseResumeHandler>;
+
+    vda5050pp::interface_agv::Handle handle({}, std::make_shared<test::TestConnector>(),
+                                            Handlers{});
+    handle.enableNetTrace(1024);
+    auto &state = vda5050pp::core::interface_agv::HandleAccessor(handle).getState();
+
+    test::TestActionHandler::setAutoFailOnStop(true);
+    test::TestActionHandler::setAutoStart(true);
+    test::TestActionHandler::setAutoPause(false);
+    test::TestActionHandler::setAutoResume(false);
+
+    vda5050pp::Order order{{},
+                           "testOrder",
+                           0,
+                           std::nullopt,
+                           {test::mkNode("N1", 0, true,
+                                         {{"Test", "A0", std::nullopt,
+                                           vda5050pp::BlockingType::HARD, {}}})},
+                           {}};
+    state.setOrder(order);
+
+    NetManager net_manager(handle);
+    net_manager.interpret();
+    handle.spinAll();
+
+    WHEN("The action finishes") {
+      test::test_action_handler_by_id.at("A0").get().doFinished();
+      handle.spinAll();
+
+      THEN("The firings of the task were recorded, including the automatic ones") {
+        auto events = net_manager.getNetTrace().getEvents();
+        auto has = [&events](NetTrace::EventType type, LogicTaskNetTypes id_type) {
+          return std::any_of(events.begin(), events.end(), [type, id_type](const auto &e) {
+            return e.type == type && e.id.type == id_type;
+          });
+        };
+        REQUIRE(has(NetTrace::EventType::k_transition, LogicTaskNetTypes::k_started));
+        REQUIRE(has(NetTrace::EventType::k_transition, LogicTaskNetTypes::k_finish));
+        // fired automatically by the finish transition
+        REQUIRE(has(NetTrace::EventType::k_transition, LogicTaskNetTypes::k_pre_to_done));
+        REQUIRE(has(NetTrace::EventType::k_place, LogicTaskNetTypes::k_ready));
+        REQUIRE(has(NetTrace::EventType::k_place, LogicTaskNetTypes::k_running));
+        REQUIRE(has(NetTrace::EventType::k_place, LogicTaskNetTypes::k_exited));
+
+        std::stringstream ss;
+        handle.writeNetTrace(ss);
+        REQUIRE(ss.str().find("\"cat\":\"transition\",\"ph\":\"i\"") != std::string::npos);
+      }
+    }
+  }
+}
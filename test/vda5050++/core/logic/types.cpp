@@ -0,0 +1,37 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+
+#include "vda5050++/core/logic/types.h"
+
+#include <catch2/catch.hpp>
+#include <unordered_set>
+
+TEST_CASE("core::logic::LogicTaskNetID - key", "[core][logic]") {
+  using namespace vda5050pp::core::logic;
+
+  GIVEN("Some IDs") {
+    LogicTaskNetID a{LogicTaskNetTypes::k_combinator_dangling_transition, 1};
+    LogicTaskNetID b{LogicTaskNetTypes::k_ready, 2};
+    LogicTaskNetID c{LogicTaskNetTypes::k_done, 2};
+    LogicTaskNetID d{LogicTaskNetTypes::k_ready, 0x10000};
+
+    THEN("They are ordered by seq, then by type") {
+      REQUIRE(a < b);
+      REQUIRE(b < c);
+      REQUIRE(c < d);
+      REQUIRE_FALSE(b < b);
+      REQUIRE_FALSE(d < b);
+    }
+
+    THEN("The keys are distinct, also for seqs above 16 bit") {
+      std::unordered_set<LogicTaskNetID> ids{a, b, c, d};
+      REQUIRE(ids.size() == 4);
+      REQUIRE(ids.count({LogicTaskNetTypes::k_ready, 0x10000}) == 1);
+      REQUIRE(ids.count({LogicTaskNetTypes::k_ready, 0}) == 0);
+    }
+  }
+}
@@ -0,0 +1,156 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains tests for the state update timer on shared executors
+//
+
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "test/test_action_handler.h"
+#include "test/test_connector.h"
+#include "test/test_continuous_navigation_handler.h"
+#include "test/test_odometry_handler.h"
+#include "test/test_pause_resume_handler.h"
+#include "vda5050++/core/common/simulation_executor.h"
+#include "vda5050++/core/common/thread_pool_executor.h"
+#include "vda5050++/interface_agv/handle.h"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+// Records the headers of all sent messages
+class RecordingConnector : public test::TestConnector {
+public:
+  std::vector<vda5050pp::Header> states;
+  std::vector<vda5050pp::Header> visualizations;
+
+  void queueState(const vda5050pp::State &state) noexcept(false) override {
+    this->states.push_back(state.header);
+  }
+
+  void queueVisualization(const vda5050pp::Visualization &visualization) noexcept(
+      false) override {
+    this->visualizations.push_back(visualization.header);
+  }
+};
+
+// Records all log messages
+class RecordingLogger : public vda5050pp::interface_agv::Logger {
+private:
+  std::mutex mutex_;
+  std::vector<std::string> messages_;
+
+  void record(const std::string &log_message) {
+    std::scoped_lock lock(this->mutex_);
+    this->messages_.push_back(log_message);
+  }
+
+public:
+  void logInfo(const std::string &log_message) override { this->record(log_message); }
+  void logDebug(const std::string &log_message) override { this->record(log_message); }
+  void logWarn(const std::string &log_message) override { this->record(log_message); }
+  void logError(const std::string &log_message) override { this->record(log_message); }
+  void logFatal(const std::string &log_message) override { this->record(log_message); }
+
+  std::vector<std::string> messages() {
+    std::scoped_lock lock(this->mutex_);
+    return this->messages_;
+  }
+};
+
+struct SimulationRun {
+  std::vector<vda5050pp::Header> states;
+  std::vector<vda5050pp::Header> visualizations;
+};
+
+SimulationRun simulate(std::chrono::system_clock::duration duration) {
+  vda5050pp::interface_agv::Handlers<test::TestContinuousNavigationHandler,
+                                     test::TestActionHandler, test::TestPauseResumeHandler>
+      handlers;
+  auto simulation = std::make_shared<vda5050pp::core::common::SimulationExecutor>();
+  auto connector = std::make_shared<RecordingConnector>();
+  auto odometry = std::make_shared<test::OdometryHandler>();
+  {
+    vda5050pp::interface_agv::Handle handle({}, connector, handlers, nullptr, simulation);
+    handle.setOdometryHandler(odometry);
+    odometry->setAGVPosition({});
+    odometry->setVelocity({});
+    odometry->enableAutomaticVisualizationMessages(1s);
+
+    simulation->advanceBy(duration);
+  }
+  return {connector->states, connector->visualizations};
+}
+
+}  // namespace
+
+TEST_CASE("core::messages::StateUpdateTimer in simulation mode", "[core][messages]") {
+  using TimePoint = std::chrono::system_clock::time_point;
+
+  GIVEN("A Handle with automatic visualization messages attached to a SimulationExecutor") {
+    WHEN("The simulation advances by 5 minutes") {
+      auto run = simulate(5min);
+
+      THEN("A state was sent each state update period at virtual timestamps") {
+        // 10 periodic states and one on shutdown
+        REQUIRE(run.states.size() == 11);
+        for (std::size_t i = 0; i < 10; i++) {
+          REQUIRE(run.states[i].timestamp == TimePoint(30s * (i + 1)));
+        }
+        REQUIRE(run.states.back().timestamp == TimePoint(5min));
+      }
+
+      THEN("A visualization message was sent each second") {
+        REQUIRE(run.visualizations.size() == 300);
+        REQUIRE(run.visualizations.front().timestamp == TimePoint(1s));
+        REQUIRE(run.visualizations.back().timestamp == TimePoint(5min));
+      }
+
+      THEN("Another run yields the same messages") {
+        auto other = simulate(5min);
+        REQUIRE(other.states == run.states);
+        REQUIRE(other.visualizations == run.visualizations);
+      }
+    }
+  }
+}
+
+TEST_CASE("core::messages::StateUpdateTimer on a shared ThreadPoolExecutor", "[core][messages]") {
+  GIVEN("Two Handles with their own loggers attached to one ThreadPoolExecutor") {
+    vda5050pp::interface_agv::Handlers<test::TestContinuousNavigationHandler,
+                                       test::TestActionHandler, test::TestPauseResumeHandler>
+        handlers;
+    auto pool = std::make_shared<vda5050pp::core::common::ThreadPoolExecutor>(1);
+    auto connector_a = std::make_shared<RecordingConnector>();
+    auto connector_b = std::make_shared<RecordingConnector>();
+    auto logger_a = std::make_shared<RecordingLogger>();
+    auto logger_b = std::make_shared<RecordingLogger>();
+
+    WHEN("The Handles are shut down") {
+      {
+        vda5050pp::interface_agv::Handle handle_a({}, connector_a, handlers, logger_a, pool);
+        vda5050pp::interface_agv::Handle handle_b({}, connector_b, handlers, logger_b, pool);
+      }
+
+      THEN("Each Handle sent its state on its own connector") {
+        REQUIRE(connector_a->states.size() == 1);
+        REQUIRE(connector_b->states.size() == 1);
+      }
+
+      THEN("Each Handle logged to its own logger only") {
+        // both Handles did the same, so each logger got the same messages once
+        REQUIRE_FALSE(logger_a->messages().empty());
+        REQUIRE(logger_a->messages() == logger_b->messages());
+      }
+    }
+  }
+}
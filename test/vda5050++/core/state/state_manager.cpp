@@ -0,0 +1,51 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+
+#include "vda5050++/core/state/state_manager.h"
+
+#include <catch2/catch.hpp>
+
+#include "test/order_factory.hpp"
+
+TEST_CASE("core::state::StateManager - non-throwing lookups", "[core][state]") {
+  GIVEN("A StateManager with an order of 2 nodes, 1 edge and 1 action") {
+    vda5050pp::core::state::StateManager state;
+
+    vda5050pp::Action action{"Test", "A1", std::nullopt, vda5050pp::BlockingType::NONE, {}};
+    vda5050pp::Order order{{},
+                           "testOrder",
+                           0,
+                           std::nullopt,
+                           {test::mkNode("N0", 0, true, {}), test::mkNode("N1", 2, true, {action})},
+                           {test::mkEdge("E1", 1, true, "N0", "N1", {})}};
+    state.setOrder(order);
+
+    THEN("Unknown ids are not found") {
+      REQUIRE_FALSE(state.tryGetActionById("X").has_value());
+      REQUIRE_FALSE(state.trySetActionStatus("X", vda5050pp::ActionStatus::FAILED));
+      REQUIRE_FALSE(state.tryGetNodeBySeq(1).has_value());
+      REQUIRE_FALSE(state.tryGetEdgeBySeq(2).has_value());
+      REQUIRE_THROWS_AS(state.getNodeBySeq(1), std::invalid_argument);
+      REQUIRE_THROWS_AS(state.getEdgeBySeq(2), std::invalid_argument);
+    }
+
+    THEN("Known ids are found") {
+      REQUIRE(state.tryGetActionById("A1").has_value());
+      REQUIRE(state.tryGetNodeBySeq(2)->nodeId == "N1");
+      REQUIRE(state.tryGetEdgeBySeq(1)->edgeId == "E1");
+      REQUIRE(state.getNodeBySeq(0).nodeId == "N0");
+    }
+
+    WHEN("The status of a known action is set") {
+      THEN("It is updated") {
+        REQUIRE(state.trySetActionStatus("A1", vda5050pp::ActionStatus::FAILED));
+        auto status = state.getStateUnsafe().action_state_by_id.at("A1").actionStatus;
+        REQUIRE(status == vda5050pp::ActionStatus::FAILED);
+      }
+    }
+  }
+}
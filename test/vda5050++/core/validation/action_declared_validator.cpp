@@ -277,4 +277,90 @@ TEST_CASE("core::validation::ActionDeclared - parameter check", "[core][validati
       }
     }
   }
-}
\ No newline at end of file
+}
+TEST_CASE("core::validation::ActionDeclared - compiled plan", "[core][validation]") {
+  GIVEN("A compiled AGVDescription shared by validators") {
+    vda5050pp::interface_agv::agv_description::AGVDescription plan_description;
+    plan_description.supported_actions = {decl_pick, decl_honk};
+    auto plan = std::make_shared<const vda5050pp::core::validation::ActionValidationPlan>(
+        plan_description);
+
+    vda5050pp::core::validation::ActionDeclaredValidator validator_node(plan, false, false, true);
+    vda5050pp::core::validation::ActionDeclaredValidator validator_instant(plan, false, true,
+                                                                           false);
+
+    WHEN("A declared action is validated") {
+      vda5050pp::Action action = {
+          "pick", "id", std::nullopt, vda5050pp::BlockingType::HARD, {{{"place", "rear"}}}};
+
+      THEN("The context is still checked") {
+        REQUIRE(validator_node(action).empty());
+        REQUIRE_FALSE(validator_instant(action).empty());
+      }
+    }
+
+    WHEN("A control action is validated") {
+      vda5050pp::Action valid = {"initPosition",
+                                 "id",
+                                 std::nullopt,
+                                 vda5050pp::BlockingType::HARD,
+                                 {{{"x", "1.5"},
+                                   {"y", "-2"},
+                                   {"theta", "0"},
+                                   {"mapId", "map"},
+                                   {"lastNodeId", "n"}}}};
+      vda5050pp::Action bad_type = {"initPosition",
+                                    "id",
+                                    std::nullopt,
+                                    vda5050pp::BlockingType::HARD,
+                                    {{{"x", "one"},
+                                      {"y", "-2"},
+                                      {"theta", "0"},
+                                      {"mapId", "map"},
+                                      {"lastNodeId", "n"}}}};
+
+      THEN("It uses the control declarations") {
+        REQUIRE(validator_instant(valid).empty());
+        auto res = validator_instant(bad_type);
+        REQUIRE(res.size() == 1);
+        REQUIRE(res.front().errorType == "ActionParameter type");
+      }
+    }
+
+    WHEN("Several mandatory parameters are missing") {
+      vda5050pp::Action action = {
+          "initPosition", "id", std::nullopt, vda5050pp::BlockingType::HARD, {{{"y", "0"}}}};
+
+      auto res = validator_instant(action);
+      THEN("They are reported in key order") {
+        REQUIRE(res.size() == 1);
+        REQUIRE(res.front().errorType == "ActionParameter missing");
+        REQUIRE(res.front().errorReferences->back().referenceValue == "lastNodeId mapId theta x ");
+      }
+    }
+
+    WHEN("An integer parameter cannot be parsed") {
+      vda5050pp::Action action = {
+          "honk", "id", std::nullopt, vda5050pp::BlockingType::NONE, {{{"volume", "loud"}}}};
+
+      auto res = validator_node(action);
+      THEN("It does not match the ordinal type") {
+        REQUIRE(res.size() == 1);
+        REQUIRE(res.front().errorType == "ActionParameter type");
+      }
+    }
+  }
+
+  GIVEN("An AGVDescription without supported actions") {
+    vda5050pp::interface_agv::agv_description::AGVDescription plan_description;
+    auto plan = std::make_shared<const vda5050pp::core::validation::ActionValidationPlan>(
+        plan_description);
+    vda5050pp::core::validation::ActionDeclaredValidator validator(plan, false, true, false);
+
+    THEN("Actions are not validated") {
+      REQUIRE_FALSE(plan->isEnabled());
+      REQUIRE(validator({"unknown", "id", std::nullopt, vda5050pp::BlockingType::HARD, {}})
+                  .empty());
+    }
+  }
+}
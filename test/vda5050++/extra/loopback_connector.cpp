@@ -0,0 +1,113 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains tests for the LoopbackConnector and the VirtualMasterControl
+//
+
+#include "vda5050++/extra/loopback_connector.h"
+
+#include <catch2/catch.hpp>
+
+#include <thread>
+
+#include "test/order_factory.hpp"
+#include "test/test_action_handler.h"
+#include "test/test_odometry_handler.h"
+#include "test/test_pause_resume_handler.h"
+#include "test/test_step_based_navigation_handler.h"
+#include "vda5050++/core/version.h"
+#include "vda5050++/interface_agv/handle.h"
+
+using vda5050pp::extra::LoopbackConnector;
+using vda5050pp::extra::LoopbackMode;
+using vda5050pp::extra::VirtualMasterControl;
+
+// An order with a single node at the AGV's position, which is finished right away
+static vda5050pp::Order mkOrder(const std::string &order_id) {
+  vda5050pp::Order order;
+  order.header.version = vda5050pp::core::version::current;
+  order.orderId = order_id;
+  order.orderUpdateId = 0;
+  order.nodes = {test::mkNode("n1", 0, true, {})};
+  order.nodes.front().nodePosition = vda5050pp::NodePosition{};
+  order.nodes.front().nodePosition->allowedDeviationXY = 1.0;
+  return order;
+}
+
+static bool reports(const vda5050pp::State &state, const vda5050pp::Order &order) {
+  return state.orderId == order.orderId && state.orderUpdateId == order.orderUpdateId;
+}
+
+TEST_CASE("extra::LoopbackConnector - orders through a Handle", "[extra][loopback]") {
+  using Handlers =
+      vda5050pp::interface_agv::Handlers<test::TestStepBasedNavigationHandler,
+                                         test::TestActionHandler, test::TestPauseResumeHandler>;
+
+  auto mode = GENERATE(LoopbackMode::k_objects, LoopbackMode::k_serialized);
+
+  GIVEN("A Handle connected to a VirtualMasterControl with a short order timeout") {
+    auto master = std::make_shared<VirtualMasterControl>(mode, std::chrono::milliseconds(50));
+    auto connector = std::make_shared<LoopbackConnector>(master);
+    vda5050pp::interface_agv::Handle handle({}, connector, Handlers{});
+
+    auto odometry = std::make_shared<test::OdometryHandler>();
+    handle.setOdometryHandler(odometry);
+    vda5050pp::AGVPosition position;
+    position.positionInitialized = true;
+    odometry->setAGVPosition(position);
+
+    REQUIRE(master->isConnected());
+
+    WHEN("An order is sent") {
+      auto order = mkOrder("order-1");
+      master->sendOrder(order);
+      auto state = master->waitForState(
+          [&order](const vda5050pp::State &s) { return reports(s, order); },
+          std::chrono::seconds(5));
+
+      THEN("A state reports it and its latency is recorded") {
+        REQUIRE(state.has_value());
+        auto statistics = master->getStatistics();
+        REQUIRE(statistics.orders_sent == 1);
+        REQUIRE(statistics.states_received >= 1);
+        REQUIRE(statistics.order_to_state_latency.count() == 1);
+        REQUIRE(statistics.order_to_state_latency.max().has_value());
+        REQUIRE(statistics.orders_pending == 0);
+        REQUIRE(statistics.orders_expired == 0);
+        if (mode == LoopbackMode::k_serialized) {
+          REQUIRE(statistics.bytes_sent > 0);
+          REQUIRE(statistics.bytes_received > 0);
+        } else {
+          REQUIRE(statistics.bytes_sent == 0);
+        }
+      }
+    }
+
+    WHEN("A rejected order is followed by a valid one after the order timeout") {
+      auto rejected = mkOrder("order-rejected");
+      rejected.header.version = "0.0.0";
+      master->sendOrder(rejected);
+      REQUIRE(master->getStatistics().orders_pending == 1);
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+      auto order = mkOrder("order-2");
+      master->sendOrder(order);
+      auto state = master->waitForState(
+          [&order](const vda5050pp::State &s) { return reports(s, order); },
+          std::chrono::seconds(5));
+
+      THEN("The rejected order expires instead of staying pending") {
+        REQUIRE(state.has_value());
+        auto statistics = master->getStatistics();
+        REQUIRE(statistics.orders_sent == 2);
+        REQUIRE(statistics.orders_expired == 1);
+        REQUIRE(statistics.orders_pending == 0);
+        REQUIRE(statistics.order_to_state_latency.count() == 1);
+      }
+    }
+  }
+}
@@ -0,0 +1,208 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains tests for the MqttDeliveryWindow class
+//
+
+#include "vda5050++/extra/mqtt_delivery_window.h"
+
+#include <catch2/catch.hpp>
+
+using vda5050pp::extra::MqttDeliveryWindow;
+
+static const std::string k_connection_topic = "uagv/v1/m/sn/connection";
+static const std::string k_state_topic = "uagv/v1/m/sn/state";
+static const std::string k_visualization_topic = "uagv/v1/m/sn/visualization";
+
+static mqtt::message_ptr mkMessage(const std::string &topic, const std::string &payload,
+                                   int qos = 0) {
+  auto msg = std::make_shared<mqtt::message>();
+  msg->set_topic(topic);
+  msg->set_payload(payload);
+  msg->set_qos(qos);
+  return msg;
+}
+
+static std::vector<std::string> payloads(const std::vector<MqttDeliveryWindow::Reserved> &rs) {
+  std::vector<std::string> result;
+  for (const auto &r : rs) {
+    result.push_back(r.msg->get_payload_str());
+  }
+  return result;
+}
+
+TEST_CASE("extra::MqttDeliveryWindow - in-flight window", "[extra][mqtt]") {
+  GIVEN("An online window with two in-flight slots") {
+    MqttDeliveryWindow window(2, 10, MqttDeliveryWindow::OverflowPolicy::k_drop_oldest,
+                              k_connection_topic);
+    window.goOnline();
+
+    WHEN("Three messages are admitted") {
+      auto r1 = window.admit(mkMessage(k_state_topic, "1"));
+      auto r2 = window.admit(mkMessage(k_state_topic, "2", 1));
+      auto r3 = window.admit(mkMessage(k_state_topic, "3"));
+
+      THEN("The window is saturated after two messages") {
+        REQUIRE(r1.has_value());
+        REQUIRE(r2.has_value());
+        REQUIRE_FALSE(r3.has_value());
+        REQUIRE(window.pump().empty());
+
+        auto statistics = window.getStatistics();
+        REQUIRE(statistics.in_flight == 2);
+        REQUIRE(statistics.in_flight_max == 2);
+        REQUIRE(statistics.queued == 1);
+        REQUIRE(statistics.published == 2);
+        REQUIRE(statistics.per_qos[0].published == 1);
+        REQUIRE(statistics.per_qos[1].published == 1);
+      }
+
+      THEN("A completed delivery frees a slot for the queued message") {
+        window.complete(r1->id, true);
+        auto reserved = window.pump();
+        REQUIRE(payloads(reserved) == std::vector<std::string>{"3"});
+
+        auto statistics = window.getStatistics();
+        REQUIRE(statistics.in_flight == 2);
+        REQUIRE(statistics.queued == 0);
+        REQUIRE(statistics.delivered == 1);
+        REQUIRE(statistics.per_qos[0].delivered == 1);
+        REQUIRE(statistics.delivery_latency.count() == 1);
+      }
+
+      THEN("A failed delivery is counted and frees a slot") {
+        window.complete(r2->id, false);
+        REQUIRE(window.pump().size() == 1);
+
+        auto statistics = window.getStatistics();
+        REQUIRE(statistics.failed == 1);
+        REQUIRE(statistics.per_qos[1].failed == 1);
+        REQUIRE(statistics.delivered == 0);
+      }
+
+      THEN("An aborted publish is counted as failed") {
+        window.abort(r1->id);
+        window.complete(r1->id, true);  // unknown ids are ignored
+
+        auto statistics = window.getStatistics();
+        REQUIRE(statistics.failed == 1);
+        REQUIRE(statistics.delivered == 0);
+        REQUIRE(statistics.in_flight == 1);
+      }
+
+      THEN("A lost connection fails the in-flight QoS 0 messages only") {
+        window.goOffline(true);
+        window.complete(r1->id, true);
+
+        auto statistics = window.getStatistics();
+        REQUIRE(statistics.in_flight == 1);
+        REQUIRE(statistics.failed == 1);
+        REQUIRE(statistics.per_qos[0].failed == 1);
+        REQUIRE(window.pump().empty());
+      }
+    }
+  }
+}
+
+TEST_CASE("extra::MqttDeliveryWindow - overflow policies", "[extra][mqtt]") {
+  auto fill = [](MqttDeliveryWindow &window) {
+    window.goOnline();
+    auto in_flight = window.admit(mkMessage(k_connection_topic, "c0"));
+    window.admit(mkMessage(k_state_topic, "s1"));
+    window.admit(mkMessage(k_connection_topic, "c1"));
+    window.admit(mkMessage(k_state_topic, "s2"));
+    window.complete(in_flight->id, true);
+    return window.pump();
+  };
+
+  GIVEN("A window with one in-flight slot and two queued slots") {
+    WHEN("The policy is k_latest_wins") {
+      MqttDeliveryWindow window(1, 2, MqttDeliveryWindow::OverflowPolicy::k_latest_wins,
+                                k_connection_topic);
+      auto first = fill(window);
+
+      THEN("The queued state is replaced in place") {
+        REQUIRE(payloads(first) == std::vector<std::string>{"s2"});
+        auto statistics = window.getStatistics();
+        REQUIRE(statistics.replaced == 1);
+        REQUIRE(statistics.dropped == 0);
+        REQUIRE(statistics.queued == 1);
+      }
+    }
+
+    WHEN("The policy is k_latest_wins and the queue is full of connection messages") {
+      MqttDeliveryWindow window(1, 2, MqttDeliveryWindow::OverflowPolicy::k_latest_wins,
+                                k_connection_topic);
+      window.goOnline();
+      window.admit(mkMessage(k_connection_topic, "c0"));
+      window.admit(mkMessage(k_connection_topic, "c1"));
+      window.admit(mkMessage(k_connection_topic, "c2"));
+      window.admit(mkMessage(k_connection_topic, "c3"));
+
+      THEN("Connection messages are not replaced, but the oldest is dropped") {
+        auto statistics = window.getStatistics();
+        REQUIRE(statistics.replaced == 0);
+        REQUIRE(statistics.dropped == 1);
+        REQUIRE(statistics.queued == 2);
+      }
+    }
+
+    WHEN("The policy is k_drop_oldest") {
+      MqttDeliveryWindow window(1, 2, MqttDeliveryWindow::OverflowPolicy::k_drop_oldest,
+                                k_connection_topic);
+      auto first = fill(window);
+
+      THEN("The oldest queued message is dropped") {
+        REQUIRE(payloads(first) == std::vector<std::string>{"c1"});
+        REQUIRE(window.getStatistics().dropped == 1);
+        REQUIRE(window.getStatistics().replaced == 0);
+      }
+    }
+
+    WHEN("The policy is k_drop_newest") {
+      MqttDeliveryWindow window(1, 2, MqttDeliveryWindow::OverflowPolicy::k_drop_newest,
+                                k_connection_topic);
+      auto first = fill(window);
+
+      THEN("The new message is dropped") {
+        REQUIRE(payloads(first) == std::vector<std::string>{"s1"});
+        REQUIRE(window.getStatistics().dropped == 1);
+        REQUIRE(window.getStatistics().replaced == 0);
+      }
+    }
+  }
+}
+
+TEST_CASE("extra::MqttDeliveryWindow - offline outbox", "[extra][mqtt]") {
+  GIVEN("An offline window") {
+    MqttDeliveryWindow window(10, 10, MqttDeliveryWindow::OverflowPolicy::k_drop_oldest,
+                              k_connection_topic);
+
+    WHEN("Messages are admitted") {
+      REQUIRE_FALSE(window.admit(mkMessage(k_state_topic, "s1")).has_value());
+      window.admit(mkMessage(k_connection_topic, "c1"));
+      window.admit(mkMessage(k_visualization_topic, "v1"));
+      window.admit(mkMessage(k_state_topic, "s2"));
+      window.admit(mkMessage(k_connection_topic, "c2"));
+      window.admit(mkMessage(k_visualization_topic, "v2"));
+
+      THEN("Only the newest state and visualization are kept") {
+        auto statistics = window.getStatistics();
+        REQUIRE(statistics.outbox == 4);
+        REQUIRE(statistics.outboxed == 6);
+        REQUIRE(statistics.compacted == 2);
+        REQUIRE(statistics.published == 0);
+        REQUIRE(window.pump().empty());
+      }
+
+      THEN("Going online flushes the connection messages first") {
+        window.goOnline();
+        REQUIRE(payloads(window.pump()) == std::vector<std::string>{"c1", "c2", "s2", "v2"});
+        REQUIRE(window.getStatistics().outbox == 0);
+      }
+    }
+  }
+}
@@ -0,0 +1,197 @@
+// Copyright Open Logistics Foundation
+// 
+// Licensed under the Open Logistics Foundation License 1.3.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: OLFL-1.3
+// 
+// This file contains tests for the MqttGateway class
+//
+
+#include "vda5050++/extra/mqtt_gateway.h"
+
+#include <catch2/catch.hpp>
+
+#include "vda5050++/extra/json_model.h"
+
+using vda5050pp::extra::MqttConnector;
+using vda5050pp::extra::MqttGateway;
+
+namespace {
+
+class RecordingConsumer : public vda5050pp::interface_mc::MessageConsumer {
+public:
+  std::vector<std::string> order_ids;
+  size_t instant_actions = 0;
+
+  void receivedConnection(const vda5050pp::Connection &) noexcept(true) override {}
+  void receivedInstantActions(const vda5050pp::InstantActions &) noexcept(true) override {
+    this->instant_actions++;
+  }
+  void receivedOrder(const vda5050pp::Order &order) noexcept(true) override {
+    this->order_ids.push_back(order.orderId);
+  }
+};
+
+class RecordingLogger : public vda5050pp::interface_agv::Logger {
+public:
+  std::vector<std::string> errors;
+
+  void logInfo(const std::string &) override {}
+  void logDebug(const std::string &) override {}
+  void logWarn(const std::string &) override {}
+  void logError(const std::string &log_message) override {
+    this->errors.push_back(log_message);
+  }
+  void logFatal(const std::string &) override {}
+};
+
+}  // namespace
+
+static MqttConnector::MqttOptions mkOptions() {
+  MqttConnector::MqttOptions opts;
+  opts.server = "tcp://localhost:1883";  // never connected in these tests
+  opts.interface = "uagv";
+  opts.use_ssl = false;
+  return opts;
+}
+
+static vda5050pp::interface_agv::agv_description::AGVDescription mkDescription(
+    const std::string &serial_number) {
+  vda5050pp::interface_agv::agv_description::AGVDescription desc;
+  desc.manufacturer = "m";
+  desc.serial_number = serial_number;
+  return desc;
+}
+
+static mqtt::const_message_ptr mkMessage(const std::string &topic, const std::string &payload) {
+  auto msg = std::make_shared<mqtt::message>();
+  msg->set_topic(topic);
+  msg->set_payload(payload);
+  return msg;
+}
+
+TEST_CASE("extra::MqttGateway - vehicle registration", "[extra][mqtt]") {
+  GIVEN("A gateway with two vehicles") {
+    MqttGateway gateway("test-gateway", mkOptions());
+    auto connector_1 = gateway.makeConnector(mkDescription("sn1"));
+    auto connector_2 = gateway.makeConnector(mkDescription("sn2"));
+
+    THEN("Both vehicles have statistics") {
+      auto statistics = gateway.getStatistics();
+      REQUIRE(statistics.size() == 2);
+      REQUIRE(statistics.count("m/sn1") == 1);
+      REQUIRE(statistics.count("m/sn2") == 1);
+    }
+
+    THEN("A vehicle cannot be registered twice") {
+      REQUIRE_THROWS_AS(gateway.makeConnector(mkDescription("sn1")), std::invalid_argument);
+    }
+
+    WHEN("A connector is destroyed") {
+      connector_1.reset();
+
+      THEN("The vehicle is removed and can be registered again") {
+        REQUIRE(gateway.getStatistics().count("m/sn1") == 0);
+        REQUIRE_NOTHROW(connector_1 = gateway.makeConnector(mkDescription("sn1")));
+      }
+    }
+
+    WHEN("A vehicle publishes without a connection") {
+      vda5050pp::Connection connection;
+      connection.connectionState = vda5050pp::ConnectionState::ONLINE;
+
+      THEN("It fails and is counted for this vehicle only") {
+        REQUIRE_THROWS_AS(connector_2->queueConnection(connection),
+                          MqttConnector::NotConnectedError);
+        auto statistics = gateway.getStatistics();
+        REQUIRE(statistics.at("m/sn2").publish_errors == 1);
+        REQUIRE(statistics.at("m/sn1").publish_errors == 0);
+      }
+    }
+  }
+}
+
+TEST_CASE("extra::MqttGateway - routing", "[extra][mqtt]") {
+  GIVEN("A gateway with two vehicles and their consumers") {
+    MqttGateway gateway("test-gateway", mkOptions());
+    auto connector_1 = gateway.makeConnector(mkDescription("sn1"));
+    auto connector_2 = gateway.makeConnector(mkDescription("sn2"));
+    auto consumer_1 = std::make_shared<RecordingConsumer>();
+    auto consumer_2 = std::make_shared<RecordingConsumer>();
+    connector_1->setConsumer(consumer_1);
+    connector_2->setConsumer(consumer_2);
+
+    vda5050pp::Order order;
+    order.orderId = "order-1";
+    vda5050pp::InstantActions instant_actions;
+
+    WHEN("An order for the first vehicle arrives") {
+      gateway.message_arrived(mkMessage("uagv/v1/m/sn1/order", json(order).dump()));
+
+      THEN("Only the first consumer receives it") {
+        REQUIRE(consumer_1->order_ids == std::vector<std::string>{"order-1"});
+        REQUIRE(consumer_2->order_ids.empty());
+        REQUIRE(gateway.getStatistics().at("m/sn1").orders_received == 1);
+        REQUIRE(gateway.getStatistics().at("m/sn1").last_received.has_value());
+      }
+    }
+
+    WHEN("Instant actions for the second vehicle arrive") {
+      gateway.message_arrived(
+          mkMessage("uagv/v1/m/sn2/instantActions", json(instant_actions).dump()));
+
+      THEN("Only the second consumer receives them") {
+        REQUIRE(consumer_1->instant_actions == 0);
+        REQUIRE(consumer_2->instant_actions == 1);
+        REQUIRE(gateway.getStatistics().at("m/sn2").instant_actions_received == 1);
+      }
+    }
+
+    WHEN("Messages for unknown vehicles, topics or prefixes arrive") {
+      gateway.message_arrived(mkMessage("uagv/v1/m/sn3/order", json(order).dump()));
+      gateway.message_arrived(mkMessage("uagv/v1/m/sn1/state", json(order).dump()));
+      gateway.message_arrived(mkMessage("other/v1/m/sn1/order", json(order).dump()));
+
+      THEN("They are ignored") {
+        REQUIRE(consumer_1->order_ids.empty());
+        REQUIRE(consumer_2->order_ids.empty());
+        REQUIRE(gateway.getStatistics().at("m/sn1").orders_received == 0);
+      }
+    }
+
+    WHEN("A malformed order arrives") {
+      gateway.message_arrived(mkMessage("uagv/v1/m/sn1/order", "{\"orderId\": 1"));
+
+      THEN("The deserialization error is counted") {
+        REQUIRE(consumer_1->order_ids.empty());
+        REQUIRE(gateway.getStatistics().at("m/sn1").deserialization_errors == 1);
+      }
+    }
+  }
+}
+
+TEST_CASE("extra::MqttGateway - per vehicle logger", "[extra][mqtt]") {
+  GIVEN("A gateway with two vehicles, one of them with an own logger") {
+    MqttGateway gateway("test-gateway", mkOptions());
+    auto connector_1 = gateway.makeConnector(mkDescription("sn1"));
+    auto connector_2 = gateway.makeConnector(mkDescription("sn2"));
+    auto consumer = std::make_shared<RecordingConsumer>();
+    connector_1->setConsumer(consumer);
+    connector_2->setConsumer(consumer);
+    auto vehicle_logger = std::make_shared<RecordingLogger>();
+    auto gateway_logger = std::make_shared<RecordingLogger>();
+    connector_1->setLogger(vehicle_logger);
+    gateway.setLogger(gateway_logger);
+
+    WHEN("Both vehicles receive a malformed order") {
+      gateway.message_arrived(mkMessage("uagv/v1/m/sn1/order", "{\"orderId\": 1"));
+      gateway.message_arrived(mkMessage("uagv/v1/m/sn2/order", "{\"orderId\": 1"));
+
+      THEN("The error of the first vehicle goes to its logger, the other to the gateway's") {
+        REQUIRE(vehicle_logger->errors.size() == 1);
+        REQUIRE(gateway_logger->errors.size() == 1);
+        REQUIRE(vda5050pp::interface_agv::Logger::getCurrentLogger() != vehicle_logger);
+      }
+    }
+  }
+}